@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/network/convex_cost.hpp>
+
+#include "../../test/testing/random_network.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+namespace benchmarking {
+
+/**
+ * Generate a random network on the specified graph.
+ *
+ * The network contains `num_residues` pairs of unit surplus & unit demand nodes at
+ * distinct random locations, and its arc costs are uniformly distributed in
+ * [0, `max_cost`].
+ *
+ * @tparam Network
+ *     The network type.
+ *
+ * @param[in] graph
+ *     The network's underlying graph.
+ * @param[in] num_residues
+ *     The number of surplus (and demand) nodes. Must be at most half the number of
+ *     vertices in the graph.
+ * @param[in] max_cost
+ *     The maximum arc cost.
+ * @param[in] seed
+ *     The random number generator seed.
+ *
+ * @returns
+ *     The new network.
+ */
+template<class Network>
+[[nodiscard]] auto
+make_random_network(const typename Network::graph_type& graph,
+                    std::size_t num_residues,
+                    typename Network::cost_type max_cost,
+                    std::mt19937::result_type seed = 1234U) -> Network
+{
+    return testing::make_random_network<Network>(graph, num_residues, max_cost, seed);
+}
+
+/**
+ * Generate a random network with convex piecewise-linear arc costs on the specified
+ * grid graph.
+ *
+ * The network's surplus & demand nodes are chosen as in `make_random_network()`. The
+ * cost of k units of flow along each link of P parallel edges is a*k + b*k^2, where a
+ * and b are uniformly distributed in [0, `max_cost`].
+ *
+ * @tparam Network
+ *     The network type.
+ *
+ * @param[in] graph
+ *     The network's underlying graph. Must be a `RectangularGridGraph` or
+ *     `FlatRectangularGridGraph`.
+ * @param[in] num_residues
+ *     The number of surplus (and demand) nodes. Must be at most half the number of
+ *     vertices in the graph.
+ * @param[in] max_cost
+ *     The maximum linear & quadratic cost coefficient.
+ * @param[in] seed
+ *     The random number generator seed.
+ *
+ * @returns
+ *     The new network.
+ */
+template<class Network>
+[[nodiscard]] auto
+make_random_convex_network(const typename Network::graph_type& graph,
+                           std::size_t num_residues,
+                           typename Network::cost_type max_cost,
+                           std::mt19937::result_type seed = 1234U) -> Network
+{
+    using Cost = typename Network::cost_type;
+    using Flow = typename Network::flow_type;
+
+    auto rng = std::mt19937(seed);
+    const auto surplus = testing::make_random_surplus<Flow>(graph.num_vertices(),
+                                                            num_residues, rng);
+
+    const auto num_segments = graph.num_parallel_edges();
+    const auto num_links = graph.num_edges() / num_segments;
+
+    auto coeff_dist = std::uniform_int_distribution<Cost>(Cost{0}, max_cost);
+    auto coeffs = std::vector<std::pair<Cost, Cost>>(num_links);
+    std::generate(coeffs.begin(), coeffs.end(),
+                  [&]() { return std::pair(coeff_dist(rng), coeff_dist(rng)); });
+
+    const auto cost = ConvexCostTable<Cost>(
+            num_links, num_segments, [&](std::size_t link, std::size_t flow) {
+                const auto [a, b] = coeffs[link];
+                const auto k = static_cast<Cost>(flow);
+                return a * k + b * k * k;
+            });
+
+    return Network(graph, surplus, cost);
+}
+
+} // namespace benchmarking
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,64 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/graph/delta_stepping.hpp>
+#include <whirlwind/graph/flat_rectangular_grid_graph.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Graph = ww::FlatRectangularGridGraph<1>;
+using Distance = int;
+
+// Generate random edge lengths uniformly distributed in [1, `max_length`].
+auto
+make_random_edge_lengths(const Graph& graph, Distance max_length)
+        -> std::vector<Distance>
+{
+    auto rng = std::mt19937(1234U);
+    auto length_dist = std::uniform_int_distribution<Distance>(1, max_length);
+    auto length = std::vector<Distance>(graph.num_edges());
+    for (auto& l : length) {
+        l = length_dist(rng);
+    }
+    return length;
+}
+
+CATCH_TEST_CASE("DeltaStepping.run (grid)", "[graph]")
+{
+    const auto graph = Graph(1024U, 1024U);
+    const auto max_length = Distance{100};
+    const auto length = make_random_edge_lengths(graph, max_length);
+    const auto edge_length = [&](const auto& edge, const auto&, const auto&) {
+        return length[graph.get_edge_id(edge)];
+    };
+
+    // A few sources spread across the grid.
+    const auto sources = std::vector<Graph::vertex_type>{
+            graph.get_vertex(0U, 0U), graph.get_vertex(300U, 700U),
+            graph.get_vertex(800U, 200U), graph.get_vertex(1023U, 1023U)};
+
+    // Each solver starts its worker threads in the first search and reuses them in
+    // each subsequent one, so the measurements exclude thread startup.
+    const auto delta = max_length / 2;
+    for (const auto num_threads : {1U, 2U, 4U, 8U}) {
+        CATCH_BENCHMARK_ADVANCED("threads = " + std::to_string(num_threads))
+        (Catch::Benchmark::Chronometer meter)
+        {
+            auto delta_stepping = ww::DeltaStepping<Distance, Graph>(
+                    graph, delta, max_length, num_threads);
+            meter.measure([&]() {
+                delta_stepping.reset();
+                delta_stepping.run(sources, edge_length);
+                return delta_stepping.distance_to_vertex(sources.back());
+            });
+        };
+    }
+}
+
+} // namespace
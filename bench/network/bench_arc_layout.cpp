@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/packed_unit_capacity.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../benchmarking/random_network.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Graph = ww::RectangularGridGraph<1>;
+using Cost = int;
+using Flow = int;
+
+// Arc costs, saturation states & transposes stored in separate containers.
+using SoANetwork = ww::Network<Graph,
+                               Cost,
+                               Flow,
+                               ww::Vector,
+                               ww::UnitCapacityMixin<Graph, Flow, ww::Vector>>;
+
+// Arc costs & saturation states stored together in a single record per arc.
+using PackedNetwork =
+        ww::Network<Graph,
+                    Cost,
+                    Flow,
+                    ww::Vector,
+                    ww::PackedUnitCapacityMixin<Graph, Cost, Flow, ww::Vector>>;
+
+// Generate a random network with random node potentials in which a random subset of the
+// forward arcs carry flow, so that relaxation can't predict which arcs are saturated.
+template<class Network>
+[[nodiscard]] auto
+make_relaxation_network(const Graph& graph, Cost max_cost) -> Network
+{
+    auto network = ww::benchmarking::make_random_network<Network>(graph, 0, max_cost);
+
+    auto rng = std::mt19937(5678U);
+    auto potential = std::uniform_int_distribution<Cost>(0, max_cost);
+    for (const auto& node : network.nodes()) {
+        network.increase_node_potential(node, potential(rng));
+    }
+    auto coin = std::bernoulli_distribution(0.5);
+    for (const auto& arc : network.forward_arcs()) {
+        if (coin(rng)) {
+            network.increase_arc_flow(arc, Flow{1});
+        }
+    }
+
+    return network;
+}
+
+// Relax each unsaturated outgoing arc of the specified nodes, as a shortest path search
+// would, and return a checksum of the reduced arc costs.
+template<class Network, class Nodes>
+[[nodiscard]] auto
+relax_outgoing_arcs(const Network& network, const Nodes& nodes) -> Cost
+{
+    auto checksum = Cost{0};
+    for (const auto& tail : nodes) {
+        network.for_each_unsaturated_outgoing_arc(
+                tail, [&](const auto& arc, const auto& head) {
+                    checksum ^= network.arc_reduced_cost(arc, tail, head);
+                });
+    }
+    return checksum;
+}
+
+template<class Network>
+void
+run_relaxation_benchmark(Catch::Benchmark::Chronometer meter,
+                         const Graph& graph,
+                         bool shuffle_nodes)
+{
+    const auto network = make_relaxation_network<Network>(graph, Cost{100});
+
+    using Node = typename Network::node_type;
+    auto nodes = std::vector<Node>();
+    nodes.reserve(network.num_nodes());
+    for (const auto& node : network.nodes()) {
+        nodes.push_back(node);
+    }
+    if (shuffle_nodes) {
+        auto rng = std::mt19937(1234U);
+        std::shuffle(nodes.begin(), nodes.end(), rng);
+    }
+
+    meter.measure([&] { return relax_outgoing_arcs(network, nodes); });
+}
+
+CATCH_TEST_CASE("arc relaxation (grid)", "[network]")
+{
+    const auto graph = Graph(1024U, 1024U);
+
+    // Nodes in order of increasing index: accesses to the arcs of successive nodes
+    // are mostly sequential.
+    CATCH_BENCHMARK_ADVANCED("UnitCapacityMixin (sequential)")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        run_relaxation_benchmark<SoANetwork>(meter, graph, false);
+    };
+
+    CATCH_BENCHMARK_ADVANCED("PackedUnitCapacityMixin (sequential)")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        run_relaxation_benchmark<PackedNetwork>(meter, graph, false);
+    };
+
+    // Nodes in random order, which approximates the scattered access pattern of a
+    // shortest path search on a large network.
+    CATCH_BENCHMARK_ADVANCED("UnitCapacityMixin (random)")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        run_relaxation_benchmark<SoANetwork>(meter, graph, true);
+    };
+
+    CATCH_BENCHMARK_ADVANCED("PackedUnitCapacityMixin (random)")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        run_relaxation_benchmark<PackedNetwork>(meter, graph, true);
+    };
+}
+
+} // namespace
@@ -0,0 +1,198 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/heap.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/delta_stepping.hpp>
+#include <whirlwind/graph/dial.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/flat_rectangular_grid_graph.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/parallel_primal_dual.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../benchmarking/random_network.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Graph = ww::RectangularGridGraph<1>;
+using Cost = int;
+using Flow = int;
+using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+using ResidualGraph = Network::residual_graph_type;
+
+// A grid graph with 32-bit vertex & edge indices.
+using CompactGraph = ww::RectangularGridGraph<1, std::uint32_t, std::uint32_t>;
+using CompactMixin = ww::UnitCapacityMixin<CompactGraph, Flow, ww::Vector>;
+using CompactNetwork = ww::Network<CompactGraph, Cost, Flow, ww::Vector, CompactMixin>;
+using CompactResidualGraph = CompactNetwork::residual_graph_type;
+
+// Grid graphs whose vertices are linear indices rather than (row,col) pairs.
+template<class Index>
+using FlatGraph = ww::FlatRectangularGridGraph<1, Index>;
+template<class Index>
+using FlatMixin = ww::UnitCapacityMixin<FlatGraph<Index>, Flow, ww::Vector>;
+template<class Index>
+using FlatNetwork =
+        ww::Network<FlatGraph<Index>, Cost, Flow, ww::Vector, FlatMixin<Index>>;
+
+template<class Dijkstra, class NetworkType = Network>
+void
+run_primal_dual_benchmark(Catch::Benchmark::Chronometer meter,
+                          const typename NetworkType::graph_type& graph,
+                          std::size_t num_residues,
+                          Cost max_cost)
+{
+    auto networks = std::vector<NetworkType>();
+    networks.reserve(static_cast<std::size_t>(meter.runs()));
+    for (int i = 0; i < meter.runs(); ++i) {
+        networks.push_back(ww::benchmarking::make_random_network<NetworkType>(
+                graph, num_residues, max_cost));
+    }
+
+    meter.measure([&](int i) {
+        auto& network = networks[static_cast<std::size_t>(i)];
+        ww::primal_dual<Dijkstra>(network);
+        return network.total_cost();
+    });
+}
+
+CATCH_TEST_CASE("primal_dual (grid)", "[network]")
+{
+    const auto graph = Graph(256U, 256U);
+    const auto num_residues = std::size_t{1000};
+    const auto max_cost = Cost{100};
+
+    using BinaryHeap = ww::BinaryHeap<ResidualGraph::vertex_type, Cost>;
+    using RadixHeap = ww::RadixHeap<ResidualGraph::vertex_type, Cost>;
+
+    CATCH_BENCHMARK_ADVANCED("Dijkstra (BinaryHeap)")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        using Dijkstra = ww::Dijkstra<Cost, ResidualGraph, ww::Vector, BinaryHeap>;
+        run_primal_dual_benchmark<Dijkstra>(meter, graph, num_residues, max_cost);
+    };
+
+    CATCH_BENCHMARK_ADVANCED("Dijkstra (RadixHeap)")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        using Dijkstra = ww::Dijkstra<Cost, ResidualGraph, ww::Vector, RadixHeap>;
+        run_primal_dual_benchmark<Dijkstra>(meter, graph, num_residues, max_cost);
+    };
+
+    CATCH_BENCHMARK_ADVANCED("Dial")(Catch::Benchmark::Chronometer meter)
+    {
+        using Dial = ww::Dial<Cost, ResidualGraph>;
+        run_primal_dual_benchmark<Dial>(meter, graph, num_residues, max_cost);
+    };
+
+    CATCH_BENCHMARK_ADVANCED("DeltaStepping")(Catch::Benchmark::Chronometer meter)
+    {
+        using DeltaStepping = ww::DeltaStepping<Cost, ResidualGraph>;
+        run_primal_dual_benchmark<DeltaStepping>(meter, graph, num_residues, max_cost);
+    };
+}
+
+CATCH_TEST_CASE("primal_dual (grid, index width)", "[network]")
+{
+    const auto num_residues = std::size_t{1000};
+    const auto max_cost = Cost{100};
+
+    // The index width determines the size of the per-node & per-arc arrays traversed
+    // in the inner loops (e.g. vertex pairs in the heap and predecessor edges).
+    CATCH_BENCHMARK_ADVANCED("64-bit")(Catch::Benchmark::Chronometer meter)
+    {
+        const auto graph = Graph(512U, 512U);
+        using Dijkstra = ww::Dijkstra<Cost, ResidualGraph>;
+        run_primal_dual_benchmark<Dijkstra>(meter, graph, num_residues, max_cost);
+    };
+
+    CATCH_BENCHMARK_ADVANCED("32-bit")(Catch::Benchmark::Chronometer meter)
+    {
+        const auto graph = CompactGraph(512U, 512U);
+        using Dijkstra = ww::Dijkstra<Cost, CompactResidualGraph>;
+        run_primal_dual_benchmark<Dijkstra, CompactNetwork>(meter, graph, num_residues,
+                                                            max_cost);
+    };
+
+    CATCH_BENCHMARK_ADVANCED("64-bit (flat)")(Catch::Benchmark::Chronometer meter)
+    {
+        using Net = FlatNetwork<std::size_t>;
+        const auto graph = Net::graph_type(512U, 512U);
+        using Dijkstra = ww::Dijkstra<Cost, Net::residual_graph_type>;
+        run_primal_dual_benchmark<Dijkstra, Net>(meter, graph, num_residues, max_cost);
+    };
+
+    CATCH_BENCHMARK_ADVANCED("32-bit (flat)")(Catch::Benchmark::Chronometer meter)
+    {
+        using Net = FlatNetwork<std::uint32_t>;
+        const auto graph = Net::graph_type(512U, 512U);
+        using Dijkstra = ww::Dijkstra<Cost, Net::residual_graph_type>;
+        run_primal_dual_benchmark<Dijkstra, Net>(meter, graph, num_residues, max_cost);
+    };
+}
+
+CATCH_TEST_CASE("primal_dual (grid, fixed size)", "[network]")
+{
+    const auto num_residues = std::size_t{1000};
+    const auto max_cost = Cost{100};
+
+    CATCH_BENCHMARK_ADVANCED("dynamic size")(Catch::Benchmark::Chronometer meter)
+    {
+        const auto graph = Graph(256U, 256U);
+        using Dijkstra = ww::Dijkstra<Cost, ResidualGraph>;
+        run_primal_dual_benchmark<Dijkstra>(meter, graph, num_residues, max_cost);
+    };
+
+    // The grid dimensions are template parameters, so the graph's vertex & edge counts,
+    // edge offsets, and boundary checks are compile-time constants.
+    CATCH_BENCHMARK_ADVANCED("fixed size")(Catch::Benchmark::Chronometer meter)
+    {
+        using FixedGraph = ww::FixedRectangularGridGraph<256, 256>;
+        using FixedMixin = ww::UnitCapacityMixin<FixedGraph, Flow, ww::Vector>;
+        using Net = ww::Network<FixedGraph, Cost, Flow, ww::Vector, FixedMixin>;
+        const auto graph = FixedGraph();
+        using Dijkstra = ww::Dijkstra<Cost, Net::residual_graph_type>;
+        run_primal_dual_benchmark<Dijkstra, Net>(meter, graph, num_residues, max_cost);
+    };
+}
+
+CATCH_TEST_CASE("parallel_primal_dual (grid)", "[network]")
+{
+    const auto graph = Graph(256U, 256U);
+    const auto num_residues = std::size_t{1000};
+    const auto max_cost = Cost{100};
+
+    using Dijkstra = ww::Dijkstra<Cost, ResidualGraph>;
+
+    for (const auto num_threads : {1U, 2U, 4U, 8U}) {
+        CATCH_BENCHMARK_ADVANCED("threads = " + std::to_string(num_threads))
+        (Catch::Benchmark::Chronometer meter)
+        {
+            auto networks = std::vector<Network>();
+            networks.reserve(static_cast<std::size_t>(meter.runs()));
+            for (int i = 0; i < meter.runs(); ++i) {
+                networks.push_back(ww::benchmarking::make_random_network<Network>(
+                        graph, num_residues, max_cost));
+            }
+
+            meter.measure([&](int i) {
+                auto& network = networks[static_cast<std::size_t>(i)];
+                ww::parallel_primal_dual<Dijkstra>(network, num_threads);
+                return network.total_cost();
+            });
+        };
+    }
+}
+
+} // namespace
@@ -0,0 +1,194 @@
+#include <cstddef>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/heap.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/astar_successive_shortest_paths.hpp>
+#include <whirlwind/network/batched_successive_shortest_paths.hpp>
+#include <whirlwind/network/bidirectional_successive_shortest_paths.hpp>
+#include <whirlwind/network/convex_cost.hpp>
+#include <whirlwind/network/cost_scaling.hpp>
+#include <whirlwind/network/grid_distance_heuristic.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/network_simplex.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../benchmarking/random_network.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Graph = ww::RectangularGridGraph<1>;
+using Cost = int;
+using Flow = int;
+using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+using ResidualGraph = Network::residual_graph_type;
+using Dijkstra = ww::Dijkstra<Cost, ResidualGraph>;
+
+template<class Solver>
+void
+run_solver_benchmark(Catch::Benchmark::Chronometer meter,
+                     const Graph& graph,
+                     std::size_t num_residues,
+                     Cost max_cost,
+                     Solver solver)
+{
+    auto networks = std::vector<Network>();
+    networks.reserve(static_cast<std::size_t>(meter.runs()));
+    for (int i = 0; i < meter.runs(); ++i) {
+        networks.push_back(ww::benchmarking::make_random_network<Network>(
+                graph, num_residues, max_cost));
+    }
+
+    meter.measure([&](int i) {
+        auto& network = networks[static_cast<std::size_t>(i)];
+        solver(network);
+        return network.total_cost();
+    });
+}
+
+CATCH_TEST_CASE("successive_shortest_paths (grid)", "[network]")
+{
+    const auto graph = Graph(256U, 256U);
+    const auto num_residues = std::size_t{1000};
+    const auto max_cost = Cost{100};
+
+    CATCH_BENCHMARK_ADVANCED("successive_shortest_paths")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        run_solver_benchmark(meter, graph, num_residues, max_cost, [](auto& network) {
+            ww::successive_shortest_paths<Dijkstra>(network);
+        });
+    };
+
+    CATCH_BENCHMARK_ADVANCED("batched_successive_shortest_paths")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        run_solver_benchmark(meter, graph, num_residues, max_cost, [](auto& network) {
+            ww::batched_successive_shortest_paths<Dijkstra>(network);
+        });
+    };
+
+    CATCH_BENCHMARK_ADVANCED("bidirectional_successive_shortest_paths")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        run_solver_benchmark(meter, graph, num_residues, max_cost, [](auto& network) {
+            ww::bidirectional_successive_shortest_paths<Dijkstra>(network);
+        });
+    };
+
+    CATCH_BENCHMARK_ADVANCED("astar_successive_shortest_paths")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        run_solver_benchmark(meter, graph, num_residues, max_cost, [](auto& network) {
+            ww::astar_successive_shortest_paths<Dijkstra>(
+                    network, ww::GridDistanceHeuristic<Network>(network));
+        });
+    };
+
+    CATCH_BENCHMARK_ADVANCED("cost_scaling")(Catch::Benchmark::Chronometer meter)
+    {
+        run_solver_benchmark(meter, graph, num_residues, max_cost, [](auto& network) {
+            ww::cost_scaling(network);
+        });
+    };
+
+    CATCH_BENCHMARK_ADVANCED("network_simplex")(Catch::Benchmark::Chronometer meter)
+    {
+        run_solver_benchmark(meter, graph, num_residues, max_cost, [](auto& network) {
+            ww::network_simplex(network);
+        });
+    };
+}
+
+CATCH_TEST_CASE("successive_shortest_paths (grid, sparse residues)", "[network]")
+{
+    const auto graph = Graph(512U, 512U);
+    const auto num_residues = std::size_t{20};
+    const auto max_cost = Cost{100};
+
+    CATCH_BENCHMARK_ADVANCED("successive_shortest_paths")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        run_solver_benchmark(meter, graph, num_residues, max_cost, [](auto& network) {
+            ww::successive_shortest_paths<Dijkstra>(network);
+        });
+    };
+
+    CATCH_BENCHMARK_ADVANCED("bidirectional_successive_shortest_paths")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        run_solver_benchmark(meter, graph, num_residues, max_cost, [](auto& network) {
+            ww::bidirectional_successive_shortest_paths<Dijkstra>(network);
+        });
+    };
+
+    CATCH_BENCHMARK_ADVANCED("astar_successive_shortest_paths")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        run_solver_benchmark(meter, graph, num_residues, max_cost, [](auto& network) {
+            ww::astar_successive_shortest_paths<Dijkstra>(
+                    network, ww::GridDistanceHeuristic<Network>(network));
+        });
+    };
+}
+
+// Convex piecewise-linear arc costs, modeled by P parallel unit-capacity arcs between
+// adjacent nodes.
+template<class Mixin>
+using ConvexNetwork =
+        ww::Network<ww::RectangularGridGraph<4>, Cost, Flow, ww::Vector, Mixin>;
+
+template<class NetworkType>
+void
+run_convex_benchmark(Catch::Benchmark::Chronometer meter,
+                     const typename NetworkType::graph_type& graph,
+                     std::size_t num_residues,
+                     Cost max_cost)
+{
+    auto networks = std::vector<NetworkType>();
+    networks.reserve(static_cast<std::size_t>(meter.runs()));
+    for (int i = 0; i < meter.runs(); ++i) {
+        networks.push_back(ww::benchmarking::make_random_convex_network<NetworkType>(
+                graph, num_residues, max_cost));
+    }
+
+    meter.measure([&](int i) {
+        auto& network = networks[static_cast<std::size_t>(i)];
+        using Solver = ww::Dijkstra<Cost, typename NetworkType::residual_graph_type>;
+        ww::successive_shortest_paths<Solver>(network);
+        return network.total_cost();
+    });
+}
+
+CATCH_TEST_CASE("successive_shortest_paths (grid, convex costs)", "[network]")
+{
+    using ConvexGraph = ww::RectangularGridGraph<4>;
+    const auto graph = ConvexGraph(256U, 256U);
+    const auto num_residues = std::size_t{1000};
+    const auto max_cost = Cost{100};
+
+    // Relaxes each unsaturated parallel arc.
+    CATCH_BENCHMARK_ADVANCED("UnitCapacityMixin")(Catch::Benchmark::Chronometer meter)
+    {
+        using Net = ConvexNetwork<ww::UnitCapacityMixin<ConvexGraph, Flow>>;
+        run_convex_benchmark<Net>(meter, graph, num_residues, max_cost);
+    };
+
+    // Relaxes only the cheapest unsaturated parallel arc to each neighbor.
+    CATCH_BENCHMARK_ADVANCED("ConvexCostMixin")(Catch::Benchmark::Chronometer meter)
+    {
+        using Net = ConvexNetwork<ww::ConvexCostMixin<ConvexGraph, Flow>>;
+        run_convex_benchmark<Net>(meter, graph, num_residues, max_cost);
+    };
+}
+
+} // namespace
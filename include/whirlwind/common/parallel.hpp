@@ -0,0 +1,306 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "assert.hpp"
+#include "namespace.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * Get the default number of worker threads for parallel algorithms.
+ *
+ * @returns
+ *     The number of concurrent threads supported by the hardware, or 1 if this value
+ *     is not computable.
+ */
+[[nodiscard]] inline auto
+default_num_threads() noexcept -> std::size_t
+{
+    const auto num_threads = std::thread::hardware_concurrency();
+    return (num_threads == 0) ? std::size_t{1} : std::size_t{num_threads};
+}
+
+/**
+ * Run a function concurrently on the specified number of threads.
+ *
+ * The function is invoked once per thread with the index of the thread in the range
+ * [0, `num_threads`). The calling thread participates as thread 0. Returns once all
+ * invocations have completed.
+ *
+ * @param[in] num_threads
+ *     The number of threads. Must be >= 1.
+ * @param[in] function
+ *     A function object callable as `function(thread_id)`.
+ */
+template<class Function>
+void
+run_in_parallel(std::size_t num_threads, Function function)
+{
+    WHIRLWIND_ASSERT(num_threads >= 1);
+
+    auto threads = std::vector<std::jthread>();
+    threads.reserve(num_threads - 1);
+    for (std::size_t thread_id = 1; thread_id < num_threads; ++thread_id) {
+        threads.emplace_back([&function, thread_id]() { function(thread_id); });
+    }
+    function(std::size_t{0});
+
+    // The remaining threads are joined when `threads` goes out of scope.
+}
+
+/**
+ * A fixed set of worker threads that repeatedly run functions concurrently.
+ *
+ * Equivalent to `run_in_parallel()`, except that the worker threads are started once,
+ * when the pool is created, and reused by each call to `run()`. This avoids the cost of
+ * starting and joining threads in algorithms that run many short parallel phases. The
+ * workers wait on a condition variable between calls and are stopped & joined when the
+ * pool is destroyed.
+ *
+ * `run()` must not be called concurrently by multiple threads, or from within a
+ * function run by the pool.
+ */
+class ThreadPool {
+public:
+    using size_type = std::size_t;
+
+    /**
+     * Create a new `ThreadPool`.
+     *
+     * @param[in] num_threads
+     *     The number of threads, including the thread that calls `run()`. Must be >= 1.
+     *     `num_threads - 1` worker threads are started.
+     */
+    explicit ThreadPool(size_type num_threads) : num_threads_(num_threads)
+    {
+        WHIRLWIND_ASSERT(num_threads >= 1);
+
+        threads_.reserve(num_threads - 1);
+        for (size_type thread_id = 1; thread_id < num_threads; ++thread_id) {
+            threads_.emplace_back([this, thread_id](std::stop_token stop_token) {
+                work(stop_token, thread_id);
+            });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+
+    auto
+    operator=(const ThreadPool&) -> ThreadPool& = delete;
+    auto
+    operator=(ThreadPool&&) -> ThreadPool& = delete;
+
+    /** Stop & join the worker threads. */
+    ~ThreadPool() = default;
+
+    /** The number of threads, including the thread that calls `run()`. */
+    [[nodiscard]] auto
+    num_threads() const noexcept -> size_type
+    {
+        return num_threads_;
+    }
+
+    /**
+     * Run a function concurrently on each thread in the pool.
+     *
+     * The function is invoked once per thread with the index of the thread in the
+     * range [0, `num_threads()`). The calling thread participates as thread 0. Returns
+     * once all invocations have completed.
+     *
+     * @param[in] function
+     *     A function object callable as `function(thread_id)`.
+     */
+    template<class Function>
+    void
+    run(Function function)
+    {
+        {
+            const auto lock = std::scoped_lock(mutex_);
+            function_ = std::addressof(function);
+            invoke_ = [](void* f, size_type thread_id) {
+                (*static_cast<Function*>(f))(thread_id);
+            };
+            num_running_ = num_threads() - 1;
+            ++generation_;
+        }
+        start_.notify_all();
+
+        function(size_type{0});
+
+        auto lock = std::unique_lock(mutex_);
+        done_.wait(lock, [&]() { return num_running_ == 0; });
+        function_ = nullptr;
+    }
+
+private:
+    // Run each function submitted to the pool on the specified worker thread until the
+    // pool is destroyed.
+    void
+    work(const std::stop_token& stop_token, size_type thread_id)
+    {
+        auto generation = std::uint64_t{0};
+        while (true) {
+            auto lock = std::unique_lock(mutex_);
+            if (!start_.wait(lock, stop_token,
+                             [&]() { return generation_ != generation; })) {
+                return;
+            }
+            generation = generation_;
+            auto* const function = function_;
+            auto* const invoke = invoke_;
+            lock.unlock();
+
+            invoke(function, thread_id);
+
+            lock.lock();
+            if (--num_running_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+
+    size_type num_threads_;
+
+    std::mutex mutex_;
+    std::condition_variable_any start_;
+    std::condition_variable done_;
+
+    // The function being run, the number of worker threads still running it, and the
+    // number of functions submitted so far. Guarded by `mutex_`.
+    void* function_ = nullptr;
+    void (*invoke_)(void*, size_type) = nullptr;
+    size_type num_running_ = 0;
+    std::uint64_t generation_ = 0;
+
+    // Declared last, so that the workers are stopped & joined before the
+    // synchronization primitives they use are destroyed.
+    std::vector<std::jthread> threads_;
+};
+
+/**
+ * A scheduler that distributes chunks of work among a fixed number of threads.
+ *
+ * The work is divided into a number of slices (typically one per thread), each of
+ * which is a contiguous range of work items. Each thread claims chunks from its own
+ * slice first and then steals chunks from the remaining slices in round-robin order,
+ * so that threads that finish early help with slices that are more heavily loaded.
+ * Chunks are claimed using a single atomic increment per chunk.
+ *
+ * Resetting the slices is not thread-safe with respect to concurrent calls to
+ * `next()` -- it's intended to be used in bulk-synchronous algorithms where threads are
+ * synchronized (e.g. by a barrier) between resetting the slices and claiming work.
+ */
+class WorkStealingScheduler {
+public:
+    using size_type = std::size_t;
+
+    /** A contiguous range of work items [`begin`, `end`) within a slice. */
+    struct Chunk {
+        size_type slice;
+        size_type begin;
+        size_type end;
+    };
+
+    /**
+     * Create a new `WorkStealingScheduler`. Each slice is initially empty.
+     *
+     * @param[in] num_slices
+     *     The number of slices. Must be >= 1.
+     * @param[in] chunk_size
+     *     The number of work items per chunk. Must be >= 1.
+     */
+    explicit WorkStealingScheduler(size_type num_slices, size_type chunk_size = 64)
+        : slices_(std::make_unique<Slice[]>(num_slices)),
+          num_slices_(num_slices),
+          chunk_size_(chunk_size)
+    {
+        WHIRLWIND_ASSERT(num_slices >= 1);
+        WHIRLWIND_ASSERT(chunk_size >= 1);
+    }
+
+    /** The number of slices. */
+    [[nodiscard]] auto
+    num_slices() const noexcept -> size_type
+    {
+        return num_slices_;
+    }
+
+    /** The number of work items per chunk. */
+    [[nodiscard]] auto
+    chunk_size() const noexcept -> size_type
+    {
+        return chunk_size_;
+    }
+
+    /**
+     * Reset a slice to contain the work items [0, `size`).
+     *
+     * @param[in] slice
+     *     The index of the slice.
+     * @param[in] size
+     *     The number of work items in the slice.
+     */
+    void
+    reset_slice(size_type slice, size_type size) noexcept
+    {
+        WHIRLWIND_ASSERT(slice < num_slices());
+        slices_[slice].next.store(0, std::memory_order_relaxed);
+        slices_[slice].size = size;
+    }
+
+    /**
+     * Claim the next chunk of work on behalf of the specified thread.
+     *
+     * @param[in] thread_id
+     *     The index of the calling thread. The thread's own slice is the slice with the
+     *     same index (modulo the number of slices).
+     *
+     * @returns
+     *     The next unclaimed chunk, or `std::nullopt` if all work has been claimed.
+     */
+    [[nodiscard]] auto
+    next(size_type thread_id) noexcept -> std::optional<Chunk>
+    {
+        const auto n = num_slices();
+        for (size_type i = 0; i < n; ++i) {
+            const auto slice_id = (thread_id + i) % n;
+            auto& slice = slices_[slice_id];
+            if (slice.next.load(std::memory_order_relaxed) >= slice.size) {
+                continue;
+            }
+
+            const auto begin =
+                    slice.next.fetch_add(chunk_size(), std::memory_order_relaxed);
+            if (begin < slice.size) {
+                const auto end = std::min(begin + chunk_size(), slice.size);
+                return Chunk{slice_id, begin, end};
+            }
+        }
+        return std::nullopt;
+    }
+
+private:
+    // Each slice occupies its own cache line to avoid false sharing between threads.
+    struct alignas(64) Slice {
+        std::atomic<size_type> next = 0;
+        size_type size = 0;
+    };
+
+    std::unique_ptr<Slice[]> slices_;
+    size_type num_slices_;
+    size_type chunk_size_;
+};
+
+WHIRLWIND_NAMESPACE_END
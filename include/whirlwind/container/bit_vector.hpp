@@ -0,0 +1,207 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+#include "vector.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A fixed-size sequence of bits packed into 64-bit words.
+ *
+ * Unlike `std::vector<bool>`, individual bits are accessed by value rather than via
+ * proxy references, and `test()`, `set()`, `reset()` & `assign()` compile to a single
+ * branch-free read or read-modify-write of the containing word. The underlying words
+ * are exposed via `words()` so that bulk operations (e.g. counting or iterating over
+ * the set bits of the bitwise AND of two `BitVector`s) can process 64 bits at a time.
+ *
+ * The unused high-order bits of the last word are always zero.
+ *
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the words.
+ */
+template<template<class> class Container = Vector>
+class BitVector {
+public:
+    using word_type = std::uint64_t;
+    using size_type = std::size_t;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    /** Default constructor. Creates an empty `BitVector`. */
+    constexpr BitVector() = default;
+
+    /**
+     * Create a new `BitVector` with the specified number of bits.
+     *
+     * @param[in] size
+     *     The number of bits.
+     * @param[in] value
+     *     The initial value of each bit.
+     */
+    explicit constexpr BitVector(size_type size, bool value = false)
+        : size_(size),
+          words_(num_words(size), value ? ~word_type{0} : word_type{0})
+    {
+        clear_unused_bits();
+    }
+
+    /** The number of bits. */
+    [[nodiscard]] constexpr auto
+    size() const noexcept -> size_type
+    {
+        return size_;
+    }
+
+    /** The underlying words. Bit `i` is bit `i % 64` of word `i / 64`. */
+    [[nodiscard]] constexpr auto
+    words() const noexcept -> std::span<const word_type>
+    {
+        return words_;
+    }
+
+    /**
+     * Get the value of a bit.
+     *
+     * @param[in] pos
+     *     The bit index. Must be less than `size()`.
+     *
+     * @returns
+     *     True if the bit is set; otherwise false.
+     */
+    [[nodiscard]] constexpr auto
+    test(size_type pos) const -> bool
+    {
+        WHIRLWIND_ASSERT(pos < size());
+        return ((words_[word_index(pos)] >> bit_index(pos)) & word_type{1}) != 0;
+    }
+
+    /** Set the bit at the specified index. */
+    constexpr void
+    set(size_type pos)
+    {
+        WHIRLWIND_ASSERT(pos < size());
+        words_[word_index(pos)] |= bit_mask(pos);
+    }
+
+    /** Clear the bit at the specified index. */
+    constexpr void
+    reset(size_type pos)
+    {
+        WHIRLWIND_ASSERT(pos < size());
+        words_[word_index(pos)] &= ~bit_mask(pos);
+    }
+
+    /** Set the bit at the specified index to the specified value. */
+    constexpr void
+    assign(size_type pos, bool value)
+    {
+        WHIRLWIND_ASSERT(pos < size());
+        auto& word = words_[word_index(pos)];
+        const auto mask = bit_mask(pos);
+        word = (word & ~mask) | (-static_cast<word_type>(value) & mask);
+    }
+
+    /** The number of set bits. */
+    [[nodiscard]] constexpr auto
+    count() const noexcept -> size_type
+    {
+        size_type n = 0;
+        for (const auto& word : words_) {
+            n += static_cast<size_type>(std::popcount(word));
+        }
+        return n;
+    }
+
+    /**
+     * Invoke a function on the index of each set bit, in increasing order.
+     *
+     * @param[in] visitor
+     *     A function invocable with argument `(size_type)`.
+     */
+    template<class Visitor>
+    constexpr void
+    for_each_set_bit(Visitor visitor) const
+    {
+        for (size_type i = 0; i < std::size(words_); ++i) {
+            for_each_set_bit_in_word(words_[i], i, visitor);
+        }
+    }
+
+    /** The number of bits in each word. */
+    [[nodiscard]] static constexpr auto
+    word_size() noexcept -> size_type
+    {
+        return std::numeric_limits<word_type>::digits;
+    }
+
+    /**
+     * Invoke a function on the bit index of each set bit of a word, in increasing
+     * order.
+     *
+     * @param[in] word
+     *     The word.
+     * @param[in] word_index
+     *     The index of the word, from which the bit indices are computed.
+     * @param[in] visitor
+     *     A function invocable with argument `(size_type)`.
+     */
+    template<class Visitor>
+    static constexpr void
+    for_each_set_bit_in_word(word_type word, size_type word_index, Visitor& visitor)
+    {
+        const auto offset = word_index * word_size();
+        while (word != 0) {
+            visitor(offset + static_cast<size_type>(std::countr_zero(word)));
+            word &= word - 1;
+        }
+    }
+
+private:
+    [[nodiscard]] static constexpr auto
+    num_words(size_type size) noexcept -> size_type
+    {
+        return (size + word_size() - 1) / word_size();
+    }
+
+    [[nodiscard]] static constexpr auto
+    word_index(size_type pos) noexcept -> size_type
+    {
+        return pos / word_size();
+    }
+
+    [[nodiscard]] static constexpr auto
+    bit_index(size_type pos) noexcept -> size_type
+    {
+        return pos % word_size();
+    }
+
+    [[nodiscard]] static constexpr auto
+    bit_mask(size_type pos) noexcept -> word_type
+    {
+        return word_type{1} << bit_index(pos);
+    }
+
+    constexpr void
+    clear_unused_bits() noexcept
+    {
+        const auto num_used_bits = bit_index(size_);
+        if (num_used_bits != 0) {
+            WHIRLWIND_DEBUG_ASSERT(!std::empty(words_));
+            words_.back() &= (word_type{1} << num_used_bits) - 1;
+        }
+    }
+
+    size_type size_ = 0;
+    container_type<word_type> words_;
+};
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,376 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+#include "vector.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A fixed number of FIFO queues ("buckets") sharing a single pool of storage.
+ *
+ * Each bucket is an intrusive singly-linked list threaded through a contiguous array of
+ * nodes. Nodes released by `pop()` are recycled via a free list, and `clear()` resets
+ * the pool without releasing its memory, so once the pool has grown to the peak number
+ * of elements, pushing, popping, and clearing perform no further allocations.
+ *
+ * @tparam T
+ *     The element type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the bucket list headers and the
+ *     node pool.
+ */
+template<class T, template<class> class Container = Vector>
+class BucketQueue {
+public:
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using size_type = std::size_t;
+
+    template<class U>
+    using container_type = Container<U>;
+
+    class bucket_reference;
+    class const_bucket_reference;
+
+    /**
+     * Create a new `BucketQueue` with the specified number of buckets. Each bucket is
+     * initially empty.
+     *
+     * @param[in] num_buckets
+     *     The number of buckets.
+     */
+    explicit constexpr BucketQueue(size_type num_buckets = 0) : buckets_(num_buckets)
+    {
+        WHIRLWIND_DEBUG_ASSERT(std::size(buckets_) == num_buckets);
+    }
+
+    /** The number of buckets. */
+    [[nodiscard]] constexpr auto
+    num_buckets() const noexcept -> size_type
+    {
+        return std::size(buckets_);
+    }
+
+    /** Check whether all buckets are empty. */
+    [[nodiscard]] constexpr auto
+    empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    /** The total number of elements in all buckets. */
+    [[nodiscard]] constexpr auto
+    size() const noexcept -> size_type
+    {
+        return size_;
+    }
+
+    /** Check whether the specified bucket is empty. */
+    [[nodiscard]] constexpr auto
+    bucket_empty(size_type bucket_id) const -> bool
+    {
+        return get_bucket(bucket_id).head == npos();
+    }
+
+    /** The number of elements in the specified bucket. */
+    [[nodiscard]] constexpr auto
+    bucket_size(size_type bucket_id) const -> size_type
+    {
+        return get_bucket(bucket_id).size;
+    }
+
+    /** Get the first element in the specified (non-empty) bucket. */
+    [[nodiscard]] constexpr auto
+    front(size_type bucket_id) const -> const_reference
+    {
+        const auto& bucket = get_bucket(bucket_id);
+        WHIRLWIND_ASSERT(bucket.head != npos());
+        return get_node(bucket.head).value;
+    }
+
+    /** Get the first element in the specified (non-empty) bucket. */
+    [[nodiscard]] constexpr auto
+    front(size_type bucket_id) -> reference
+    {
+        const auto& bucket = get_bucket(bucket_id);
+        WHIRLWIND_ASSERT(bucket.head != npos());
+        return get_node(bucket.head).value;
+    }
+
+    /**
+     * Append an element to the back of the specified bucket.
+     *
+     * @param[in] bucket_id
+     *     The index of the bucket.
+     * @param[in] value
+     *     The element to insert.
+     */
+    constexpr void
+    push(size_type bucket_id, value_type value)
+    {
+        auto& bucket = get_bucket(bucket_id);
+        const auto node_id = make_node(std::move(value));
+
+        if (bucket.tail == npos()) {
+            WHIRLWIND_DEBUG_ASSERT(bucket.head == npos());
+            bucket.head = node_id;
+        } else {
+            get_node(bucket.tail).next = node_id;
+        }
+        bucket.tail = node_id;
+        ++bucket.size;
+        ++size_;
+    }
+
+    /** Remove the first element from the specified (non-empty) bucket. */
+    constexpr void
+    pop(size_type bucket_id)
+    {
+        auto& bucket = get_bucket(bucket_id);
+        WHIRLWIND_ASSERT(bucket.head != npos());
+
+        const auto node_id = bucket.head;
+        bucket.head = get_node(node_id).next;
+        if (bucket.head == npos()) {
+            bucket.tail = npos();
+        }
+        --bucket.size;
+        --size_;
+
+        // Return the node to the free list.
+        get_node(node_id).next = free_list_;
+        free_list_ = node_id;
+    }
+
+    /** Remove all elements from the specified bucket. */
+    constexpr void
+    clear_bucket(size_type bucket_id)
+    {
+        auto& bucket = get_bucket(bucket_id);
+        if (bucket.head == npos()) {
+            return;
+        }
+
+        // Splice the bucket's list onto the front of the free list.
+        get_node(bucket.tail).next = free_list_;
+        free_list_ = bucket.head;
+        size_ -= bucket.size;
+        bucket = Bucket();
+    }
+
+    /**
+     * Remove all elements from all buckets.
+     *
+     * The number of buckets is unchanged and the node pool's storage is retained for
+     * reuse.
+     */
+    constexpr void
+    clear() noexcept
+    {
+        for (auto& bucket : buckets_) {
+            bucket = Bucket();
+        }
+        nodes_.clear();
+        free_list_ = npos();
+        size_ = 0;
+    }
+
+    /** Get a handle to the specified bucket. */
+    [[nodiscard]] constexpr auto
+    operator[](size_type bucket_id) const -> const_bucket_reference
+    {
+        WHIRLWIND_ASSERT(bucket_id < num_buckets());
+        return {*this, bucket_id};
+    }
+
+    /** Get a handle to the specified bucket. */
+    [[nodiscard]] constexpr auto
+    operator[](size_type bucket_id) -> bucket_reference
+    {
+        WHIRLWIND_ASSERT(bucket_id < num_buckets());
+        return {*this, bucket_id};
+    }
+
+protected:
+    struct Bucket {
+        size_type head = npos();
+        size_type tail = npos();
+        size_type size = 0;
+    };
+
+    struct Node {
+        value_type value;
+        size_type next;
+    };
+
+    [[nodiscard]] static constexpr auto
+    npos() noexcept -> size_type
+    {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    [[nodiscard]] constexpr auto
+    get_bucket(size_type bucket_id) const -> const Bucket&
+    {
+        WHIRLWIND_ASSERT(bucket_id < num_buckets());
+        return buckets_[bucket_id];
+    }
+
+    [[nodiscard]] constexpr auto
+    get_bucket(size_type bucket_id) -> Bucket&
+    {
+        WHIRLWIND_ASSERT(bucket_id < num_buckets());
+        return buckets_[bucket_id];
+    }
+
+    [[nodiscard]] constexpr auto
+    get_node(size_type node_id) const -> const Node&
+    {
+        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(nodes_));
+        return nodes_[node_id];
+    }
+
+    [[nodiscard]] constexpr auto
+    get_node(size_type node_id) -> Node&
+    {
+        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(nodes_));
+        return nodes_[node_id];
+    }
+
+    // Get a new unlinked node containing the specified value, reusing a node from the
+    // free list if possible. Returns the index of the node.
+    [[nodiscard]] constexpr auto
+    make_node(value_type value) -> size_type
+    {
+        if (free_list_ == npos()) {
+            nodes_.push_back({std::move(value), npos()});
+            return std::size(nodes_) - 1;
+        }
+
+        const auto node_id = free_list_;
+        auto& node = get_node(node_id);
+        free_list_ = node.next;
+        node.value = std::move(value);
+        node.next = npos();
+        return node_id;
+    }
+
+private:
+    container_type<Bucket> buckets_;
+    container_type<Node> nodes_ = {};
+    size_type free_list_ = npos();
+    size_type size_ = 0;
+};
+
+/** A lightweight read-only handle to a single bucket in a `BucketQueue`. */
+template<class T, template<class> class Container>
+class BucketQueue<T, Container>::const_bucket_reference {
+public:
+    constexpr const_bucket_reference(const BucketQueue& queue,
+                                     size_type bucket_id) noexcept
+        : queue_(&queue), bucket_id_(bucket_id)
+    {}
+
+    /** The index of the bucket. */
+    [[nodiscard]] constexpr auto
+    id() const noexcept -> size_type
+    {
+        return bucket_id_;
+    }
+
+    /** Check whether the bucket is empty. */
+    [[nodiscard]] constexpr auto
+    empty() const -> bool
+    {
+        return queue_->bucket_empty(id());
+    }
+
+    /** The number of elements in the bucket. */
+    [[nodiscard]] constexpr auto
+    size() const -> size_type
+    {
+        return queue_->bucket_size(id());
+    }
+
+    /** Get the first element in the (non-empty) bucket. */
+    [[nodiscard]] constexpr auto
+    front() const -> const_reference
+    {
+        return queue_->front(id());
+    }
+
+private:
+    const BucketQueue* queue_;
+    size_type bucket_id_;
+};
+
+/** A lightweight mutable handle to a single bucket in a `BucketQueue`. */
+template<class T, template<class> class Container>
+class BucketQueue<T, Container>::bucket_reference {
+public:
+    constexpr bucket_reference(BucketQueue& queue, size_type bucket_id) noexcept
+        : queue_(&queue), bucket_id_(bucket_id)
+    {}
+
+    /** The index of the bucket. */
+    [[nodiscard]] constexpr auto
+    id() const noexcept -> size_type
+    {
+        return bucket_id_;
+    }
+
+    /** Check whether the bucket is empty. */
+    [[nodiscard]] constexpr auto
+    empty() const -> bool
+    {
+        return queue_->bucket_empty(id());
+    }
+
+    /** The number of elements in the bucket. */
+    [[nodiscard]] constexpr auto
+    size() const -> size_type
+    {
+        return queue_->bucket_size(id());
+    }
+
+    /** Get the first element in the (non-empty) bucket. */
+    [[nodiscard]] constexpr auto
+    front() const -> reference
+    {
+        return queue_->front(id());
+    }
+
+    /** Append an element to the back of the bucket. */
+    constexpr void
+    push(value_type value) const
+    {
+        queue_->push(id(), std::move(value));
+    }
+
+    /** Remove the first element from the (non-empty) bucket. */
+    constexpr void
+    pop() const
+    {
+        queue_->pop(id());
+    }
+
+    /** Remove all elements from the bucket. */
+    constexpr void
+    clear() const
+    {
+        queue_->clear_bucket(id());
+    }
+
+private:
+    BucketQueue* queue_;
+    size_type bucket_id_;
+};
+
+WHIRLWIND_NAMESPACE_END
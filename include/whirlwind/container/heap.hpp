@@ -1,8 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <limits>
 #include <queue>
+#include <type_traits>
 #include <utility>
 
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/compatibility.hpp>
 #include <whirlwind/common/namespace.hpp>
 
 #include "vector.hpp"
@@ -49,4 +57,496 @@ public:
     }
 };
 
+/**
+ * A min-priority queue that supports updating the priority of its elements in place.
+ *
+ * Each element is associated with a unique integer index in the range [0, N), which is
+ * used to look up its position in the heap. An index may be present in the heap at
+ * most once. Elements are stored in an implicit d-ary tree ordered by their keys.
+ *
+ * @tparam T
+ *     The element type.
+ * @tparam Key
+ *     The priority type. Elements with smaller keys have higher priority.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the internal arrays of elements
+ *     and positions.
+ * @tparam Arity
+ *     The maximum number of children of each node in the tree. Must be >= 2.
+ */
+template<class T,
+         class Key,
+         template<class> class Container = Vector,
+         std::size_t Arity = 4>
+class IndexedDAryHeap {
+    WHIRLWIND_STATIC_ASSERT(Arity >= 2);
+
+public:
+    using value_type = std::pair<T, Key>;
+    using key_type = Key;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using size_type = std::size_t;
+
+    template<class U>
+    using container_type = Container<U>;
+
+    /** Default constructor. Creates an empty heap. */
+    constexpr IndexedDAryHeap() = default;
+
+    /**
+     * Create a new empty heap with storage for element indices in the range [0, N).
+     *
+     * Elements with larger indices may still be inserted later, at the cost of
+     * reallocating the internal position array.
+     *
+     * @param[in] num_indices
+     *     The number of distinct element indices, N.
+     */
+    explicit constexpr IndexedDAryHeap(size_type num_indices)
+        : position_(num_indices, npos())
+    {
+        WHIRLWIND_DEBUG_ASSERT(std::size(position_) == num_indices);
+    }
+
+    /** The maximum number of children of each node in the tree. */
+    [[nodiscard]] static constexpr auto
+    arity() noexcept -> size_type
+    {
+        return Arity;
+    }
+
+    /** Check whether the heap is empty. */
+    [[nodiscard]] constexpr auto
+    empty() const noexcept -> bool
+    {
+        return std::empty(values_);
+    }
+
+    /** The number of elements in the heap. */
+    [[nodiscard]] constexpr auto
+    size() const noexcept -> size_type
+    {
+        return std::size(values_);
+    }
+
+    /** Check whether the element with the specified index is in the heap. */
+    [[nodiscard]] constexpr auto
+    contains(size_type index) const -> bool
+    {
+        return (index < std::size(position_)) && (position_[index] != npos());
+    }
+
+    /**
+     * Get the key of an element in the heap.
+     *
+     * @param[in] index
+     *     The element index. The element must be in the heap.
+     *
+     * @returns
+     *     The element's key.
+     */
+    [[nodiscard]] constexpr auto
+    key(size_type index) const -> const key_type&
+    {
+        WHIRLWIND_ASSERT(contains(index));
+        using std::get;
+        return get<1>(values_[position_[index]]);
+    }
+
+    /**
+     * Get the element with the smallest key.
+     *
+     * @returns
+     *     A (value,key) pair. The heap must not be empty.
+     */
+    [[nodiscard]] constexpr auto
+    top() const -> const_reference
+    {
+        WHIRLWIND_ASSERT(!empty());
+        return values_.front();
+    }
+
+    /**
+     * Insert a new element.
+     *
+     * @param[in] index
+     *     The element index. The element must not already be in the heap.
+     * @param[in] value
+     *     The element value.
+     * @param[in] key
+     *     The element priority.
+     */
+    constexpr void
+    push(size_type index, T value, key_type key)
+    {
+        WHIRLWIND_ASSERT(!contains(index));
+        if (index >= std::size(position_)) WHIRLWIND_UNLIKELY {
+            position_.resize(index + 1, npos());
+        }
+
+        values_.emplace_back(std::move(value), std::move(key));
+        indices_.push_back(index);
+        WHIRLWIND_DEBUG_ASSERT(std::size(indices_) == std::size(values_));
+
+        sift_up(size() - 1);
+    }
+
+    /**
+     * Decrease the key of an element in the heap.
+     *
+     * @param[in] index
+     *     The element index. The element must be in the heap.
+     * @param[in] key
+     *     The new element priority. Must be <= its current key.
+     */
+    constexpr void
+    decrease_key(size_type index, key_type key)
+    {
+        WHIRLWIND_ASSERT(contains(index));
+        const auto pos = position_[index];
+        WHIRLWIND_DEBUG_ASSERT(pos < size());
+
+        using std::get;
+        WHIRLWIND_ASSERT(!(get<1>(values_[pos]) < key));
+        get<1>(values_[pos]) = std::move(key);
+
+        sift_up(pos);
+    }
+
+    /** Remove the element with the smallest key. The heap must not be empty. */
+    constexpr void
+    pop()
+    {
+        WHIRLWIND_ASSERT(!empty());
+        position_[indices_.front()] = npos();
+
+        if (size() > 1) {
+            values_.front() = std::move(values_.back());
+            indices_.front() = indices_.back();
+        }
+        values_.pop_back();
+        indices_.pop_back();
+
+        if (!empty()) {
+            sift_down(0);
+        }
+    }
+
+    /**
+     * Remove all elements from the heap.
+     *
+     * Runs in time proportional to the number of elements in the heap, not the number
+     * of distinct element indices.
+     */
+    constexpr void
+    clear() noexcept
+    {
+        for (const auto& index : indices_) {
+            position_[index] = npos();
+        }
+        values_.clear();
+        indices_.clear();
+    }
+
+protected:
+    [[nodiscard]] static constexpr auto
+    npos() noexcept -> size_type
+    {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    [[nodiscard]] static constexpr auto
+    less(const value_type& lhs, const value_type& rhs) -> bool
+    {
+        using std::get;
+        return get<1>(lhs) < get<1>(rhs);
+    }
+
+    // Move the element at `pos` towards the root until the heap property is restored.
+    constexpr void
+    sift_up(size_type pos)
+    {
+        WHIRLWIND_DEBUG_ASSERT(pos < size());
+        auto value = std::move(values_[pos]);
+        const auto index = indices_[pos];
+
+        while (pos != 0) {
+            const auto parent = (pos - 1) / arity();
+            if (!less(value, values_[parent])) {
+                break;
+            }
+            move_entry(parent, pos);
+            pos = parent;
+        }
+
+        values_[pos] = std::move(value);
+        indices_[pos] = index;
+        position_[index] = pos;
+    }
+
+    // Move the element at `pos` towards the leaves until the heap property is restored.
+    constexpr void
+    sift_down(size_type pos)
+    {
+        WHIRLWIND_DEBUG_ASSERT(pos < size());
+        const auto n = size();
+        auto value = std::move(values_[pos]);
+        const auto index = indices_[pos];
+
+        while (true) {
+            const auto first_child = arity() * pos + 1;
+            if (first_child >= n) {
+                break;
+            }
+
+            const auto last_child = std::min(first_child + arity(), n);
+            auto best = first_child;
+            for (auto child = first_child + 1; child < last_child; ++child) {
+                if (less(values_[child], values_[best])) {
+                    best = child;
+                }
+            }
+
+            if (!less(values_[best], value)) {
+                break;
+            }
+            move_entry(best, pos);
+            pos = best;
+        }
+
+        values_[pos] = std::move(value);
+        indices_[pos] = index;
+        position_[index] = pos;
+    }
+
+    // Move the entry at position `from` to position `to` and update its position.
+    constexpr void
+    move_entry(size_type from, size_type to)
+    {
+        values_[to] = std::move(values_[from]);
+        indices_[to] = indices_[from];
+        position_[indices_[to]] = to;
+    }
+
+private:
+    container_type<value_type> values_ = {};
+    container_type<size_type> indices_ = {};
+    container_type<size_type> position_ = {};
+};
+
+/**
+ * A monotone min-priority queue with non-negative integer keys.
+ *
+ * Elements are distributed among buckets according to the position of the most
+ * significant bit in which their key differs from the heap's current lower bound (the
+ * key of the most recently accessed top element). Each element moves to a lower bucket
+ * at most once per bit, so push and pop run in amortized O(log C) time, where C is the
+ * largest key, independent of the number of elements.
+ *
+ * The heap is monotone: accessing the top element raises the lower bound to that
+ * element's key, and any key subsequently inserted must be >= the lower bound. This
+ * holds in Dijkstra's algorithm with non-negative edge lengths, where each vertex is
+ * reached via an edge from the most recently popped vertex.
+ *
+ * @tparam T
+ *     The element type.
+ * @tparam Key
+ *     The priority type. Must be an integral type. Elements with smaller keys have
+ *     higher priority.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the contents of each bucket.
+ */
+template<class T, class Key, template<class> class Container = Vector>
+class RadixHeap {
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<Key>);
+
+public:
+    using value_type = std::pair<T, Key>;
+    using key_type = Key;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using size_type = std::size_t;
+
+    template<class U>
+    using container_type = Container<U>;
+
+    /** Default constructor. Creates an empty heap. */
+    constexpr RadixHeap() : buckets_(num_buckets())
+    {
+        WHIRLWIND_DEBUG_ASSERT(std::size(buckets_) == num_buckets());
+    }
+
+    /** The number of buckets (one more than the number of bits in the key type). */
+    [[nodiscard]] static constexpr auto
+    num_buckets() noexcept -> size_type
+    {
+        return std::numeric_limits<unsigned_key_type>::digits + 1;
+    }
+
+    /** Check whether the heap is empty. */
+    [[nodiscard]] constexpr auto
+    empty() const noexcept -> bool
+    {
+        return size_ == 0;
+    }
+
+    /** The number of elements in the heap. */
+    [[nodiscard]] constexpr auto
+    size() const noexcept -> size_type
+    {
+        return size_;
+    }
+
+    /** The smallest key that may currently be inserted into the heap. */
+    [[nodiscard]] constexpr auto
+    lower_bound() const noexcept -> const key_type&
+    {
+        return lower_bound_;
+    }
+
+    /**
+     * Get the element with the smallest key.
+     *
+     * Raises the heap's lower bound to the key of the returned element. The heap must
+     * not be empty.
+     *
+     * @returns
+     *     A (value,key) pair.
+     */
+    [[nodiscard]] constexpr auto
+    top() -> const_reference
+    {
+        WHIRLWIND_ASSERT(!empty());
+        refill_first_bucket();
+        WHIRLWIND_DEBUG_ASSERT(!std::empty(buckets_.front()));
+        return buckets_.front().back();
+    }
+
+    /**
+     * Insert a new element.
+     *
+     * @param[in] value
+     *     A (value,key) pair. The key must be >= the heap's lower bound.
+     */
+    constexpr void
+    push(value_type value)
+    {
+        using std::get;
+        const auto bucket_id = get_bucket_id(get<1>(value));
+        WHIRLWIND_DEBUG_ASSERT(bucket_id < std::size(buckets_));
+        buckets_[bucket_id].push_back(std::move(value));
+        ++size_;
+    }
+
+    /**
+     * Construct a new element in place.
+     *
+     * @param[in] args
+     *     Arguments forwarded to the constructor of `value_type`. The resulting key
+     *     must be >= the heap's lower bound.
+     */
+    template<class... Args>
+    constexpr void
+    emplace(Args&&... args)
+    {
+        push(value_type(std::forward<Args>(args)...));
+    }
+
+    /** Remove the element with the smallest key. The heap must not be empty. */
+    constexpr void
+    pop()
+    {
+        WHIRLWIND_ASSERT(!empty());
+        refill_first_bucket();
+        WHIRLWIND_DEBUG_ASSERT(!std::empty(buckets_.front()));
+        buckets_.front().pop_back();
+        --size_;
+    }
+
+    /**
+     * Remove all elements from the heap and reset its lower bound to zero.
+     *
+     * The storage of each bucket is retained for reuse.
+     */
+    constexpr void
+    clear() noexcept
+    {
+        for (auto& bucket : buckets_) {
+            bucket.clear();
+        }
+        size_ = 0;
+        lower_bound_ = zero_key();
+    }
+
+protected:
+    using unsigned_key_type = std::make_unsigned_t<key_type>;
+
+    [[nodiscard]] static constexpr auto
+    zero_key() noexcept -> key_type
+    {
+        return static_cast<key_type>(0);
+    }
+
+    // Get the index of the bucket that an element with the specified key belongs to:
+    // the bit width of the bitwise difference between the key and the lower bound.
+    [[nodiscard]] constexpr auto
+    get_bucket_id(const key_type& key) const -> size_type
+    {
+        WHIRLWIND_ASSERT(key >= lower_bound());
+        const auto diff = static_cast<unsigned_key_type>(key) ^
+                          static_cast<unsigned_key_type>(lower_bound());
+        return static_cast<size_type>(std::bit_width(diff));
+    }
+
+    // If the first bucket is empty, raise the lower bound to the smallest key in the
+    // first non-empty bucket and redistribute that bucket's contents among the
+    // lower-indexed buckets. Afterwards, the first bucket contains all elements whose
+    // key is equal to the lower bound.
+    constexpr void
+    refill_first_bucket()
+    {
+        WHIRLWIND_DEBUG_ASSERT(!empty());
+        if (!std::empty(buckets_.front())) {
+            return;
+        }
+
+        size_type bucket_id = 1;
+        while (std::empty(buckets_[bucket_id])) {
+            ++bucket_id;
+            WHIRLWIND_DEBUG_ASSERT(bucket_id < std::size(buckets_));
+        }
+
+        auto& bucket = buckets_[bucket_id];
+        using std::get;
+        lower_bound_ = get<1>(bucket.front());
+        for (const auto& item : bucket) {
+            lower_bound_ = std::min(lower_bound_, get<1>(item));
+        }
+
+        for (auto& item : bucket) {
+            const auto new_bucket_id = get_bucket_id(get<1>(item));
+            WHIRLWIND_DEBUG_ASSERT(new_bucket_id < bucket_id);
+            buckets_[new_bucket_id].push_back(std::move(item));
+        }
+        bucket.clear();
+    }
+
+private:
+    container_type<container_type<value_type>> buckets_;
+    size_type size_ = 0;
+    key_type lower_bound_ = zero_key();
+};
+
+/**
+ * A priority queue whose elements are identified by unique integer indices and whose
+ * priorities may be decreased in place.
+ */
+template<class Heap>
+concept AddressableHeapType =
+        requires(Heap h, const Heap ch, std::size_t i, typename Heap::key_type k) {
+            { ch.contains(i) } -> std::convertible_to<bool>;
+            h.decrease_key(i, k);
+        };
+
 WHIRLWIND_NAMESPACE_END
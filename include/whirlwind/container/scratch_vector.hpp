@@ -0,0 +1,317 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A fixed-capacity region of scratch memory.
+ *
+ * The arena allocates a single buffer up front and serves allocations from it in stack
+ * (LIFO) order. Deallocating the most recently allocated block returns its memory to
+ * the arena immediately. Deallocating any other block marks it as free, and its memory
+ * is returned once all blocks allocated after it have been deallocated as well.
+ * Allocating or deallocating memory from the arena never calls the global allocator,
+ * so a task whose peak memory usage fits within the arena's capacity performs no heap
+ * allocations.
+ *
+ * An arena is intended to serve as per-thread scratch memory for a sequence of tasks of
+ * bounded size (e.g. solving each fixed-size tile of a tiled problem). It is not
+ * thread-safe.
+ */
+class ScratchArena {
+public:
+    using size_type = std::size_t;
+
+    /**
+     * Create a new `ScratchArena`.
+     *
+     * @param[in] capacity
+     *     The size of the arena's buffer, in bytes. Each allocation also consumes a
+     *     few bytes of bookkeeping & alignment padding.
+     */
+    explicit ScratchArena(size_type capacity)
+        : buffer_(std::make_unique_for_overwrite<std::byte[]>(capacity)),
+          capacity_(capacity)
+    {}
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena(ScratchArena&&) = delete;
+
+    auto
+    operator=(const ScratchArena&) -> ScratchArena& = delete;
+    auto
+    operator=(ScratchArena&&) -> ScratchArena& = delete;
+
+    /** The size of the arena's buffer, in bytes. */
+    [[nodiscard]] constexpr auto
+    capacity() const noexcept -> size_type
+    {
+        return capacity_;
+    }
+
+    /**
+     * The number of bytes of the buffer currently in use, including blocks that were
+     * deallocated but not yet returned to the arena.
+     */
+    [[nodiscard]] constexpr auto
+    size() const noexcept -> size_type
+    {
+        return size_;
+    }
+
+    /** Check whether the arena has no outstanding allocations. */
+    [[nodiscard]] constexpr auto
+    empty() const noexcept -> bool
+    {
+        return size_ == 0;
+    }
+
+    /** Check whether a pointer points into the arena's buffer. */
+    [[nodiscard]] auto
+    owns(const void* ptr) const noexcept -> bool
+    {
+        const auto* p = static_cast<const std::byte*>(ptr);
+        const auto* first = buffer_.get();
+        const auto* last = first + capacity_;
+        return std::greater_equal<>()(p, first) && std::less<>()(p, last);
+    }
+
+    /**
+     * Allocate a block of memory from the arena.
+     *
+     * Throws `std::bad_alloc` if the arena has insufficient remaining capacity.
+     *
+     * @param[in] num_bytes
+     *     The size of the block, in bytes.
+     * @param[in] alignment
+     *     The alignment of the block. Must be a power of two that is no greater than
+     *     `alignof(std::max_align_t)`.
+     *
+     * @returns
+     *     A pointer to the first byte of the block.
+     */
+    [[nodiscard]] auto
+    allocate(size_type num_bytes, size_type alignment) -> void*
+    {
+        WHIRLWIND_ASSERT(alignment <= alignof(std::max_align_t));
+        WHIRLWIND_DEBUG_ASSERT((alignment & (alignment - 1)) == 0);
+
+        if (num_bytes > capacity_) WHIRLWIND_UNLIKELY {
+            throw std::bad_alloc();
+        }
+
+        const auto start = align_up(size_, alignment);
+        const auto footer = align_up(start + num_bytes, alignof(Footer));
+        const auto stop = footer + sizeof(Footer);
+        if (stop > capacity_) WHIRLWIND_UNLIKELY {
+            throw std::bad_alloc();
+        }
+
+        ::new (buffer_.get() + footer) Footer{size_, false};
+        size_ = stop;
+
+        return buffer_.get() + start;
+    }
+
+    /**
+     * Deallocate a block of memory previously allocated from the arena.
+     *
+     * @param[in] ptr
+     *     A pointer to the block. Must have been returned by `allocate()` and not
+     *     deallocated since.
+     * @param[in] num_bytes
+     *     The size of the block, in bytes. Must be equal to the size passed to
+     *     `allocate()`.
+     */
+    void
+    deallocate(void* ptr, size_type num_bytes) noexcept
+    {
+        WHIRLWIND_ASSERT(owns(ptr));
+        const auto start = static_cast<size_type>(static_cast<std::byte*>(ptr) -
+                                                  buffer_.get());
+
+        auto& footer = get_footer(align_up(start + num_bytes, alignof(Footer)));
+        WHIRLWIND_ASSERT(!footer.is_free);
+        footer.is_free = true;
+
+        // Return any free blocks at the top of the stack to the arena.
+        while (size_ != 0) {
+            WHIRLWIND_DEBUG_ASSERT(size_ >= sizeof(Footer));
+            const auto& top = get_footer(size_ - sizeof(Footer));
+            if (!top.is_free) {
+                break;
+            }
+            size_ = top.prev_size;
+        }
+    }
+
+private:
+    // Bookkeeping data stored after each block.
+    struct Footer {
+        // The size of the arena prior to allocating the block.
+        size_type prev_size;
+        bool is_free;
+    };
+
+    [[nodiscard]] static constexpr auto
+    align_up(size_type offset, size_type alignment) noexcept -> size_type
+    {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    [[nodiscard]] auto
+    get_footer(size_type offset) const noexcept -> Footer&
+    {
+        WHIRLWIND_DEBUG_ASSERT(offset + sizeof(Footer) <= capacity_);
+        return *std::launder(reinterpret_cast<Footer*>(buffer_.get() + offset));
+    }
+
+    std::unique_ptr<std::byte[]> buffer_;
+    size_type capacity_;
+    size_type size_ = 0;
+};
+
+namespace detail {
+
+// The scratch arena that is currently in use by the calling thread (or null).
+[[nodiscard]] inline auto
+current_scratch_arena() noexcept -> ScratchArena*&
+{
+    thread_local ScratchArena* arena = nullptr;
+    return arena;
+}
+
+} // namespace detail
+
+/**
+ * Sets the current thread's scratch arena for the lifetime of the scope object.
+ *
+ * `ScratchAllocator`s that are default-constructed within the scope allocate from the
+ * arena. Upon destruction, the previous scratch arena (if any) is restored.
+ */
+class ScratchArenaScope {
+public:
+    /**
+     * Create a new `ScratchArenaScope`.
+     *
+     * @param[in] arena
+     *     The arena. Must outlive the scope object and any containers that allocate
+     *     from it.
+     */
+    explicit ScratchArenaScope(ScratchArena& arena) noexcept
+        : prev_arena_(detail::current_scratch_arena())
+    {
+        detail::current_scratch_arena() = &arena;
+    }
+
+    ScratchArenaScope(const ScratchArenaScope&) = delete;
+
+    auto
+    operator=(const ScratchArenaScope&) -> ScratchArenaScope& = delete;
+
+    ~ScratchArenaScope() { detail::current_scratch_arena() = prev_arena_; }
+
+private:
+    ScratchArena* prev_arena_;
+};
+
+/**
+ * An allocator that allocates memory from a `ScratchArena`.
+ *
+ * A default-constructed allocator uses the scratch arena of the calling thread at the
+ * time of construction (see `ScratchArenaScope`). Copies of an allocator (including
+ * copies rebound to other value types) share the same arena.
+ *
+ * @tparam T
+ *     The value type.
+ */
+template<class T>
+class ScratchAllocator {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    /** Create an allocator that uses the current thread's scratch arena. */
+    ScratchAllocator() noexcept : arena_(detail::current_scratch_arena()) {}
+
+    /** Create an allocator that uses the specified arena. */
+    explicit constexpr ScratchAllocator(ScratchArena& arena) noexcept : arena_(&arena)
+    {}
+
+    template<class U>
+    constexpr ScratchAllocator(const ScratchAllocator<U>& other) noexcept
+        : arena_(other.arena())
+    {}
+
+    /** The underlying arena (or null, if there was no current arena). */
+    [[nodiscard]] constexpr auto
+    arena() const noexcept -> ScratchArena*
+    {
+        return arena_;
+    }
+
+    /**
+     * Allocate storage for `n` objects of type `T`.
+     *
+     * Throws `std::bad_alloc` if the arena has insufficient remaining capacity.
+     */
+    [[nodiscard]] auto
+    allocate(size_type n) -> T*
+    {
+        WHIRLWIND_ASSERT(arena_ != nullptr);
+        if (n > std::numeric_limits<size_type>::max() / sizeof(T)) WHIRLWIND_UNLIKELY {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    /** Deallocate storage for `n` objects previously obtained from `allocate()`. */
+    void
+    deallocate(T* p, size_type n) noexcept
+    {
+        WHIRLWIND_ASSERT(arena_ != nullptr);
+        arena_->deallocate(p, n * sizeof(T));
+    }
+
+    template<class U>
+    [[nodiscard]] friend constexpr auto
+    operator==(const ScratchAllocator& lhs, const ScratchAllocator<U>& rhs) noexcept
+            -> bool
+    {
+        return lhs.arena() == rhs.arena();
+    }
+
+private:
+    ScratchArena* arena_;
+};
+
+/**
+ * A `std::vector` that allocates memory from a `ScratchArena`.
+ *
+ * This may be used as the `Container` policy of graphs, networks, and solvers so that
+ * all of their internal arrays reside in per-thread scratch memory of fixed capacity.
+ * When paired with a graph of fixed size (e.g. `FixedRectangularGridGraph`), the
+ * memory needed to solve a problem is bounded, so after the arena is created, solving a
+ * sequence of such problems performs no heap allocations.
+ *
+ * @tparam T
+ *     The element type.
+ */
+template<class T>
+using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <utility>
+
+#include <range/v3/view/transform.hpp>
+#include <range/v3/view/zip.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/vector.hpp>
+
+#include "csr_graph.hpp"
+#include "edge_list.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A compressed sparse row (CSR) digraph that also supports iterating over the incoming
+ * edges of each vertex.
+ *
+ * In addition to the CSR representation of `CSRGraph`, the graph stores its transpose
+ * in compressed sparse column (CSC) format: for each vertex, the IDs of its incoming
+ * edges (in the original graph's edge numbering) and the corresponding tail vertices.
+ * The CSC index is stored in a single array that is allocated once, after the CSR
+ * representation has been constructed. The incoming edges of each vertex are ordered
+ * by edge ID.
+ *
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the internal index arrays.
+ * @tparam Index
+ *     The unsigned integer type used to represent vertices and edges.
+ */
+template<template<class> class Container = Vector, class Index = std::size_t>
+class BidirectionalCSRGraph : public CSRGraph<Container, Index> {
+private:
+    using super_type = CSRGraph<Container, Index>;
+
+public:
+    using vertex_type = typename super_type::vertex_type;
+    using edge_type = typename super_type::edge_type;
+    using size_type = typename super_type::size_type;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    using super_type::contains_vertex;
+    using super_type::get_vertex_id;
+
+    /**
+     * Default constructor. Creates an empty `BidirectionalCSRGraph` with no vertices or
+     * edges.
+     */
+    constexpr BidirectionalCSRGraph() : super_type(), t_(make_transpose()) {}
+
+    /**
+     * Create a new `BidirectionalCSRGraph` from a sequence of (tail,head) pairs.
+     *
+     * The number of vertices is one greater than the largest vertex index in the edge
+     * list. The outgoing edges of each vertex are sorted by head vertex.
+     */
+    template<class Vertex, template<class> class UContainer>
+    explicit constexpr BidirectionalCSRGraph(EdgeList<Vertex, UContainer> edge_list)
+        : super_type(std::move(edge_list)), t_(make_transpose())
+    {}
+
+    /**
+     * Create a new `BidirectionalCSRGraph` with the specified number of vertices from a
+     * sequence of (tail,head) pairs.
+     *
+     * The parameters are the same as those of the corresponding `CSRGraph`
+     * constructor.
+     */
+    template<class Vertex, template<class> class UContainer>
+    BidirectionalCSRGraph(const EdgeList<Vertex, UContainer>& edge_list,
+                          size_type num_vertices,
+                          size_type num_threads = 0,
+                          EdgeOrder order = EdgeOrder::sorted)
+        : super_type(edge_list, num_vertices, num_threads, order),
+          t_(make_transpose())
+    {}
+
+    /**
+     * Get the number of incoming edges of a vertex.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     The indegree of the vertex.
+     */
+    [[nodiscard]] constexpr auto
+    indegree(const vertex_type& vertex) const -> size_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        const auto vertex_id = get_vertex_id(vertex);
+        const auto col_offsets = this->col_offsets();
+        return col_offsets[vertex_id + 1] - col_offsets[vertex_id];
+    }
+
+    /**
+     * Iterate over incoming edges (and corresponding tail vertices) of a vertex.
+     *
+     * Returns a view of ordered (edge,tail) pairs over all edges terminating at the
+     * specified vertex in the graph, in order of increasing edge ID.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     A view of the vertex's incoming incident edges and predecessor vertices.
+     */
+    [[nodiscard]] constexpr auto
+    incoming_edges(const vertex_type& vertex) const
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        const auto vertex_id = get_vertex_id(vertex);
+
+        const auto col_offsets = this->col_offsets();
+        const auto cstart = col_offsets[vertex_id];
+        const auto cstop = col_offsets[vertex_id + 1];
+        auto edges = incoming_edge_ids().subspan(cstart, cstop - cstart);
+        auto tails = row_indices().subspan(cstart, cstop - cstart);
+
+        auto to_pair = [](const auto& pair_like) {
+            using std::get;
+            return std::pair<edge_type, vertex_type>(get<0>(pair_like),
+                                                     get<1>(pair_like));
+        };
+
+        return ranges::views::zip(std::move(edges), std::move(tails)) |
+               ranges::views::transform(std::move(to_pair));
+    }
+
+    /**
+     * Invoke a function on each incoming edge (and corresponding tail vertex) of a
+     * vertex.
+     *
+     * Visits the same (edge,tail) pairs as `incoming_edges()`, in the same order,
+     * using a plain loop over the vertex's column of the CSC index.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     * @param[in] visitor
+     *     A function invocable with arguments `(const edge_type&, const vertex_type&)`.
+     */
+    template<class Visitor>
+    constexpr void
+    for_each_incoming_edge(const vertex_type& vertex, Visitor visitor) const
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        const auto vertex_id = get_vertex_id(vertex);
+
+        const auto col_offsets = this->col_offsets();
+        const auto cstart = col_offsets[vertex_id];
+        const auto cstop = col_offsets[vertex_id + 1];
+        const auto edges = incoming_edge_ids();
+        const auto tails = row_indices();
+        WHIRLWIND_DEBUG_ASSERT(cstop <= std::size(edges));
+
+        for (auto pos = cstart; pos != cstop; ++pos) {
+            const edge_type& edge = edges[pos];
+            const vertex_type& tail = tails[pos];
+            visitor(edge, tail);
+        }
+    }
+
+private:
+    // The CSC index is stored in `t_` as the concatenation of three arrays: the V+1
+    // column offsets, followed by the E incoming edge IDs, followed by the E
+    // corresponding tail vertices.
+    [[nodiscard]] constexpr auto
+    col_offsets() const noexcept -> std::span<const edge_type>
+    {
+        return std::span(t_).first(this->num_vertices() + 1);
+    }
+
+    [[nodiscard]] constexpr auto
+    incoming_edge_ids() const noexcept -> std::span<const edge_type>
+    {
+        return std::span(t_).subspan(this->num_vertices() + 1, this->num_edges());
+    }
+
+    [[nodiscard]] constexpr auto
+    row_indices() const noexcept -> std::span<const vertex_type>
+    {
+        const auto num_edges = this->num_edges();
+        return std::span(t_).subspan(this->num_vertices() + 1 + num_edges, num_edges);
+    }
+
+    // Build the CSC index of the graph using a counting sort of the edges by head
+    // vertex, as in `CSRGraph`.
+    [[nodiscard]] constexpr auto
+    make_transpose() const -> container_type<edge_type>
+    {
+        const auto num_vertices = this->num_vertices();
+        const auto num_edges = this->num_edges();
+        const auto view = this->view();
+        const auto row_offsets = view.row_offsets();
+        const auto col_indices = view.col_indices();
+
+        auto t = container_type<edge_type>(num_vertices + 1 + 2 * num_edges, 0);
+        const auto col_offsets = std::span(t).first(num_vertices + 1);
+        const auto edges = std::span(t).subspan(num_vertices + 1, num_edges);
+        const auto tails = std::span(t).subspan(num_vertices + 1 + num_edges);
+
+        // Count the indegree of each vertex, then replace each count with the inclusive
+        // prefix sum of the counts.
+        for (const auto& head : col_indices) {
+            ++col_offsets[head];
+        }
+        auto sum = edge_type{0};
+        for (auto& offset : col_offsets) {
+            sum += offset;
+            offset = sum;
+        }
+
+        // Scatter each edge into its column. Edges are visited in reverse order so that
+        // the incoming edges of each vertex are sorted by edge ID.
+        for (auto tail = num_vertices; tail-- > 0;) {
+            for (auto edge = row_offsets[tail + 1]; edge-- > row_offsets[tail];) {
+                const auto pos = --col_offsets[col_indices[edge]];
+                edges[pos] = edge;
+                tails[pos] = static_cast<vertex_type>(tail);
+            }
+        }
+
+        return t;
+    }
+
+    container_type<edge_type> t_;
+};
+
+WHIRLWIND_NAMESPACE_END
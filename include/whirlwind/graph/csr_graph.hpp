@@ -1,21 +1,25 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <barrier>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <limits>
+#include <numeric>
 #include <span>
 #include <type_traits>
 #include <utility>
 
-#include <range/v3/view/iota.hpp>
-#include <range/v3/view/transform.hpp>
-#include <range/v3/view/zip.hpp>
 
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/compatibility.hpp>
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/common/parallel.hpp>
 #include <whirlwind/container/vector.hpp>
 
+#include "csr_graph_view.hpp"
 #include "edge_list.hpp"
 
 WHIRLWIND_NAMESPACE_BEGIN
@@ -35,6 +39,14 @@ subspan_of(ContiguousRange&& r, // NOLINT(cppcoreguidelines-missing-std-forward)
     return std::span(first, last);
 }
 
+/** The order of the outgoing edges of each vertex in a `CSRGraph`. */
+enum struct EdgeOrder : std::uint8_t {
+    /** Outgoing edges are sorted by head vertex. */
+    sorted,
+    /** Outgoing edges are in the order in which they appear in the input. */
+    stable,
+};
+
 /**
  * A compressed sparse row (CSR) digraph.
  *
@@ -44,12 +56,18 @@ subspan_of(ContiguousRange&& r, // NOLINT(cppcoreguidelines-missing-std-forward)
  * @tparam Container
  *     A `std::vector`-like type template used to store the internal row and column
  *     index arrays.
+ * @tparam Index
+ *     The unsigned integer type used to represent vertices and edges. A 32-bit type
+ *     halves the size of the index arrays (and of the per-vertex and per-edge arrays
+ *     of algorithms that operate on the graph) for graphs with fewer than 2^32 edges.
  */
-template<template<class> class Container = Vector>
+template<template<class> class Container = Vector, class Index = std::size_t>
 class CSRGraph {
+    WHIRLWIND_STATIC_ASSERT(std::is_unsigned_v<Index>);
+
 public:
-    using vertex_type = std::size_t;
-    using edge_type = std::size_t;
+    using vertex_type = Index;
+    using edge_type = Index;
     using size_type = std::size_t;
 
     template<class T>
@@ -62,175 +80,315 @@ public:
         WHIRLWIND_DEBUG_ASSERT(num_edges() == 0);
     }
 
-    /** Create a new `CSRGraph` from a sequence of (tail,head) pairs. */
-    template<template<class> class UContainer>
-    explicit constexpr CSRGraph(EdgeList<vertex_type, UContainer> edge_list)
-        : CSRGraph([&]() {
-              std::sort(std::begin(edge_list), std::end(edge_list));
-
-              CSRGraph graph;
-              graph.c_.reserve(std::size(edge_list));
-
-              size_type edge_count = 0;
+    /**
+     * Create a new `CSRGraph` from a sequence of (tail,head) pairs.
+     *
+     * The number of vertices is one greater than the largest vertex index in the edge
+     * list. The outgoing edges of each vertex are sorted by head vertex.
+     */
+    template<class Vertex, template<class> class UContainer>
+    explicit constexpr CSRGraph(EdgeList<Vertex, UContainer> edge_list)
+        : CSRGraph(edge_list, [&]() {
               size_type max_vertex_id = 0;
               for (const auto& [tail, head] : edge_list) {
-                  const auto new_size = tail + 1;
-                  WHIRLWIND_DEBUG_ASSERT(new_size >= std::size(graph.r_));
-
-                  graph.r_.resize(new_size, edge_count);
-                  graph.c_.emplace_back(head);
-
-                  max_vertex_id = std::max(max_vertex_id, std::max(tail, head));
-
-                  ++edge_count;
+                  max_vertex_id = std::max({max_vertex_id, static_cast<size_type>(tail),
+                                            static_cast<size_type>(head)});
               }
+              return max_vertex_id + 1;
+          }(), 1)
+    {}
 
-              const auto num_vertices = max_vertex_id + 1;
-              graph.r_.resize(num_vertices + 1, edge_count);
+    /**
+     * Create a new `CSRGraph` with the specified number of vertices from a sequence of
+     * (tail,head) pairs.
+     *
+     * The edges are grouped by tail vertex using a counting sort: a histogram of the
+     * outdegree of each vertex, followed by a prefix sum, and then a scatter of each
+     * edge into its row. Each pass may be performed concurrently. The row and column
+     * index arrays are each allocated exactly once.
+     *
+     * @param[in] edge_list
+     *     The edge list. The number of edges must be representable by `Index`.
+     * @param[in] num_vertices
+     *     The number of vertices. Must be greater than the index of each vertex in the
+     *     edge list.
+     * @param[in] num_threads
+     *     The max number of threads. If zero, `default_num_threads()` is used. Small
+     *     graphs are constructed using fewer threads.
+     * @param[in] order
+     *     The order of the outgoing edges of each vertex. If `EdgeOrder::stable`, the
+     *     IDs of edges that share a tail vertex increase with their position in the
+     *     edge list.
+     */
+    template<class Vertex, template<class> class UContainer>
+    CSRGraph(const EdgeList<Vertex, UContainer>& edge_list,
+             size_type num_vertices,
+             size_type num_threads = 0,
+             EdgeOrder order = EdgeOrder::sorted)
+        : r_(num_vertices + 1, 0), c_(std::size(edge_list))
+    {
+        WHIRLWIND_ASSERT(std::size(edge_list) <= std::numeric_limits<Index>::max());
+        WHIRLWIND_ASSERT(num_vertices <= std::numeric_limits<Index>::max());
+
+        if (num_threads == 0) {
+            num_threads = default_num_threads();
+        }
+
+        // Spawning threads isn't worthwhile for small graphs.
+        constexpr auto min_edges_per_thread = size_type{1} << 16U;
+        const auto max_num_threads = std::size(edge_list) / min_edges_per_thread;
+        num_threads = std::clamp(max_num_threads, size_type{1}, num_threads);
+
+        if (num_threads == 1) {
+            init_serial(edge_list, order);
+        } else {
+            init_parallel(edge_list, num_threads, order);
+        }
+
+        WHIRLWIND_DEBUG_ASSERT(this->num_vertices() == num_vertices);
+        WHIRLWIND_DEBUG_ASSERT(num_edges() == std::size(edge_list));
+    }
 
-              return graph;
-          }())
-    {}
+    /**
+     * Get a non-owning view of the graph.
+     *
+     * The view refers to the graph's row and column index arrays and is invalidated
+     * when the graph is destroyed or moved from. Each of the graph's accessors
+     * forwards to the corresponding member of the view.
+     */
+    [[nodiscard]] constexpr auto
+    view() const noexcept -> CSRGraphView<Index>
+    {
+        // The arrays were validated on construction, so they needn't be checked again
+        // each time a view is created.
+        return {detail::unchecked_csr_arrays, r_, c_};
+    }
 
     /** The total number of vertices in the graph. */
     [[nodiscard]] constexpr auto
     num_vertices() const -> size_type
     {
-        WHIRLWIND_DEBUG_ASSERT(std::size(r_) >= 1);
-        return size_type{std::size(r_)} - 1;
+        return view().num_vertices();
     }
 
     /** The total number of edges in the graph. */
     [[nodiscard]] constexpr auto
     num_edges() const -> size_type
     {
-        return size_type{std::size(c_)};
+        return view().num_edges();
     }
 
-    /**
-     * Get the unique array index of a vertex.
-     *
-     * Given a vertex in the graph, get the associated vertex index in the range [0, V),
-     * where V is the total number of vertices.
-     *
-     * @param[in] vertex
-     *     The input vertex. Must be a valid vertex in the graph.
-     *
-     * @returns
-     *     The vertex index.
-     */
+    /** Get the unique array index of a vertex. See `CSRGraphView::get_vertex_id()`. */
     [[nodiscard]] constexpr auto
     get_vertex_id(const vertex_type& vertex) const noexcept -> size_type
     {
-        return vertex;
+        return view().get_vertex_id(vertex);
     }
 
-    /**
-     * Get the unique array index of an edge.
-     *
-     * Given an edge in the graph, get the associated edge index in the range [0, E),
-     * where E is the total number of edges.
-     *
-     * @param[in] edge
-     *     The input edge. Must be a valid edge in the graph.
-     *
-     * @returns
-     *     The edge index.
-     */
+    /** Get the unique array index of an edge. See `CSRGraphView::get_edge_id()`. */
     [[nodiscard]] constexpr auto
     get_edge_id(const edge_type& edge) const noexcept -> size_type
     {
-        return edge;
+        return view().get_edge_id(edge);
     }
 
-    /**
-     * Iterate over vertices in the graph.
-     *
-     * Returns a view of all vertices in the graph in order from smallest index to
-     * largest.
-     */
+    /** Iterate over vertices in the graph. See `CSRGraphView::vertices()`. */
     [[nodiscard]] constexpr auto
     vertices() const
     {
-        return ranges::views::iota(vertex_type{0}, num_vertices());
+        return view().vertices();
     }
 
-    /**
-     * Iterate over edges in the graph.
-     *
-     * Returns a view of all edges in the graph in order from smallest index to largest.
-     */
+    /** Iterate over edges in the graph. See `CSRGraphView::edges()`. */
     [[nodiscard]] constexpr auto
     edges() const
     {
-        return ranges::views::iota(edge_type{0}, num_edges());
+        return view().edges();
     }
 
     /** Check whether the graph contains the specified vertex. */
     [[nodiscard]] constexpr auto
     contains_vertex(const vertex_type& vertex) const -> bool
     {
-        return get_vertex_id(vertex) < num_vertices();
+        return view().contains_vertex(vertex);
     }
 
     /** Check whether the graph contains the specified edge. */
     [[nodiscard]] constexpr auto
     contains_edge(const edge_type& edge) const -> bool
     {
-        return get_edge_id(edge) < num_edges();
+        return view().contains_edge(edge);
     }
 
-    /**
-     * Get the number of outgoing edges of a vertex.
-     *
-     * @param[in] vertex
-     *     The input vertex. Must be a valid vertex in the graph.
-     *
-     * @returns
-     *     The outdegree of the vertex.
-     */
+    /** Get the number of outgoing edges of a vertex. */
     [[nodiscard]] constexpr auto
     outdegree(const vertex_type& vertex) const -> size_type
     {
-        WHIRLWIND_ASSERT(contains_vertex(vertex));
-        const auto vertex_id = get_vertex_id(vertex);
-        return r_[vertex_id + 1] - r_[vertex_id];
+        return view().outdegree(vertex);
     }
 
     /**
-     * Iterate over outgoing edges (and corresponding head vertices) of a vertex.
+     * Iterate over outgoing edges (and corresponding head vertices) of a vertex. See
+     * `CSRGraphView::outgoing_edges()`.
      *
-     * Returns a view of ordered (edge,head) pairs over all edges emanating from the
-     * specified vertex in the graph.
-     *
-     * @param[in] vertex
-     *     The input vertex. Must be a valid vertex in the graph.
-     *
-     * @returns
-     *     A view of the vertex's outgoing incident edges and successor vertices.
+     * The returned view refers to the graph's column index array, not to the
+     * temporary `CSRGraphView`, so it remains valid as long as the graph does.
      */
     [[nodiscard]] constexpr auto
     outgoing_edges(const vertex_type& vertex) const
     {
-        WHIRLWIND_ASSERT(contains_vertex(vertex));
-        const auto vertex_id = get_vertex_id(vertex);
+        return view().outgoing_edges(vertex);
+    }
 
-        WHIRLWIND_DEBUG_ASSERT(vertex_id + 1 < std::size(r_));
-        const auto rstart = r_[vertex_id];
-        const auto rstop = r_[vertex_id + 1];
-        auto edges = ranges::views::iota(rstart, rstop);
-        auto heads = subspan_of(c_, rstart, rstop);
+    /**
+     * Invoke a function on each outgoing edge (and corresponding head vertex) of a
+     * vertex. See `CSRGraphView::for_each_outgoing_edge()`.
+     */
+    template<class Visitor>
+    constexpr void
+    for_each_outgoing_edge(const vertex_type& vertex, Visitor visitor) const
+    {
+        view().for_each_outgoing_edge(vertex, std::move(visitor));
+    }
 
-        auto to_pair = [](const auto& pair_like) {
-            using std::get;
-            return std::pair(get<0>(pair_like), get<1>(pair_like));
-        };
+private:
+    // Sort the outgoing edges of each vertex in the range [`first`, `last`) by head.
+    void
+    sort_rows(size_type first, size_type last)
+    {
+        for (auto vertex_id = first; vertex_id < last; ++vertex_id) {
+            const auto row_begin = r_[vertex_id];
+            const auto row_end = r_[vertex_id + 1];
+            if (row_end - row_begin > 1) {
+                auto row = subspan_of(c_, row_begin, row_end);
+                std::sort(std::begin(row), std::end(row));
+            }
+        }
+    }
 
-        return ranges::views::zip(std::move(edges), std::move(heads)) |
-               ranges::views::transform(std::move(to_pair));
+    // Count the outdegree of each vertex in `r_` such that `r_[v]` is the outdegree of
+    // vertex `v`, then replace each count with the inclusive prefix sum of the counts.
+    // Each edge is then scattered into its row by decrementing the corresponding entry
+    // of `r_`, after which `r_[v]` is the index of the first outgoing edge of `v`.
+    template<class EdgeList_>
+    void
+    init_serial(const EdgeList_& edge_list, EdgeOrder order)
+    {
+        for (const auto& [tail, head] : edge_list) {
+            WHIRLWIND_ASSERT(tail < num_vertices());
+            WHIRLWIND_ASSERT(head < num_vertices());
+            ++r_[tail];
+        }
+
+        std::partial_sum(std::begin(r_), std::end(r_), std::begin(r_));
+
+        // Scattering the edges in reverse order preserves their relative order within
+        // each row.
+        for (auto i = std::size(edge_list); i-- > 0;) {
+            const auto& [tail, head] = edge_list[i];
+            c_[--r_[tail]] = static_cast<vertex_type>(head);
+        }
+
+        if (order == EdgeOrder::sorted) {
+            sort_rows(0, num_vertices());
+        }
+    }
+
+    // As in `init_serial()`, but with each pass performed concurrently. The counts and
+    // offsets in `r_` are updated atomically, so the relative order of the edges within
+    // each row is unspecified after scattering. Each row is then sorted (by head, or by
+    // the position of each edge in the edge list if `order` is `EdgeOrder::stable`).
+    template<class EdgeList_>
+    void
+    init_parallel(const EdgeList_& edge_list, size_type num_threads, EdgeOrder order)
+    {
+        const auto num_edges = std::size(edge_list);
+        const auto num_rows = std::size(r_);
+
+        auto block_sum = container_type<size_type>(num_threads, 0);
+        auto index = container_type<edge_type>();
+        if (order == EdgeOrder::stable) {
+            index.resize(num_edges);
+        }
+
+        auto scheduler = WorkStealingScheduler(num_threads);
+        auto barrier = std::barrier(static_cast<std::ptrdiff_t>(num_threads));
+
+        run_in_parallel(num_threads, [&](size_type thread_id) {
+            const auto edges_begin = num_edges * thread_id / num_threads;
+            const auto edges_end = num_edges * (thread_id + 1) / num_threads;
+            const auto rows_begin = num_rows * thread_id / num_threads;
+            const auto rows_end = num_rows * (thread_id + 1) / num_threads;
+
+            // Count the outdegree of each vertex.
+            for (auto i = edges_begin; i < edges_end; ++i) {
+                const auto& [tail, head] = edge_list[i];
+                WHIRLWIND_ASSERT(tail < num_vertices());
+                WHIRLWIND_ASSERT(head < num_vertices());
+                std::atomic_ref(r_[tail]).fetch_add(1, std::memory_order_relaxed);
+            }
+            barrier.arrive_and_wait();
+
+            // Compute the inclusive prefix sum of the counts. Each thread scans a
+            // contiguous block of counts, offset by the total of the preceding blocks.
+            auto sum = size_type{0};
+            for (auto i = rows_begin; i < rows_end; ++i) {
+                sum += r_[i];
+            }
+            block_sum[thread_id] = sum;
+            barrier.arrive_and_wait();
+
+            auto offset = size_type{0};
+            for (size_type t = 0; t < thread_id; ++t) {
+                offset += block_sum[t];
+            }
+            for (auto i = rows_begin; i < rows_end; ++i) {
+                offset += r_[i];
+                r_[i] = static_cast<edge_type>(offset);
+            }
+            barrier.arrive_and_wait();
+
+            // Scatter each edge (or its index in the edge list) into its row.
+            for (auto i = edges_begin; i < edges_end; ++i) {
+                const auto& [tail, head] = edge_list[i];
+                auto row_offset = std::atomic_ref(r_[tail]);
+                const auto pos = row_offset.fetch_sub(1, std::memory_order_relaxed) - 1;
+                if (order == EdgeOrder::stable) {
+                    index[pos] = static_cast<edge_type>(i);
+                } else {
+                    c_[pos] = static_cast<vertex_type>(head);
+                }
+            }
+            scheduler.reset_slice(thread_id, rows_end - rows_begin);
+            barrier.arrive_and_wait();
+
+            // Sort each row. Rows may vary widely in length, so the work is balanced
+            // among threads via work stealing.
+            while (const auto chunk = scheduler.next(thread_id)) {
+                const auto first = num_rows * chunk->slice / num_threads + chunk->begin;
+                const auto last = std::min(first + (chunk->end - chunk->begin),
+                                           num_vertices());
+                if (order == EdgeOrder::sorted) {
+                    sort_rows(first, last);
+                    continue;
+                }
+                for (auto vertex_id = first; vertex_id < last; ++vertex_id) {
+                    const auto row_begin = r_[vertex_id];
+                    const auto row_end = r_[vertex_id + 1];
+                    if (row_end - row_begin > 1) {
+                        auto row = subspan_of(index, row_begin, row_end);
+                        std::sort(std::begin(row), std::end(row));
+                    }
+                    for (auto pos = row_begin; pos < row_end; ++pos) {
+                        using std::get;
+                        const auto head = get<1>(edge_list[index[pos]]);
+                        c_[pos] = static_cast<vertex_type>(head);
+                    }
+                }
+            }
+        });
     }
 
-private:
     container_type<edge_type> r_;
     container_type<vertex_type> c_;
 };
@@ -0,0 +1,281 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <range/v3/view/iota.hpp>
+#include <range/v3/view/transform.hpp>
+#include <range/v3/view/zip.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+namespace detail {
+
+// Tag type used by `CSRGraph` to create a view of its own (already validated) arrays.
+struct UncheckedCSRArrays {};
+inline constexpr auto unchecked_csr_arrays = UncheckedCSRArrays{};
+
+} // namespace detail
+
+/**
+ * A non-owning view of a compressed sparse row (CSR) digraph.
+ *
+ * Refers to externally owned row and column index arrays (e.g. arrays in a
+ * memory-mapped file) without copying them. The arrays must outlive the view and must
+ * not be modified while it is in use. Otherwise, `CSRGraphView` provides the same
+ * interface as `CSRGraph`.
+ *
+ * The row index array has V+1 elements, where V is the number of vertices. The
+ * outgoing edges of vertex `v` are the edges with indices in the range
+ * [`row_offsets[v]`, `row_offsets[v+1]`), and the head of edge `e` is
+ * `col_indices[e]`.
+ *
+ * @tparam Index
+ *     The unsigned integer type of the elements of the row and column index arrays,
+ *     used to represent vertices and edges.
+ */
+template<class Index = std::size_t>
+class CSRGraphView {
+    WHIRLWIND_STATIC_ASSERT(std::is_unsigned_v<Index>);
+
+public:
+    using vertex_type = Index;
+    using edge_type = Index;
+    using size_type = std::size_t;
+
+    /** Default constructor. Creates an empty view with no vertices or edges. */
+    constexpr CSRGraphView() noexcept : r_(&empty_row_offset, 1), c_() {}
+
+    /**
+     * Create a new `CSRGraphView` from a row index array and a column index array.
+     *
+     * @param[in] row_offsets
+     *     The index of the first outgoing edge of each vertex, followed by the total
+     *     number of edges. Must be non-empty and nondecreasing, with first element 0.
+     * @param[in] col_indices
+     *     The head vertex of each edge. Each element must be a valid vertex index.
+     */
+    constexpr CSRGraphView(std::span<const edge_type> row_offsets,
+                           std::span<const vertex_type> col_indices)
+        : r_(row_offsets), c_(col_indices)
+    {
+        WHIRLWIND_ASSERT(!std::empty(r_));
+        WHIRLWIND_ASSERT(r_.front() == 0);
+        WHIRLWIND_ASSERT(r_.back() == std::size(c_));
+        WHIRLWIND_DEBUG_ASSERT(std::is_sorted(std::begin(r_), std::end(r_)));
+    }
+
+    /**
+     * Create a new `CSRGraphView` from arrays that are known to be valid (e.g. the
+     * arrays of a `CSRGraph`), without checking them.
+     */
+    constexpr CSRGraphView(detail::UncheckedCSRArrays,
+                           std::span<const edge_type> row_offsets,
+                           std::span<const vertex_type> col_indices) noexcept
+        : r_(row_offsets), c_(col_indices)
+    {}
+
+    /** The row index array. */
+    [[nodiscard]] constexpr auto
+    row_offsets() const noexcept -> std::span<const edge_type>
+    {
+        return r_;
+    }
+
+    /** The column index array. */
+    [[nodiscard]] constexpr auto
+    col_indices() const noexcept -> std::span<const vertex_type>
+    {
+        return c_;
+    }
+
+    /** The total number of vertices in the graph. */
+    [[nodiscard]] constexpr auto
+    num_vertices() const -> size_type
+    {
+        WHIRLWIND_DEBUG_ASSERT(std::size(r_) >= 1);
+        return size_type{std::size(r_)} - 1;
+    }
+
+    /** The total number of edges in the graph. */
+    [[nodiscard]] constexpr auto
+    num_edges() const -> size_type
+    {
+        return size_type{std::size(c_)};
+    }
+
+    /**
+     * Get the unique array index of a vertex.
+     *
+     * Given a vertex in the graph, get the associated vertex index in the range [0, V),
+     * where V is the total number of vertices.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     The vertex index.
+     */
+    [[nodiscard]] constexpr auto
+    get_vertex_id(const vertex_type& vertex) const noexcept -> size_type
+    {
+        return vertex;
+    }
+
+    /**
+     * Get the unique array index of an edge.
+     *
+     * Given an edge in the graph, get the associated edge index in the range [0, E),
+     * where E is the total number of edges.
+     *
+     * @param[in] edge
+     *     The input edge. Must be a valid edge in the graph.
+     *
+     * @returns
+     *     The edge index.
+     */
+    [[nodiscard]] constexpr auto
+    get_edge_id(const edge_type& edge) const noexcept -> size_type
+    {
+        return edge;
+    }
+
+    /**
+     * Iterate over vertices in the graph.
+     *
+     * Returns a view of all vertices in the graph in order from smallest index to
+     * largest.
+     */
+    [[nodiscard]] constexpr auto
+    vertices() const
+    {
+        const auto n = static_cast<vertex_type>(num_vertices());
+        return ranges::views::iota(vertex_type{0}, n);
+    }
+
+    /**
+     * Iterate over edges in the graph.
+     *
+     * Returns a view of all edges in the graph in order from smallest index to largest.
+     */
+    [[nodiscard]] constexpr auto
+    edges() const
+    {
+        const auto m = static_cast<edge_type>(num_edges());
+        return ranges::views::iota(edge_type{0}, m);
+    }
+
+    /** Check whether the graph contains the specified vertex. */
+    [[nodiscard]] constexpr auto
+    contains_vertex(const vertex_type& vertex) const -> bool
+    {
+        return get_vertex_id(vertex) < num_vertices();
+    }
+
+    /** Check whether the graph contains the specified edge. */
+    [[nodiscard]] constexpr auto
+    contains_edge(const edge_type& edge) const -> bool
+    {
+        return get_edge_id(edge) < num_edges();
+    }
+
+    /**
+     * Get the number of outgoing edges of a vertex.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     The outdegree of the vertex.
+     */
+    [[nodiscard]] constexpr auto
+    outdegree(const vertex_type& vertex) const -> size_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        const auto vertex_id = get_vertex_id(vertex);
+        return r_[vertex_id + 1] - r_[vertex_id];
+    }
+
+    /**
+     * Iterate over outgoing edges (and corresponding head vertices) of a vertex.
+     *
+     * Returns a view of ordered (edge,head) pairs over all edges emanating from the
+     * specified vertex in the graph.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     A view of the vertex's outgoing incident edges and successor vertices.
+     */
+    [[nodiscard]] constexpr auto
+    outgoing_edges(const vertex_type& vertex) const
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        const auto vertex_id = get_vertex_id(vertex);
+
+        WHIRLWIND_DEBUG_ASSERT(vertex_id + 1 < std::size(r_));
+        const auto rstart = r_[vertex_id];
+        const auto rstop = r_[vertex_id + 1];
+        auto edges = ranges::views::iota(rstart, rstop);
+        auto heads = c_.subspan(rstart, rstop - rstart);
+
+        auto to_pair = [](const auto& pair_like) {
+            using std::get;
+            return std::pair(get<0>(pair_like), get<1>(pair_like));
+        };
+
+        return ranges::views::zip(std::move(edges), std::move(heads)) |
+               ranges::views::transform(std::move(to_pair));
+    }
+
+    /**
+     * Invoke a function on each outgoing edge (and corresponding head vertex) of a
+     * vertex.
+     *
+     * Visits the same (edge,head) pairs as `outgoing_edges()`, in the same order, using
+     * a plain loop over the vertex's row of the column index array.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     * @param[in] visitor
+     *     A function invocable with arguments `(const edge_type&, const vertex_type&)`.
+     */
+    template<class Visitor>
+    constexpr void
+    for_each_outgoing_edge(const vertex_type& vertex, Visitor visitor) const
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        const auto vertex_id = get_vertex_id(vertex);
+
+        WHIRLWIND_DEBUG_ASSERT(vertex_id + 1 < std::size(r_));
+        const auto rstart = r_[vertex_id];
+        const auto rstop = r_[vertex_id + 1];
+        WHIRLWIND_DEBUG_ASSERT(rstop <= std::size(c_));
+
+        for (auto edge = rstart; edge != rstop; ++edge) {
+            const vertex_type& head = c_[edge];
+            visitor(edge, head);
+        }
+    }
+
+private:
+    // The row index array of an empty graph.
+    static constexpr edge_type empty_row_offset = 0;
+
+    std::span<const edge_type> r_;
+    std::span<const vertex_type> c_;
+};
+
+template<class RowOffsets, class ColIndices>
+CSRGraphView(const RowOffsets&, const ColIndices&)
+        -> CSRGraphView<std::ranges::range_value_t<RowOffsets>>;
+
+WHIRLWIND_NAMESPACE_END
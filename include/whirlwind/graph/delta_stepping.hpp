@@ -0,0 +1,737 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <range/v3/range/conversion.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/common/parallel.hpp>
+#include <whirlwind/container/bucket_queue.hpp>
+#include <whirlwind/container/heap.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+#include "dial.hpp"
+#include "forest_concepts.hpp"
+#include "graph_concepts.hpp"
+#include "shortest_path_forest.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * Choose the bucket width for a delta-stepping search of the network's residual graph.
+ *
+ * Following Meyer & Sanders, the bucket width is the mean reduced cost of the
+ * unsaturated arcs divided by their mean out-degree, which bounds the expected number
+ * of times each node is re-relaxed within a bucket. The result is at least 1 (or
+ * positive, for floating-point costs).
+ */
+template<class Network>
+[[nodiscard]] constexpr auto
+get_delta_stepping_bucket_width(const Network& network) -> typename Network::cost_type
+{
+    using Cost = typename Network::cost_type;
+
+    auto sum_arc_length = 0.0;
+    std::size_t num_arcs = 0;
+    for (const auto& tail : network.nodes()) {
+        network.for_each_outgoing_arc(tail, [&](const auto& arc, const auto& head) {
+            if (network.is_arc_saturated(arc)) {
+                return;
+            }
+
+            const auto arc_length = network.arc_reduced_cost(arc, tail, head);
+            WHIRLWIND_ASSERT(arc_length >= zero<Cost>());
+            if (arc_length == infinity<Cost>()) {
+                return;
+            }
+
+            sum_arc_length += static_cast<double>(arc_length);
+            ++num_arcs;
+        });
+    }
+
+    if (num_arcs == 0) {
+        return one<Cost>();
+    }
+
+    const auto m = static_cast<double>(num_arcs);
+    const auto mean_arc_length = sum_arc_length / m;
+    const auto mean_degree = m / static_cast<double>(network.num_nodes());
+    const auto width = static_cast<Cost>(mean_arc_length / mean_degree);
+
+    if constexpr (std::is_integral_v<Cost>) {
+        return std::max(width, one<Cost>());
+    } else {
+        return (width > zero<Cost>()) ? width : one<Cost>();
+    }
+}
+
+/**
+ * The delta-stepping algorithm for single- or multi-source shortest paths.
+ *
+ * Reached vertices are grouped into buckets of width `delta` by their tentative
+ * distance. The solver supports two modes of operation:
+ *
+ * - Sequentially, it satisfies `DijkstraSolverType`. The buckets are stored in a ring
+ *   buffer (as in `Dial`), and the contents of the current bucket are ordered by a
+ *   small heap, so vertices are visited in order of distance and each vertex is visited
+ *   exactly once.
+ * - `run()` performs a complete search concurrently. The vertices in the current
+ *   bucket are processed by a pool of threads, each of which relaxes their light edges
+ *   (length <= `delta`) by atomically updating the tentative distance to each head,
+ *   until the bucket remains empty. The heavy edges of each vertex removed from the
+ *   bucket are then relaxed once. Afterwards, the shortest path forest is populated as
+ *   though the search had been performed sequentially.
+ *
+ * @tparam Distance
+ *     The distance type.
+ * @tparam Graph
+ *     The graph type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store internal arrays.
+ * @tparam Heap
+ *     A min-priority queue of (vertex,distance) pairs, used to order the vertices in
+ *     the current bucket.
+ * @tparam ShortestPaths
+ *     The shortest path forest base type.
+ */
+template<class Distance,
+         GraphType Graph,
+         template<class> class Container = Vector,
+         class Heap = BinaryHeap<typename Graph::vertex_type, Distance, Container>,
+         MutableShortestPathForestType ShortestPaths =
+                 ShortestPathForest<Distance, Graph, Container>>
+class DeltaStepping : public ShortestPaths {
+    WHIRLWIND_STATIC_ASSERT(std::is_arithmetic_v<Distance>);
+
+private:
+    using base_type = ShortestPaths;
+
+public:
+    using distance_type = Distance;
+    using graph_type = Graph;
+    using vertex_type = typename graph_type::vertex_type;
+    using edge_type = typename graph_type::edge_type;
+    using heap_type = Heap;
+    using bucket_queue_type = BucketQueue<vertex_type, Container>;
+    using size_type = std::size_t;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    using base_type::distance_to_vertex;
+    using base_type::graph;
+    using base_type::has_reached_vertex;
+    using base_type::has_visited_vertex;
+    using base_type::is_root_vertex;
+    using base_type::label_vertex_reached;
+    using base_type::label_vertex_visited;
+    using base_type::make_root_vertex;
+    using base_type::predecessor_vertex;
+    using base_type::set_distance_to_vertex;
+    using base_type::set_predecessor;
+
+    /**
+     * Create a new `DeltaStepping` solver.
+     *
+     * @param[in] g
+     *     The graph.
+     * @param[in] delta
+     *     The bucket width. Must be > 0.
+     * @param[in] max_edge_length
+     *     The expected max length of any edge relaxed by the sequential interface,
+     *     which determines the number of buckets. Must be >= 0. Longer edges are
+     *     supported, but vertices reached via such edges may be moved between buckets
+     *     more than once.
+     * @param[in] num_threads
+     *     The number of threads used by `run()`. If zero, `default_num_threads()` is
+     *     used.
+     */
+    constexpr DeltaStepping(const graph_type& g,
+                            distance_type delta,
+                            distance_type max_edge_length,
+                            size_type num_threads = 0)
+        : base_type(g),
+          delta_(delta),
+          buckets_(static_cast<size_type>(max_edge_length / delta) + 2),
+          num_threads_((num_threads == 0) ? default_num_threads() : num_threads),
+          scheduler_(num_threads_)
+    {
+        WHIRLWIND_ASSERT(delta > zero<distance_type>());
+        WHIRLWIND_ASSERT(max_edge_length >= zero<distance_type>());
+        WHIRLWIND_DEBUG_ASSERT(std::empty(heap_));
+    }
+
+    /**
+     * Create a new `DeltaStepping` solver for the residual graph of a network.
+     *
+     * The bucket width is chosen by `get_delta_stepping_bucket_width()`, and the number
+     * of buckets is determined by the max reduced cost of any unsaturated arc.
+     *
+     * @param[in] network
+     *     The network.
+     * @param[in] num_threads
+     *     The number of threads used by `run()`. If zero, `default_num_threads()` is
+     *     used.
+     */
+    template<class Network>
+    explicit constexpr DeltaStepping(const Network& network, size_type num_threads = 0)
+        : DeltaStepping(network.residual_graph(),
+                        get_delta_stepping_bucket_width(network),
+                        get_max_admissible_arc_length(network),
+                        num_threads)
+    {
+        WHIRLWIND_STATIC_ASSERT(
+                std::is_same_v<typename Network::cost_type, distance_type>);
+    }
+
+    /** The bucket width. */
+    [[nodiscard]] constexpr auto
+    bucket_width() const noexcept -> const distance_type&
+    {
+        return delta_;
+    }
+
+    /** The number of threads used by `run()`. */
+    [[nodiscard]] constexpr auto
+    num_threads() const noexcept -> size_type
+    {
+        return num_threads_;
+    }
+
+    /** The number of buckets in the ring buffer used by the sequential interface. */
+    [[nodiscard]] constexpr auto
+    num_buckets() const noexcept -> size_type
+    {
+        return buckets_.num_buckets();
+    }
+
+    /**
+     * The index of the current bucket, which contains the vertices whose distance is in
+     * [`current_bucket_id() * delta`, `(current_bucket_id() + 1) * delta`).
+     */
+    [[nodiscard]] constexpr auto
+    current_bucket_id() const noexcept -> size_type
+    {
+        return current_bucket_id_;
+    }
+
+    /** Get the index of the bucket that contains the specified distance. */
+    [[nodiscard]] constexpr auto
+    get_bucket_id(const distance_type& distance) const -> size_type
+    {
+        WHIRLWIND_DEBUG_ASSERT(distance >= zero<distance_type>());
+        return static_cast<size_type>(distance / delta_);
+    }
+
+    constexpr void
+    push_vertex(vertex_type vertex, const distance_type& distance)
+    {
+        WHIRLWIND_ASSERT(graph().contains_vertex(vertex));
+        WHIRLWIND_ASSERT(distance >= zero<distance_type>());
+        WHIRLWIND_DEBUG_ASSERT(has_reached_vertex(vertex));
+
+        const auto bucket_id = get_bucket_id(distance);
+        WHIRLWIND_ASSERT(bucket_id >= current_bucket_id());
+
+        // Vertices in the current bucket are ordered by the heap. The remaining
+        // buckets are unordered.
+        if (bucket_id == current_bucket_id()) {
+            heap_.emplace(std::move(vertex), distance);
+        } else {
+            buckets_.push(bucket_id % num_buckets(), std::move(vertex));
+        }
+    }
+
+    constexpr void
+    add_source(vertex_type source)
+    {
+        WHIRLWIND_ASSERT(graph().contains_vertex(source));
+        WHIRLWIND_ASSERT(!has_reached_vertex(source));
+
+        make_root_vertex(source);
+        WHIRLWIND_DEBUG_ASSERT(predecessor_vertex(source) == source);
+
+        label_vertex_reached(source);
+        set_distance_to_vertex(source, zero<distance_type>());
+        push_vertex(std::move(source), zero<distance_type>());
+    }
+
+    constexpr auto
+    pop_next_unvisited_vertex()
+    {
+        WHIRLWIND_ASSERT(!std::empty(heap_));
+        auto top = heap_.top();
+        using std::get;
+        WHIRLWIND_DEBUG_ASSERT(has_reached_vertex(get<0>(top)));
+        WHIRLWIND_DEBUG_ASSERT(!has_visited_vertex(get<0>(top)));
+        heap_.pop();
+        return top;
+    }
+
+    constexpr void
+    reach_vertex(edge_type edge,
+                 vertex_type tail,
+                 vertex_type head,
+                 distance_type distance)
+    {
+        WHIRLWIND_ASSERT(graph().contains_edge(edge));
+        WHIRLWIND_ASSERT(graph().contains_vertex(tail));
+        WHIRLWIND_ASSERT(graph().contains_vertex(head));
+        WHIRLWIND_ASSERT(distance >= zero<distance_type>());
+
+        WHIRLWIND_DEBUG_ASSERT(has_visited_vertex(tail));
+        WHIRLWIND_DEBUG_ASSERT(!has_visited_vertex(head));
+        WHIRLWIND_DEBUG_ASSERT(distance >= distance_to_vertex(tail));
+
+        set_predecessor(head, std::move(tail), std::move(edge));
+        WHIRLWIND_DEBUG_ASSERT(!is_root_vertex(head));
+        label_vertex_reached(head);
+        set_distance_to_vertex(head, distance);
+        push_vertex(std::move(head), distance);
+    }
+
+    constexpr void
+    visit_vertex(const vertex_type& vertex, [[maybe_unused]] distance_type distance)
+    {
+        WHIRLWIND_ASSERT(graph().contains_vertex(vertex));
+        WHIRLWIND_ASSERT(distance >= zero<distance_type>());
+        WHIRLWIND_DEBUG_ASSERT(has_reached_vertex(vertex));
+        label_vertex_visited(vertex);
+    }
+
+    constexpr void
+    relax_edge(edge_type edge,
+               vertex_type tail,
+               vertex_type head,
+               distance_type distance)
+    {
+        WHIRLWIND_ASSERT(graph().contains_edge(edge));
+        WHIRLWIND_ASSERT(graph().contains_vertex(tail));
+        WHIRLWIND_ASSERT(graph().contains_vertex(head));
+        WHIRLWIND_ASSERT(distance >= zero<distance_type>());
+
+        WHIRLWIND_DEBUG_ASSERT(has_visited_vertex(tail));
+        WHIRLWIND_DEBUG_ASSERT(distance >= distance_to_vertex(tail));
+
+        if (distance < distance_to_vertex(head)) {
+            reach_vertex(std::move(edge), std::move(tail), std::move(head),
+                         std::move(distance));
+        }
+    }
+
+    [[nodiscard]] constexpr auto
+    done() -> bool
+    {
+        while (true) {
+            // Discard stale entries of previously visited vertices from the heap.
+            while (!std::empty(heap_)) {
+                using std::get;
+                if (!has_visited_vertex(get<0>(heap_.top()))) {
+                    return false;
+                }
+                heap_.pop();
+            }
+
+            if (buckets_.empty()) {
+                return true;
+            }
+
+            // Advance to the next bucket and move its contents into the heap, skipping
+            // vertices that were since visited. Vertices whose distance lies beyond the
+            // end of the ring buffer share a slot with the current bucket, and are
+            // returned to the slot until their bucket comes around.
+            ++current_bucket_id_;
+            const auto slot = current_bucket_id() % num_buckets();
+            while (!buckets_.bucket_empty(slot)) {
+                auto vertex = buckets_.front(slot);
+                buckets_.pop(slot);
+                if (has_visited_vertex(vertex)) {
+                    continue;
+                }
+                const auto& distance = distance_to_vertex(vertex);
+                if (get_bucket_id(distance) == current_bucket_id()) {
+                    heap_.emplace(std::move(vertex), distance);
+                } else {
+                    deferred_.push_back(std::move(vertex));
+                }
+            }
+            for (auto& vertex : deferred_) {
+                buckets_.push(slot, std::move(vertex));
+            }
+            deferred_.clear();
+        }
+    }
+
+    /**
+     * Find the shortest paths from the specified sources to every reachable vertex,
+     * using `num_threads()` threads.
+     *
+     * The solver must be in its initial state (i.e. newly created or reset). Upon
+     * return, each reachable vertex is labeled "visited", its distance is set, and its
+     * predecessor is an edge along a shortest path from the nearest source, exactly as
+     * if the search had been performed using the sequential interface.
+     *
+     * @param[in] sources
+     *     A range of source vertices.
+     * @param[in] edge_length
+     *     A function object callable as `edge_length(edge, tail, head)` that returns
+     *     the nonnegative length of the edge. Edges of infinite length are ignored.
+     *     Called concurrently from multiple threads.
+     */
+    template<class Sources, class EdgeLength>
+    void
+    run(Sources&& sources, EdgeLength edge_length)
+    {
+        init_parallel_state();
+
+        for (const auto& source : sources) {
+            WHIRLWIND_ASSERT(graph().contains_vertex(source));
+            const auto vertex_id = graph().get_vertex_id(source);
+            distance_[vertex_id].store(zero<distance_type>(),
+                                       std::memory_order_relaxed);
+            push_vertex_id(workers_[0], vertex_id, zero<distance_type>());
+        }
+        workers_[0].min_bucket = find_min_bucket(workers_[0], 0);
+
+        // The worker threads are started by the first search and reused by each
+        // subsequent one.
+        if (thread_pool_ == nullptr) {
+            thread_pool_ = std::make_unique<ThreadPool>(num_threads());
+        }
+
+        auto barrier = std::barrier(static_cast<std::ptrdiff_t>(num_threads()));
+        thread_pool_->run([&](size_type thread_id) {
+            find_shortest_paths(thread_id, barrier, edge_length);
+        });
+
+        // Store the results in the shortest path forest.
+        for (size_type vertex_id = 0; vertex_id < std::size(vertices_); ++vertex_id) {
+            const auto distance = distance_[vertex_id].load(std::memory_order_relaxed);
+            if (distance == infinity<distance_type>()) {
+                continue;
+            }
+
+            const auto& vertex = vertices_[vertex_id];
+            const auto tail_id = pred_tail_[vertex_id];
+            if (tail_id == npos()) {
+                make_root_vertex(vertex);
+            } else {
+                set_predecessor(vertex, vertices_[tail_id], pred_edge_[vertex_id]);
+            }
+            set_distance_to_vertex(vertex, distance);
+            label_vertex_visited(vertex);
+        }
+    }
+
+    constexpr void
+    reset()
+    {
+        base_type::reset();
+        heap_.clear();
+        buckets_.clear();
+        current_bucket_id_ = 0;
+        WHIRLWIND_DEBUG_ASSERT(std::empty(heap_));
+    }
+
+protected:
+    // A successful update of the tentative distance to a vertex, recorded by the
+    // thread that performed it.
+    struct Relaxation {
+        size_type head;
+        size_type tail;
+        edge_type edge;
+        distance_type distance;
+    };
+
+    // Per-thread state of the concurrent search.
+    struct alignas(64) Worker {
+        container_type<container_type<size_type>> buckets = {};
+        size_type min_bucket = 0;
+        container_type<size_type> frontier = {};
+        container_type<size_type> settled = {};
+        container_type<Relaxation> relaxations = {};
+    };
+
+    [[nodiscard]] static constexpr auto
+    npos() noexcept -> size_type
+    {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    // Atomically replace the value of `target` with `value` if `value` is smaller.
+    // Returns true if the value was replaced.
+    [[nodiscard]] static auto
+    atomic_fetch_min(std::atomic<distance_type>& target,
+                     const distance_type& value) noexcept -> bool
+    {
+        auto current = target.load(std::memory_order_relaxed);
+        while (value < current) {
+            if (target.compare_exchange_weak(current, value,
+                                             std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Allocate the arrays used by `run()` on first use, and reset the per-vertex
+    // distances and predecessors.
+    void
+    init_parallel_state()
+    {
+        const auto n = graph().num_vertices();
+        if (std::size(vertices_) != n) {
+            vertices_ = graph().vertices() | ranges::to<container_type<vertex_type>>();
+            distance_ = container_type<std::atomic<distance_type>>(n);
+            pred_tail_ = container_type<size_type>(n);
+            pred_edge_ = container_type<edge_type>(n);
+            frontier_stamp_ = container_type<std::atomic<size_type>>(n);
+            settled_stamp_ = container_type<std::atomic<size_type>>(n);
+            workers_ = container_type<Worker>(num_threads());
+        }
+
+        for (size_type vertex_id = 0; vertex_id < n; ++vertex_id) {
+            distance_[vertex_id].store(infinity<distance_type>(),
+                                       std::memory_order_relaxed);
+            pred_tail_[vertex_id] = npos();
+        }
+
+        for (auto& worker : workers_) {
+            for (auto& bucket : worker.buckets) {
+                bucket.clear();
+            }
+            worker.min_bucket = npos();
+            worker.settled.clear();
+            worker.relaxations.clear();
+        }
+    }
+
+    void
+    push_vertex_id(Worker& worker, size_type vertex_id, const distance_type& distance)
+    {
+        const auto bucket_id = get_bucket_id(distance);
+        if (bucket_id >= std::size(worker.buckets)) {
+            worker.buckets.resize(bucket_id + 1);
+        }
+        worker.buckets[bucket_id].push_back(vertex_id);
+    }
+
+    // Find the index of the first non-empty bucket in the worker's buckets, starting
+    // from the specified index. Returns `npos()` if all such buckets are empty.
+    [[nodiscard]] static auto
+    find_min_bucket(const Worker& worker, size_type first) -> size_type
+    {
+        for (auto bucket_id = first; bucket_id < std::size(worker.buckets);
+             ++bucket_id) {
+            if (!std::empty(worker.buckets[bucket_id])) {
+                return bucket_id;
+            }
+        }
+        return npos();
+    }
+
+    // Move the contents of the thread's current bucket into its frontier, skipping
+    // stale entries and vertices already in another thread's frontier. Each vertex's
+    // frontier and settled flags are stored as the index of the last round (or bucket)
+    // in which it was claimed, so they never need to be cleared.
+    auto
+    extract_frontier(Worker& worker,
+                     size_type bucket_id,
+                     size_type round,
+                     size_type epoch) -> size_type
+    {
+        worker.frontier.clear();
+        if (bucket_id >= std::size(worker.buckets)) {
+            return 0;
+        }
+
+        auto& bucket = worker.buckets[bucket_id];
+        for (const auto& vertex_id : bucket) {
+            const auto distance = distance_[vertex_id].load(std::memory_order_relaxed);
+            if (get_bucket_id(distance) != bucket_id) {
+                continue;
+            }
+            if (frontier_stamp_[vertex_id].exchange(round, std::memory_order_relaxed) ==
+                round) {
+                continue;
+            }
+
+            worker.frontier.push_back(vertex_id);
+
+            if (settled_stamp_[vertex_id].exchange(epoch, std::memory_order_relaxed) !=
+                epoch) {
+                worker.settled.push_back(vertex_id);
+            }
+        }
+        bucket.clear();
+
+        return std::size(worker.frontier);
+    }
+
+    // Relax each outgoing edge of the specified vertex whose length is either <= delta
+    // (`light` is true) or > delta (`light` is false).
+    template<class EdgeLength>
+    void
+    relax_vertex(Worker& worker,
+                 size_type tail_id,
+                 bool light,
+                 EdgeLength& edge_length)
+    {
+        const auto& tail = vertices_[tail_id];
+        const auto distance = distance_[tail_id].load(std::memory_order_relaxed);
+
+        graph().for_each_outgoing_edge(tail, [&](const auto& edge, const auto& head) {
+            const auto length = edge_length(edge, tail, head);
+            WHIRLWIND_ASSERT(length >= zero<distance_type>());
+            if (length == infinity<distance_type>()) {
+                return;
+            }
+            if ((length <= delta_) != light) {
+                return;
+            }
+
+            const auto head_id = graph().get_vertex_id(head);
+            const auto new_distance = distance + length;
+            if (atomic_fetch_min(distance_[head_id], new_distance)) {
+                push_vertex_id(worker, head_id, new_distance);
+                worker.relaxations.push_back({head_id, tail_id, edge, new_distance});
+            }
+        });
+    }
+
+    // Relax the outgoing edges of each vertex in the specified per-thread lists, which
+    // are distributed among threads via work stealing.
+    template<class GetList, class EdgeLength>
+    void
+    relax_vertices(size_type thread_id,
+                   GetList get_list,
+                   bool light,
+                   EdgeLength& edge_length)
+    {
+        auto& worker = workers_[thread_id];
+        while (const auto chunk = scheduler_.next(thread_id)) {
+            const auto& list = get_list(workers_[chunk->slice]);
+            for (auto i = chunk->begin; i < chunk->end; ++i) {
+                relax_vertex(worker, list[i], light, edge_length);
+            }
+        }
+    }
+
+    template<class EdgeLength>
+    void
+    find_shortest_paths(size_type thread_id,
+                        std::barrier<>& barrier,
+                        EdgeLength& edge_length)
+    {
+        auto& worker = workers_[thread_id];
+
+        // The round and epoch counters are advanced identically by each thread. Other
+        // threads only read the stored values before the first barrier, so thread 0
+        // may store the final values without further synchronization.
+        auto round = round_;
+        auto epoch = epoch_;
+
+        while (true) {
+            barrier.arrive_and_wait();
+
+            // Find the first non-empty bucket among all threads. Each thread computes
+            // the same value.
+            auto bucket_id = npos();
+            for (const auto& other : workers_) {
+                bucket_id = std::min(bucket_id, other.min_bucket);
+            }
+            if (bucket_id == npos()) {
+                break;
+            }
+
+            ++epoch;
+
+            // Repeatedly relax light edges from vertices in the current bucket until it
+            // remains empty.
+            while (true) {
+                ++round;
+                const auto frontier_size =
+                        extract_frontier(worker, bucket_id, round, epoch);
+                scheduler_.reset_slice(thread_id, frontier_size);
+                barrier.arrive_and_wait();
+
+                size_type total_frontier_size = 0;
+                for (const auto& other : workers_) {
+                    total_frontier_size += std::size(other.frontier);
+                }
+                if (total_frontier_size == 0) {
+                    break;
+                }
+
+                relax_vertices(
+                        thread_id,
+                        [](const Worker& w) -> const auto& { return w.frontier; },
+                        true, edge_length);
+                barrier.arrive_and_wait();
+            }
+
+            // Relax the heavy edges from each vertex that was settled in this bucket.
+            scheduler_.reset_slice(thread_id, std::size(worker.settled));
+            barrier.arrive_and_wait();
+
+            relax_vertices(
+                    thread_id, [](const Worker& w) -> const auto& { return w.settled; },
+                    false, edge_length);
+            barrier.arrive_and_wait();
+
+            worker.settled.clear();
+            worker.min_bucket = find_min_bucket(worker, bucket_id);
+        }
+
+        // The distance to each vertex only ever decreases, so exactly one successful
+        // relaxation of each non-source vertex set its final distance. Its tail was
+        // already final at that time, so the predecessors form a forest.
+        for (const auto& relaxation : worker.relaxations) {
+            const auto head_id = relaxation.head;
+            const auto distance = distance_[head_id].load(std::memory_order_relaxed);
+            if (relaxation.distance == distance) {
+                pred_tail_[head_id] = relaxation.tail;
+                pred_edge_[head_id] = relaxation.edge;
+            }
+        }
+
+        if (thread_id == 0) {
+            round_ = round;
+            epoch_ = epoch;
+        }
+    }
+
+private:
+    distance_type delta_;
+    heap_type heap_ = {};
+    bucket_queue_type buckets_;
+    size_type current_bucket_id_ = 0;
+    container_type<vertex_type> deferred_ = {};
+
+    // State used by `run()`.
+    size_type num_threads_;
+    container_type<vertex_type> vertices_ = {};
+    container_type<std::atomic<distance_type>> distance_ = {};
+    container_type<size_type> pred_tail_ = {};
+    container_type<edge_type> pred_edge_ = {};
+    container_type<std::atomic<size_type>> frontier_stamp_ = {};
+    container_type<std::atomic<size_type>> settled_stamp_ = {};
+    container_type<Worker> workers_ = {};
+    WorkStealingScheduler scheduler_;
+    std::unique_ptr<ThreadPool> thread_pool_ = {};
+    size_type round_ = 0;
+    size_type epoch_ = 0;
+};
+
+WHIRLWIND_NAMESPACE_END
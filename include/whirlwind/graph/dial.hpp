@@ -5,14 +5,14 @@
 #include <type_traits>
 #include <utility>
 
-#include <range/v3/algorithm/for_each.hpp>
 #include <range/v3/algorithm/minmax.hpp>
 #include <range/v3/view/filter.hpp>
+#include <range/v3/view/iota.hpp>
 #include <range/v3/view/transform.hpp>
 
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
-#include <whirlwind/container/queue.hpp>
+#include <whirlwind/container/bucket_queue.hpp>
 #include <whirlwind/container/vector.hpp>
 #include <whirlwind/math/numbers.hpp>
 
@@ -30,20 +30,20 @@ get_max_admissible_arc_length(const Network& network) -> typename Network::cost_
     auto max_arc_length = zero<Cost>();
 
     for (const auto& tail : network.nodes()) {
-        for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
+        network.for_each_outgoing_arc(tail, [&](const auto& arc, const auto& head) {
             if (network.is_arc_saturated(arc)) {
-                continue;
+                return;
             }
 
             const auto arc_length = network.arc_reduced_cost(arc, tail, head);
             WHIRLWIND_ASSERT(!std::isnan(arc_length));
             WHIRLWIND_ASSERT(arc_length >= zero<Cost>());
             if (std::isinf(arc_length)) {
-                continue;
+                return;
             }
 
             max_arc_length = std::max(max_arc_length, arc_length);
-        }
+        });
     }
 
     return max_arc_length;
@@ -52,7 +52,7 @@ get_max_admissible_arc_length(const Network& network) -> typename Network::cost_
 template<class Distance,
          GraphType Graph,
          template<class> class Container = Vector,
-         class Queue = Queue<typename Graph::vertex_type>,
+         class Buckets = BucketQueue<typename Graph::vertex_type, Container>,
          MutableShortestPathForestType ShortestPaths =
                  ShortestPathForest<Distance, Graph, Container>>
 class Dial : public ShortestPaths {
@@ -66,7 +66,9 @@ public:
     using graph_type = Graph;
     using vertex_type = typename graph_type::vertex_type;
     using edge_type = typename graph_type::edge_type;
-    using queue_type = Queue;
+    using bucket_queue_type = Buckets;
+    using bucket_reference = typename bucket_queue_type::bucket_reference;
+    using const_bucket_reference = typename bucket_queue_type::const_bucket_reference;
     using size_type = std::size_t;
 
     template<class T>
@@ -87,7 +89,7 @@ public:
     constexpr Dial(const graph_type& g, size_type num_buckets)
         : base_type(g), buckets_(num_buckets)
     {
-        WHIRLWIND_DEBUG_ASSERT(std::size(buckets_) == num_buckets);
+        WHIRLWIND_DEBUG_ASSERT(buckets_.num_buckets() == num_buckets);
         WHIRLWIND_DEBUG_ASSERT(current_bucket_id() == 0);
     }
 
@@ -106,21 +108,48 @@ public:
     }
 
     [[nodiscard]] constexpr auto
-    buckets() const noexcept -> const container_type<queue_type>&
+    bucket_queue() const noexcept -> const bucket_queue_type&
     {
         return buckets_;
     }
 
     [[nodiscard]] constexpr auto
-    buckets() noexcept -> container_type<queue_type>&
+    bucket_queue() noexcept -> bucket_queue_type&
     {
         return buckets_;
     }
 
+    [[nodiscard]] constexpr auto
+    buckets() const
+    {
+        return ranges::views::iota(size_type{0}, num_buckets()) |
+               ranges::views::transform(
+                       [this](size_type bucket_id) { return get_bucket(bucket_id); });
+    }
+
+    [[nodiscard]] constexpr auto
+    buckets()
+    {
+        return ranges::views::iota(size_type{0}, num_buckets()) |
+               ranges::views::transform(
+                       [this](size_type bucket_id) { return get_bucket(bucket_id); });
+    }
+
     [[nodiscard]] constexpr auto
     num_buckets() const noexcept -> size_type
     {
-        return std::size(buckets());
+        return bucket_queue().num_buckets();
+    }
+
+    /**
+     * The max length of any edge that may be relaxed, which is one less than the
+     * number of buckets.
+     */
+    [[nodiscard]] constexpr auto
+    max_edge_length() const -> distance_type
+    {
+        WHIRLWIND_ASSERT(num_buckets() >= 1);
+        return static_cast<distance_type>(num_buckets() - 1);
     }
 
     [[nodiscard]] constexpr auto
@@ -137,27 +166,27 @@ public:
     }
 
     [[nodiscard]] constexpr auto
-    get_bucket(size_type bucket_id) const -> const queue_type&
+    get_bucket(size_type bucket_id) const -> const_bucket_reference
     {
-        WHIRLWIND_ASSERT(bucket_id < std::size(buckets_));
-        return buckets_[bucket_id];
+        WHIRLWIND_ASSERT(bucket_id < num_buckets());
+        return bucket_queue()[bucket_id];
     }
 
     [[nodiscard]] constexpr auto
-    get_bucket(size_type bucket_id) -> queue_type&
+    get_bucket(size_type bucket_id) -> bucket_reference
     {
-        WHIRLWIND_ASSERT(bucket_id < std::size(buckets_));
-        return buckets_[bucket_id];
+        WHIRLWIND_ASSERT(bucket_id < num_buckets());
+        return bucket_queue()[bucket_id];
     }
 
     [[nodiscard]] constexpr auto
-    current_bucket() const -> const queue_type&
+    current_bucket() const -> const_bucket_reference
     {
         return get_bucket(current_bucket_id());
     }
 
     [[nodiscard]] constexpr auto
-    current_bucket() -> queue_type&
+    current_bucket() -> bucket_reference
     {
         return get_bucket(current_bucket_id());
     }
@@ -183,7 +212,7 @@ public:
         WHIRLWIND_DEBUG_ASSERT(has_reached_vertex(vertex));
 
         const auto bucket_id = get_bucket_id(distance);
-        get_bucket(bucket_id).push(std::move(vertex));
+        bucket_queue().push(bucket_id, std::move(vertex));
     }
 
     constexpr void
@@ -204,7 +233,7 @@ public:
     constexpr auto
     pop_next_unvisited_vertex()
     {
-        auto& bucket = current_bucket();
+        auto bucket = current_bucket();
         WHIRLWIND_ASSERT(!std::empty(bucket));
         auto front = bucket.front();
         WHIRLWIND_DEBUG_ASSERT(has_reached_vertex(front));
@@ -279,7 +308,7 @@ public:
             // If the current bucket is not empty, check each vertex in the bucket
             // until the first unvisited vertex is found or the bucket's contents
             // are exhausted. Visited vertices are removed from the bucket.
-            auto& bucket = current_bucket();
+            auto bucket = current_bucket();
             while (!std::empty(bucket)) {
                 if (!has_visited_vertex(bucket.front())) {
                     return false;
@@ -303,13 +332,13 @@ public:
         base_type::reset();
 
         // Clear the contents of each bucket and reset the current position to the
-        // first bucket.
-        ranges::for_each(buckets(), [](auto& bucket) { bucket.clear(); });
+        // first bucket. The storage of the bucket queue is retained for reuse.
+        bucket_queue().clear();
         current_bucket_id_ = 0;
     }
 
 private:
-    container_type<queue_type> buckets_;
+    bucket_queue_type buckets_;
     size_type current_bucket_id_ = 0;
 };
 
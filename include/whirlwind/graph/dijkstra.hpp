@@ -14,6 +14,25 @@
 
 WHIRLWIND_NAMESPACE_BEGIN
 
+/**
+ * Dijkstra's algorithm for single- or multi-source shortest paths.
+ *
+ * If `Heap` is an addressable heap (such as `IndexedDAryHeap`), each vertex is inserted
+ * into the heap at most once, and its priority is decreased in place whenever a shorter
+ * path to it is found. Otherwise, a new heap entry is added each time a vertex is
+ * reached, and stale entries of previously visited vertices are discarded lazily.
+ *
+ * @tparam Distance
+ *     The distance type.
+ * @tparam Graph
+ *     The graph type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store internal arrays.
+ * @tparam Heap
+ *     A min-priority queue of (vertex,distance) pairs.
+ * @tparam ShortestPaths
+ *     The shortest path forest base type.
+ */
 template<class Distance,
          GraphType Graph,
          template<class> class Container = Vector,
@@ -43,7 +62,7 @@ public:
     using base_type::set_distance_to_vertex;
     using base_type::set_predecessor;
 
-    explicit constexpr Dijkstra(const graph_type& g) : base_type(g), heap_{}
+    explicit constexpr Dijkstra(const graph_type& g) : base_type(g), heap_(make_heap(g))
     {
         WHIRLWIND_DEBUG_ASSERT(std::empty(heap_));
     }
@@ -73,7 +92,17 @@ public:
         WHIRLWIND_ASSERT(graph().contains_vertex(vertex));
         WHIRLWIND_ASSERT(distance >= zero<distance_type>());
         WHIRLWIND_DEBUG_ASSERT(has_reached_vertex(vertex));
-        heap().emplace(std::move(vertex), std::move(distance));
+
+        if constexpr (AddressableHeapType<heap_type>) {
+            const auto vertex_id = graph().get_vertex_id(vertex);
+            if (heap().contains(vertex_id)) {
+                heap().decrease_key(vertex_id, std::move(distance));
+            } else {
+                heap().push(vertex_id, std::move(vertex), std::move(distance));
+            }
+        } else {
+            heap().emplace(std::move(vertex), std::move(distance));
+        }
     }
 
     constexpr void
@@ -156,18 +185,22 @@ public:
     [[nodiscard]] constexpr auto
     done() -> bool
     {
-        // TODO: Some heap implementations support modifying the priority of nodes in
-        // the heap. In this case, each vertex should be inserted into the heap only
-        // once, and `done()` could simply check whether the heap is empty.
-        while (!heap().empty()) {
-            using std::get;
-            const auto& vertex = get<0>(heap().top());
-            if (!has_visited_vertex(vertex)) {
-                return false;
+        // If the heap supports modifying the priority of its elements, each vertex is
+        // inserted into the heap only once and removed when it's visited, so there
+        // are no stale entries to discard.
+        if constexpr (AddressableHeapType<heap_type>) {
+            return heap().empty();
+        } else {
+            while (!heap().empty()) {
+                using std::get;
+                const auto& vertex = get<0>(heap().top());
+                if (!has_visited_vertex(vertex)) {
+                    return false;
+                }
+                heap().pop();
             }
-            heap().pop();
+            return true;
         }
-        return true;
     }
 
     constexpr void
@@ -178,6 +211,17 @@ public:
         WHIRLWIND_DEBUG_ASSERT(std::empty(heap()));
     }
 
+protected:
+    [[nodiscard]] static constexpr auto
+    make_heap(const graph_type& g) -> heap_type
+    {
+        if constexpr (AddressableHeapType<heap_type>) {
+            return heap_type(g.num_vertices());
+        } else {
+            return heap_type();
+        }
+    }
+
 private:
     heap_type heap_;
 };
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <concepts>
+#include <cstddef>
+#include <span>
 
 #include <whirlwind/common/namespace.hpp>
 #include <whirlwind/container/pair_like.hpp>
@@ -28,6 +30,26 @@ concept DijkstraSolverTypeImpl =
             s.reset();
         };
 
+// A function object that returns the length of any (edge,tail,head) triple, used to
+// check that a solver supports concurrent whole-graph searches.
+template<class Distance>
+struct EdgeLengthFunction {
+    template<class Edge, class Vertex>
+    constexpr auto
+    operator()(const Edge&, const Vertex&, const Vertex&) const noexcept -> Distance
+    {
+        return {};
+    }
+};
+
+template<class DijkstraSolver, class Distance, class Vertex>
+concept ParallelDijkstraSolverTypeImpl =
+        requires(DijkstraSolver s, std::span<const Vertex> sources) {
+            { s.num_threads() } -> std::convertible_to<std::size_t>;
+
+            s.run(sources, EdgeLengthFunction<Distance>());
+        };
+
 } // namespace detail
 
 template<class T>
@@ -37,4 +59,15 @@ concept DijkstraSolverType = detail::DijkstraSolverTypeImpl<T,
                                                             typename T::vertex_type,
                                                             typename T::edge_type>;
 
+/**
+ * A `DijkstraSolverType` that can also perform a complete search from a set of sources
+ * concurrently, via `run(sources, edge_length)`.
+ */
+template<class T>
+concept ParallelDijkstraSolverType =
+        DijkstraSolverType<T> &&
+        detail::ParallelDijkstraSolverTypeImpl<T,
+                                               typename T::distance_type,
+                                               typename T::vertex_type>;
+
 WHIRLWIND_NAMESPACE_END
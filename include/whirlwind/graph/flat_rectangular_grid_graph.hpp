@@ -0,0 +1,471 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <generator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <range/v3/view/iota.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+#include "grid_edge_numbering.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A 2-dimensional rectangular grid graph with linearly-indexed vertices.
+ *
+ * A graph consisting of an M x N Cartesian grid of vertices. Each vertex has an
+ * outgoing edge to each of its four neighboring vertices (except at the boundaries).
+ *
+ * This graph has the same topology and the same edge numbering as
+ * `RectangularGridGraph`, but each vertex is represented by its (row-major) linear
+ * index rather than by a (row,col) pair. This halves the size of per-vertex arrays of
+ * vertices (e.g. predecessor vertices and heap entries) and reduces the index
+ * arithmetic used to find the neighbors of a vertex to additions. The row and column
+ * of a vertex are computed on demand.
+ *
+ * @tparam P
+ *     The number of parallel edges between adjacent vertices.
+ * @tparam Index
+ *     The unsigned integer type used to represent vertices, edges, and the number of
+ *     rows and columns in the graph.
+ */
+template<std::size_t P = 1, class Index = std::size_t>
+class FlatRectangularGridGraph {
+    WHIRLWIND_STATIC_ASSERT(std::is_unsigned_v<Index>);
+
+public:
+    using dim_type = Index;
+    using vertex_type = Index;
+    using edge_type = Index;
+    using size_type = std::size_t;
+
+    /**
+     * Default constructor. Creates an empty `FlatRectangularGridGraph` with no vertices
+     * or edges.
+     */
+    constexpr FlatRectangularGridGraph() = default;
+
+    /**
+     * Create a new `FlatRectangularGridGraph`.
+     *
+     * @param[in] num_rows
+     *     The number of rows in the 2-D array of vertices.
+     * @param[in] num_cols
+     *     The number of columns in the 2-D array of vertices.
+     */
+    constexpr FlatRectangularGridGraph(dim_type num_rows, dim_type num_cols) noexcept
+        : num_rows_(num_rows), num_cols_(num_cols), edge_numbering_(num_rows, num_cols)
+    {
+        WHIRLWIND_ASSERT(num_vertices() <= std::numeric_limits<vertex_type>::max());
+        WHIRLWIND_ASSERT(num_edges() <= std::numeric_limits<edge_type>::max());
+    }
+
+    /** The number of parallel edges between adjacent vertices. */
+    [[nodiscard]] static WHIRLWIND_CONSTEVAL auto
+    num_parallel_edges() noexcept -> size_type
+    {
+        return P;
+    }
+
+    /** The number of rows of vertices in the graph. */
+    [[nodiscard]] constexpr auto
+    num_rows() const noexcept -> dim_type
+    {
+        return num_rows_;
+    }
+
+    /** The number of columns of vertices in the graph. */
+    [[nodiscard]] constexpr auto
+    num_cols() const noexcept -> dim_type
+    {
+        return num_cols_;
+    }
+
+    /** The total number of vertices in the graph. */
+    [[nodiscard]] constexpr auto
+    num_vertices() const noexcept -> size_type
+    {
+        return static_cast<size_type>(num_rows()) * static_cast<size_type>(num_cols());
+    }
+
+    /** The total number of edges in the graph. */
+    [[nodiscard]] constexpr auto
+    num_edges() const noexcept -> size_type
+    {
+        const auto m = static_cast<size_type>(num_rows());
+        const auto n = static_cast<size_type>(num_cols());
+        return edge_numbering_type::count_edges(m, n);
+    }
+
+    /**
+     * Get the vertex at the specified row and column of the grid.
+     *
+     * @param[in] row
+     *     The row index. Must be less than `num_rows()`.
+     * @param[in] col
+     *     The column index. Must be less than `num_cols()`.
+     *
+     * @returns
+     *     The vertex.
+     */
+    [[nodiscard]] constexpr auto
+    get_vertex(dim_type row, dim_type col) const -> vertex_type
+    {
+        WHIRLWIND_ASSERT(row < num_rows());
+        WHIRLWIND_ASSERT(col < num_cols());
+        return static_cast<vertex_type>(row * num_cols() + col);
+    }
+
+    /**
+     * Get the row index of a vertex.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     The index of the row of the grid that contains the vertex.
+     */
+    [[nodiscard]] constexpr auto
+    get_row(const vertex_type& vertex) const -> dim_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        return static_cast<dim_type>(vertex / num_cols());
+    }
+
+    /**
+     * Get the column index of a vertex.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     The index of the column of the grid that contains the vertex.
+     */
+    [[nodiscard]] constexpr auto
+    get_col(const vertex_type& vertex) const -> dim_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        return static_cast<dim_type>(vertex % num_cols());
+    }
+
+    /**
+     * Get the unique array index of a vertex.
+     *
+     * Given a vertex in the graph, get the associated vertex index in the range [0, V),
+     * where V is the total number of vertices.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     The vertex index.
+     */
+    [[nodiscard]] constexpr auto
+    get_vertex_id(const vertex_type& vertex) const noexcept -> size_type
+    {
+        return static_cast<size_type>(vertex);
+    }
+
+    /**
+     * Get the unique array index of an edge.
+     *
+     * Given an edge in the graph, get the associated edge index in the range [0, E),
+     * where E is the total number of edges.
+     *
+     * @param[in] edge
+     *     The input edge. Must be a valid edge in the graph.
+     *
+     * @returns
+     *     The edge index.
+     */
+    [[nodiscard]] constexpr auto
+    get_edge_id(const edge_type& edge) const noexcept -> size_type
+    {
+        return static_cast<size_type>(edge);
+    }
+
+    /**
+     * Iterate over vertices in the graph.
+     *
+     * Returns a view of all vertices in the graph in order from smallest index to
+     * largest.
+     */
+    [[nodiscard]] constexpr auto
+    vertices() const
+    {
+        const auto n = static_cast<vertex_type>(num_vertices());
+        return ranges::views::iota(vertex_type{0}, n);
+    }
+
+    /**
+     * Iterate over edges in the graph.
+     *
+     * Returns a view of all edges in the graph in order from smallest index to largest.
+     */
+    [[nodiscard]] constexpr auto
+    edges() const
+    {
+        const auto m = static_cast<edge_type>(num_edges());
+        return ranges::views::iota(edge_type{0}, m);
+    }
+
+    /** Check whether the graph contains the specified vertex. */
+    [[nodiscard]] constexpr auto
+    contains_vertex(const vertex_type& vertex) const -> bool
+    {
+        return get_vertex_id(vertex) < num_vertices();
+    }
+
+    /** Check whether the graph contains the specified edge. */
+    [[nodiscard]] constexpr auto
+    contains_edge(const edge_type& edge) const -> bool
+    {
+        return get_edge_id(edge) < num_edges();
+    }
+
+    /**
+     * Get the number of outgoing edges of a vertex.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     The outdegree of the vertex.
+     */
+    [[nodiscard]] constexpr auto
+    outdegree(const vertex_type& vertex) const noexcept -> size_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+
+        const auto i = get_row(vertex);
+        const auto j = static_cast<dim_type>(vertex - i * num_cols());
+
+        size_type n = 4;
+
+        // clang-format off
+        if (i == 0) WHIRLWIND_UNLIKELY { --n; }
+        if (j == 0) WHIRLWIND_UNLIKELY { --n; }
+        if (i == num_rows() - 1) WHIRLWIND_UNLIKELY { --n; }
+        if (j == num_cols() - 1) WHIRLWIND_UNLIKELY { --n; }
+        // clang-format on
+
+        return n * num_parallel_edges();
+    }
+
+    /**
+     * Get the outgoing edge of `vertex` whose head is the immediate neighbor of
+     * `vertex` in the row above `vertex`.
+     *
+     * If there are multiple parallel directed edges between the two vertices, returns
+     * the first such edge.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph. Must not be in the
+     *     first row of vertices in the grid.
+     *
+     * @returns
+     *     The upward-facing outgoing edge of the input vertex.
+     */
+    [[nodiscard]] constexpr auto
+    get_up_edge(const vertex_type& vertex) const -> edge_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        WHIRLWIND_ASSERT(vertex >= num_cols());
+        return edge_numbering_.up_edge(get_vertex_id(vertex), num_cols());
+    }
+
+    /**
+     * Get the outgoing edge of `vertex` whose head is the immediate neighbor of
+     * `vertex` in the column to the left of `vertex`.
+     *
+     * If there are multiple parallel directed edges between the two vertices, returns
+     * the first such edge.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph. Must not be in the
+     *     first column of vertices in the grid.
+     *
+     * @returns
+     *     The leftward-facing outgoing edge of the input vertex.
+     */
+    [[nodiscard]] constexpr auto
+    get_left_edge(const vertex_type& vertex) const -> edge_type
+    {
+        WHIRLWIND_ASSERT(get_col(vertex) != 0);
+        return get_left_edge(vertex, get_row(vertex));
+    }
+
+    /**
+     * Get the outgoing edge of `vertex` whose head is the immediate neighbor of
+     * `vertex` in the row below `vertex`.
+     *
+     * If there are multiple parallel directed edges between the two vertices, returns
+     * the first such edge.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph. Must not be in the
+     *     last row of vertices in the grid.
+     *
+     * @returns
+     *     The downward-facing outgoing edge of the input vertex.
+     */
+    [[nodiscard]] constexpr auto
+    get_down_edge(const vertex_type& vertex) const -> edge_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        WHIRLWIND_ASSERT(get_row(vertex) + 1 != num_rows());
+        return edge_numbering_.down_edge(get_vertex_id(vertex));
+    }
+
+    /**
+     * Get the outgoing edge of `vertex` whose head is the immediate neighbor of
+     * `vertex` in the column to the right of `vertex`.
+     *
+     * If there are multiple parallel directed edges between the two vertices, returns
+     * the first such edge.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph. Must not be in the
+     *     last column of vertices in the grid.
+     *
+     * @returns
+     *     The rightward-facing outgoing edge of the input vertex.
+     */
+    [[nodiscard]] constexpr auto
+    get_right_edge(const vertex_type& vertex) const -> edge_type
+    {
+        WHIRLWIND_ASSERT(get_col(vertex) + 1 != num_cols());
+        return get_right_edge(vertex, get_row(vertex));
+    }
+
+    /**
+     * Iterate over outgoing edges (and corresponding head vertices) of a vertex.
+     *
+     * Returns a view of ordered (edge,head) pairs over all edges emanating from the
+     * specified vertex in the graph.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     A view of the vertex's outgoing incident edges and successor vertices.
+     */
+    [[nodiscard]] auto
+    outgoing_edges(vertex_type vertex) const
+            -> std::generator<std::pair<edge_type, vertex_type>>
+    {
+        auto edges = std::array<std::pair<edge_type, vertex_type>, 4 * P>();
+        auto num_edges = size_type{0};
+        for_each_outgoing_edge(vertex, [&](const auto& edge, const auto& head) {
+            edges[num_edges++] = std::pair(edge, head);
+        });
+
+        for (size_type k = 0; k != num_edges; ++k) {
+            co_yield edges[k];
+        }
+    }
+
+    /**
+     * Invoke a function on each outgoing edge (and corresponding head vertex) of a
+     * vertex.
+     *
+     * Visits the same (edge,head) pairs as `outgoing_edges()`, in the same order, but
+     * without suspending a coroutine between edges. This avoids allocating a coroutine
+     * frame for each call and is preferred in performance-critical inner loops.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     * @param[in] visitor
+     *     A function invocable with arguments `(const edge_type&, const vertex_type&)`.
+     */
+    template<class Visitor>
+    constexpr void
+    for_each_outgoing_edge(const vertex_type& vertex, Visitor visitor) const
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+
+        // The only division needed to visit the neighbors of a vertex. The neighbors
+        // themselves are found by adding (or subtracting) 1 or N to the vertex index.
+        const auto n = num_cols();
+        const auto i = static_cast<dim_type>(vertex / n);
+        const auto j = static_cast<dim_type>(vertex - i * n);
+
+        // up
+        if (i != 0) WHIRLWIND_LIKELY {
+            const auto head = static_cast<vertex_type>(vertex - n);
+            WHIRLWIND_DEBUG_ASSERT(contains_vertex(head));
+            visit_parallel_edges(get_up_edge(vertex), head, visitor);
+        }
+
+        // left
+        if (j != 0) WHIRLWIND_LIKELY {
+            const auto head = static_cast<vertex_type>(vertex - 1);
+            WHIRLWIND_DEBUG_ASSERT(contains_vertex(head));
+            visit_parallel_edges(get_left_edge(vertex, i), head, visitor);
+        }
+
+        // down
+        if (i + 1 != num_rows()) WHIRLWIND_LIKELY {
+            const auto head = static_cast<vertex_type>(vertex + n);
+            WHIRLWIND_DEBUG_ASSERT(contains_vertex(head));
+            visit_parallel_edges(get_down_edge(vertex), head, visitor);
+        }
+
+        // right
+        if (j + 1 != n) WHIRLWIND_LIKELY {
+            const auto head = static_cast<vertex_type>(vertex + 1);
+            WHIRLWIND_DEBUG_ASSERT(contains_vertex(head));
+            visit_parallel_edges(get_right_edge(vertex, i), head, visitor);
+        }
+    }
+
+protected:
+    // Get the leftward-facing outgoing edge of `vertex`, which is in row `row`.
+    [[nodiscard]] constexpr auto
+    get_left_edge(const vertex_type& vertex, dim_type row) const -> edge_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        WHIRLWIND_DEBUG_ASSERT(row == get_row(vertex));
+        return edge_numbering_.left_edge(get_vertex_id(vertex), row);
+    }
+
+    // Get the rightward-facing outgoing edge of `vertex`, which is in row `row`.
+    [[nodiscard]] constexpr auto
+    get_right_edge(const vertex_type& vertex, dim_type row) const -> edge_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        WHIRLWIND_DEBUG_ASSERT(row == get_row(vertex));
+        return edge_numbering_.right_edge(get_vertex_id(vertex), row);
+    }
+
+    template<class Visitor>
+    constexpr void
+    visit_parallel_edges(edge_type first_edge,
+                         const vertex_type& head,
+                         Visitor& visitor) const
+    {
+        // The number of parallel edges is a compile-time constant, so this loop is
+        // expected to be fully unrolled.
+        for (size_type p = 0; p != num_parallel_edges(); ++p) {
+            const auto edge = static_cast<edge_type>(first_edge + p);
+            WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
+            visitor(edge, head);
+        }
+    }
+
+private:
+    using edge_numbering_type = detail::GridEdgeNumbering<P, edge_type>;
+
+    dim_type num_rows_ = {};
+    dim_type num_cols_ = {};
+    edge_numbering_type edge_numbering_ = {};
+};
+
+WHIRLWIND_NAMESPACE_END
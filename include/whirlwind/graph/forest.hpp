@@ -4,7 +4,6 @@
 #include <utility>
 
 #include <range/v3/algorithm/copy.hpp>
-#include <range/v3/algorithm/fill.hpp>
 
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
@@ -22,6 +21,10 @@ WHIRLWIND_NAMESPACE_BEGIN
  * parent) vertex and edge in the tree, enabling traversal up to the tree's root. A root
  * vertex's predecessor is itself.
  *
+ * The forest keeps track of each vertex whose predecessor has been modified since it
+ * was created or last reset, so that resetting the forest costs time proportional to
+ * the number of such vertices rather than the size of the graph.
+ *
  * A `Forest` maintains a non-owning pointer to its underlying graph. It may be
  * invalidated if the graph is modified or its lifetime ends.
  *
@@ -29,7 +32,7 @@ WHIRLWIND_NAMESPACE_BEGIN
  *     The graph type.
  * @tparam Container
  *     A `std::vector`-like type template used to store the internal arrays of
- *     predecessor vertices and edges.
+ *     predecessor vertices and edges and the list of modified vertices.
  */
 template<GraphType Graph, template<class> class Container = Vector>
 class Forest {
@@ -188,6 +191,17 @@ public:
         WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(pred_vertex_));
         WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(pred_edge_));
 
+        // Record each vertex whose predecessor is modified from its initial state so
+        // that it can be restored by `reset()`. This includes a root vertex that is
+        // assigned a predecessor edge other than `edge_fill_value`.
+        const auto was_initial = (pred_vertex_[vertex_id] == vertex) &&
+                                 (pred_edge_[vertex_id] == edge_fill_value());
+        const auto is_initial =
+                (pred_vertex == vertex) && (pred_edge == edge_fill_value());
+        if (was_initial && !is_initial) {
+            touched_vertices_.push_back(vertex);
+        }
+
         pred_vertex_[vertex_id] = std::move(pred_vertex);
         pred_edge_[vertex_id] = std::move(pred_edge);
     }
@@ -257,15 +271,24 @@ public:
      *
      * Re-initializes the forest such that each vertex in the graph is the root of its
      * own singleton tree (by setting its predecessor vertex to itself). Each
-     * predecessor edge is set to the value of `edge_fill_value`.
+     * predecessor edge of a vertex that was modified is set to the value of
+     * `edge_fill_value`.
+     *
+     * Only vertices whose predecessor was modified since the forest was created or
+     * last reset are updated, so the cost is proportional to the number of such
+     * vertices rather than the number of vertices in the graph.
      */
     constexpr void
     reset()
     {
-        WHIRLWIND_DEBUG_ASSERT(std::size(pred_vertex_) == graph().num_vertices());
-        ranges::copy(graph().vertices(), std::begin(pred_vertex_));
-        WHIRLWIND_DEBUG_ASSERT(std::size(pred_edge_) == graph().num_vertices());
-        ranges::fill(pred_edge_, edge_fill_value());
+        for (const auto& vertex : touched_vertices_) {
+            const auto vertex_id = graph().get_vertex_id(vertex);
+            WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(pred_vertex_));
+            WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(pred_edge_));
+            pred_vertex_[vertex_id] = vertex;
+            pred_edge_[vertex_id] = edge_fill_value();
+        }
+        touched_vertices_.clear();
     }
 
 private:
@@ -273,6 +296,7 @@ private:
     container_type<vertex_type> pred_vertex_;
     container_type<edge_type> pred_edge_;
     edge_type edge_fill_value_;
+    container_type<vertex_type> touched_vertices_ = {};
 };
 
 WHIRLWIND_NAMESPACE_END
@@ -8,6 +8,15 @@ WHIRLWIND_NAMESPACE_BEGIN
 
 namespace detail {
 
+// A function object that accepts any (edge,vertex) pair, used to check that a graph
+// type supports visitor-based iteration over outgoing (or incoming) edges.
+struct OutgoingEdgeVisitor {
+    template<class Edge, class Vertex>
+    constexpr void
+    operator()(const Edge&, const Vertex&) const noexcept
+    {}
+};
+
 template<class Graph, class Vertex, class Edge, class Size>
 concept GraphTypeImpl = requires(const Graph g, const Vertex v, const Edge e) {
     requires std::same_as<Size, std::size_t>;
@@ -20,6 +29,13 @@ concept GraphTypeImpl = requires(const Graph g, const Vertex v, const Edge e) {
     g.vertices();
     g.edges();
     g.outgoing_edges(v);
+    g.for_each_outgoing_edge(v, OutgoingEdgeVisitor());
+};
+
+template<class Graph, class Vertex>
+concept BidirectionalGraphTypeImpl = requires(const Graph g, const Vertex v) {
+    g.incoming_edges(v);
+    g.for_each_incoming_edge(v, OutgoingEdgeVisitor());
 };
 
 } // namespace detail
@@ -30,4 +46,15 @@ concept GraphType = detail::GraphTypeImpl<T,
                                           typename T::edge_type,
                                           typename T::size_type>;
 
+/**
+ * A graph that also supports iterating over the incoming edges of each vertex.
+ *
+ * In addition to the requirements of `GraphType`, `incoming_edges(v)` returns a view of
+ * (edge,tail) pairs over the edges whose head is `v`, and
+ * `for_each_incoming_edge(v, visitor)` invokes `visitor(edge, tail)` on each such edge.
+ */
+template<class T>
+concept BidirectionalGraphType =
+        GraphType<T> && detail::BidirectionalGraphTypeImpl<T, typename T::vertex_type>;
+
 WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+namespace detail {
+
+// The edge numbering of an M x N rectangular grid graph with P parallel edges between
+// adjacent vertices, shared by `RectangularGridGraph` and `FlatRectangularGridGraph`.
+//
+// Edges are grouped by direction: all upward-facing edges, followed by the leftward,
+// downward, and rightward-facing edges. Within each group, edges are ordered by the
+// row-major index of their tail vertex (skipping vertices with no neighbor in that
+// direction), and the P parallel edges emanating from each tail vertex are
+// consecutive. The edges of each vertex are found from its row-major index `v` and
+// its row `i` using only additions and multiplications.
+template<std::size_t P, class Edge>
+class GridEdgeNumbering {
+public:
+    using size_type = std::size_t;
+
+    constexpr GridEdgeNumbering() = default;
+
+    constexpr GridEdgeNumbering(size_type num_rows, size_type num_cols) noexcept
+        : offsets_{make_offsets(num_rows, num_cols)}
+    {}
+
+    // The total number of edges in an M x N grid.
+    [[nodiscard]] static constexpr auto
+    count_edges(size_type m, size_type n) noexcept -> size_type
+    {
+        if ((m == 0) || (n == 0)) WHIRLWIND_UNLIKELY {
+            return 0;
+        }
+
+        const auto num_ud_edges = (m - 1) * n;
+        const auto num_lr_edges = m * (n - 1);
+
+        return 2 * P * (num_ud_edges + num_lr_edges);
+    }
+
+    // The first upward-facing edge of vertex `v` in a grid with `n` columns. The
+    // vertex must not be in the first row.
+    [[nodiscard]] constexpr auto
+    up_edge(size_type v, size_type n) const noexcept -> Edge
+    {
+        WHIRLWIND_DEBUG_ASSERT(v >= n);
+        return static_cast<Edge>(P * (v - n));
+    }
+
+    // The first leftward-facing edge of vertex `v` in row `i`. The vertex must not be
+    // in the first column.
+    [[nodiscard]] constexpr auto
+    left_edge(size_type v, size_type i) const noexcept -> Edge
+    {
+        WHIRLWIND_DEBUG_ASSERT(v >= i + 1);
+        return static_cast<Edge>(offsets_[0] + P * (v - i - 1));
+    }
+
+    // The first downward-facing edge of vertex `v`. The vertex must not be in the last
+    // row.
+    [[nodiscard]] constexpr auto
+    down_edge(size_type v) const noexcept -> Edge
+    {
+        return static_cast<Edge>(offsets_[1] + P * v);
+    }
+
+    // The first rightward-facing edge of vertex `v` in row `i`. The vertex must not be
+    // in the last column.
+    [[nodiscard]] constexpr auto
+    right_edge(size_type v, size_type i) const noexcept -> Edge
+    {
+        WHIRLWIND_DEBUG_ASSERT(v >= i);
+        return static_cast<Edge>(offsets_[2] + P * (v - i));
+    }
+
+private:
+    // The index of the first leftward, downward, and rightward-facing edge.
+    [[nodiscard]] static constexpr auto
+    make_offsets(size_type m, size_type n) noexcept -> std::array<Edge, 3>
+    {
+        if ((m == 0) || (n == 0)) WHIRLWIND_UNLIKELY {
+            return {0, 0, 0};
+        }
+
+        const auto num_ud_edges = P * (m - 1) * n;
+        const auto num_lr_edges = P * m * (n - 1);
+
+        const auto off0 = num_ud_edges;
+        const auto off1 = off0 + num_lr_edges;
+        const auto off2 = off1 + num_ud_edges;
+
+        return {static_cast<Edge>(off0), static_cast<Edge>(off1),
+                static_cast<Edge>(off2)};
+    }
+
+    std::array<Edge, 3> offsets_ = {};
+};
+
+} // namespace detail
+
+WHIRLWIND_NAMESPACE_END
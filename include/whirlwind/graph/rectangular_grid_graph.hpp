@@ -1,8 +1,9 @@
 #pragma once
 
-#include <array>
 #include <cstddef>
 #include <generator>
+#include <limits>
+#include <span>
 #include <type_traits>
 #include <utility>
 
@@ -14,8 +15,49 @@
 #include <whirlwind/common/compatibility.hpp>
 #include <whirlwind/common/namespace.hpp>
 
+#include "grid_edge_numbering.hpp"
+
 WHIRLWIND_NAMESPACE_BEGIN
 
+namespace detail {
+
+// A grid dimension. Only stored if it isn't fixed at compile time (i.e. `Extent` is
+// `std::dynamic_extent`), in which case it's zero by default.
+template<class Dim, std::size_t Extent>
+class GridExtent {
+public:
+    constexpr GridExtent() = default;
+    explicit constexpr GridExtent(Dim /* value */) noexcept {}
+
+    [[nodiscard]] static constexpr auto
+    value() noexcept -> Dim
+    {
+        return static_cast<Dim>(Extent);
+    }
+};
+
+template<class Dim>
+class GridExtent<Dim, std::dynamic_extent> {
+public:
+    constexpr GridExtent() = default;
+    explicit constexpr GridExtent(Dim value) noexcept : value_(value) {}
+
+    [[nodiscard]] constexpr auto
+    value() const noexcept -> Dim
+    {
+        return value_;
+    }
+
+private:
+    Dim value_ = {};
+};
+
+// Stands in for the edge numbering of a grid whose dimensions are fixed at compile
+// time, which is computed rather than stored.
+struct FixedGridEdgeNumbering {};
+
+} // namespace detail
+
 /**
  * A 2-dimensional rectangular grid graph.
  *
@@ -28,20 +70,39 @@ WHIRLWIND_NAMESPACE_BEGIN
  *     The number of parallel edges between adjacent vertices.
  * @tparam Dim
  *     The type used to represent row and column indices of vertices in the graph.
+ * @tparam Index
+ *     The unsigned integer type used to represent edges in the graph. A 32-bit type
+ *     may be used for graphs with fewer than 2^32 edges.
+ * @tparam Rows
+ *     The number of rows of vertices, if fixed at compile time, or
+ *     `std::dynamic_extent` if it is specified at runtime.
+ * @tparam Cols
+ *     The number of columns of vertices, if fixed at compile time, or
+ *     `std::dynamic_extent` if it is specified at runtime.
  */
-template<std::size_t P = 1, class Dim = std::size_t>
+template<std::size_t P = 1,
+         class Dim = std::size_t,
+         class Index = std::size_t,
+         std::size_t Rows = std::dynamic_extent,
+         std::size_t Cols = std::dynamic_extent>
 class RectangularGridGraph {
     WHIRLWIND_STATIC_ASSERT(std::is_integral_v<Dim>);
+    WHIRLWIND_STATIC_ASSERT(std::is_unsigned_v<Index>);
+    WHIRLWIND_STATIC_ASSERT((Rows == std::dynamic_extent) ||
+                            (Rows <= std::numeric_limits<Dim>::max()));
+    WHIRLWIND_STATIC_ASSERT((Cols == std::dynamic_extent) ||
+                            (Cols <= std::numeric_limits<Dim>::max()));
 
 public:
     using dim_type = Dim;
     using vertex_type = std::pair<dim_type, dim_type>;
-    using edge_type = std::size_t;
+    using edge_type = Index;
     using size_type = std::size_t;
 
     /**
      * Default constructor. Creates an empty `RectangularGridGraph` with no vertices or
-     * edges.
+     * edges. If the grid dimensions are fixed at compile time, the graph instead has
+     * `Rows` x `Cols` vertices.
      */
     constexpr RectangularGridGraph() = default;
 
@@ -49,17 +110,29 @@ public:
      * Create a new `RectangularGridGraph`.
      *
      * @param[in] num_rows
-     *     The number of rows in the 2-D array of vertices.
+     *     The number of rows in the 2-D array of vertices. Must be equal to `Rows` if
+     *     the number of rows is fixed at compile time.
      * @param[in] num_cols
-     *     The number of columns in the 2-D array of vertices.
+     *     The number of columns in the 2-D array of vertices. Must be equal to `Cols`
+     *     if the number of columns is fixed at compile time.
      */
     constexpr RectangularGridGraph(dim_type num_rows, dim_type num_cols) noexcept
-        : num_rows_(num_rows), num_cols_(num_cols), edge_offsets_{make_edge_offsets()}
+        : num_rows_(num_rows),
+          num_cols_(num_cols),
+          edge_numbering_(make_edge_numbering(static_cast<size_type>(num_rows),
+                                              static_cast<size_type>(num_cols)))
     {
         if constexpr (!std::is_unsigned_v<dim_type>) {
             WHIRLWIND_ASSERT(num_rows >= 0);
             WHIRLWIND_ASSERT(num_cols >= 0);
         }
+        if constexpr (Rows != std::dynamic_extent) {
+            WHIRLWIND_ASSERT(static_cast<size_type>(num_rows) == Rows);
+        }
+        if constexpr (Cols != std::dynamic_extent) {
+            WHIRLWIND_ASSERT(static_cast<size_type>(num_cols) == Cols);
+        }
+        WHIRLWIND_ASSERT(num_edges() <= std::numeric_limits<edge_type>::max());
     }
 
     /** The number of parallel edges between adjacent vertices. */
@@ -69,18 +142,31 @@ public:
         return P;
     }
 
+    /**
+     * Check whether the grid dimensions are fixed at compile time.
+     *
+     * If so, the number of vertices & edges, the edge offsets of each direction, and
+     * the boundary checks in `outgoing_edges()` and `get_*_edge()` are all folded into
+     * constants, and the graph has no data members.
+     */
+    [[nodiscard]] static WHIRLWIND_CONSTEVAL auto
+    has_fixed_size() noexcept -> bool
+    {
+        return (Rows != std::dynamic_extent) && (Cols != std::dynamic_extent);
+    }
+
     /** The number of rows of vertices in the graph. */
     [[nodiscard]] constexpr auto
     num_rows() const noexcept -> dim_type
     {
-        return num_rows_;
+        return num_rows_.value();
     }
 
     /** The number of columns of vertices in the graph. */
     [[nodiscard]] constexpr auto
     num_cols() const noexcept -> dim_type
     {
-        return num_cols_;
+        return num_cols_.value();
     }
 
     /** The total number of vertices in the graph. */
@@ -94,17 +180,17 @@ public:
     [[nodiscard]] constexpr auto
     num_edges() const noexcept -> size_type
     {
-        const auto m = static_cast<size_type>(num_rows());
-        const auto n = static_cast<size_type>(num_cols());
-
-        if ((m == 0) || (n == 0)) WHIRLWIND_UNLIKELY {
-            return 0;
+        if constexpr (has_fixed_size()) {
+            constexpr auto num_fixed_edges =
+                    edge_numbering_type::count_edges(Rows, Cols);
+            WHIRLWIND_STATIC_ASSERT(num_fixed_edges <=
+                                    std::numeric_limits<edge_type>::max());
+            return num_fixed_edges;
+        } else {
+            const auto m = static_cast<size_type>(num_rows());
+            const auto n = static_cast<size_type>(num_cols());
+            return edge_numbering_type::count_edges(m, n);
         }
-
-        const auto num_ud_edges = (m - 1) * n;
-        const auto num_lr_edges = m * (n - 1);
-
-        return 2 * num_parallel_edges() * (num_ud_edges + num_lr_edges);
     }
 
     /**
@@ -174,7 +260,8 @@ public:
     [[nodiscard]] constexpr auto
     edges() const
     {
-        return ranges::views::iota(edge_type{0}, num_edges());
+        const auto m = static_cast<edge_type>(num_edges());
+        return ranges::views::iota(edge_type{0}, m);
     }
 
     /** Check whether the graph contains the specified vertex. */
@@ -238,14 +325,9 @@ public:
     get_up_edge(const vertex_type& vertex) const -> edge_type
     {
         WHIRLWIND_ASSERT(contains_vertex(vertex));
-        const auto i = edge_type{vertex.first};
-        const auto j = edge_type{vertex.second};
-        const auto n = edge_type{num_cols()};
-        WHIRLWIND_ASSERT(i != 0);
-        WHIRLWIND_DEBUG_ASSERT(num_rows() >= 2);
-        WHIRLWIND_DEBUG_ASSERT(num_cols() >= 1);
-        const auto e = (i - 1) * n + j;
-        return first_up_edge() + num_parallel_edges() * e;
+        WHIRLWIND_ASSERT(vertex.first != 0);
+        const auto n = static_cast<size_type>(num_cols());
+        return edge_numbering().up_edge(get_vertex_id(vertex), n);
     }
 
     /**
@@ -266,14 +348,9 @@ public:
     get_left_edge(const vertex_type& vertex) const -> edge_type
     {
         WHIRLWIND_ASSERT(contains_vertex(vertex));
-        const auto i = edge_type{vertex.first};
-        const auto j = edge_type{vertex.second};
-        const auto n = edge_type{num_cols()};
-        WHIRLWIND_ASSERT(j != 0);
-        WHIRLWIND_DEBUG_ASSERT(num_rows() >= 1);
-        WHIRLWIND_DEBUG_ASSERT(num_cols() >= 2);
-        const auto e = i * (n - 1) + (j - 1);
-        return first_left_edge() + num_parallel_edges() * e;
+        WHIRLWIND_ASSERT(vertex.second != 0);
+        const auto i = static_cast<size_type>(vertex.first);
+        return edge_numbering().left_edge(get_vertex_id(vertex), i);
     }
 
     /**
@@ -294,14 +371,8 @@ public:
     get_down_edge(const vertex_type& vertex) const -> edge_type
     {
         WHIRLWIND_ASSERT(contains_vertex(vertex));
-        const auto i = edge_type{vertex.first};
-        const auto j = edge_type{vertex.second};
-        const auto n = edge_type{num_cols()};
-        WHIRLWIND_ASSERT(i + 1 != edge_type{num_rows()});
-        WHIRLWIND_DEBUG_ASSERT(num_rows() >= 2);
-        WHIRLWIND_DEBUG_ASSERT(num_cols() >= 1);
-        const auto e = i * n + j;
-        return first_down_edge() + num_parallel_edges() * e;
+        WHIRLWIND_ASSERT(vertex.first + 1 != num_rows());
+        return edge_numbering().down_edge(get_vertex_id(vertex));
     }
 
     /**
@@ -322,14 +393,9 @@ public:
     get_right_edge(const vertex_type& vertex) const -> edge_type
     {
         WHIRLWIND_ASSERT(contains_vertex(vertex));
-        const auto i = edge_type{vertex.first};
-        const auto j = edge_type{vertex.second};
-        const auto n = edge_type{num_cols()};
-        WHIRLWIND_ASSERT(j + 1 != n);
-        WHIRLWIND_DEBUG_ASSERT(num_rows() >= 1);
-        WHIRLWIND_DEBUG_ASSERT(num_cols() >= 2);
-        const auto e = i * (n - 1) + j;
-        return first_right_edge() + num_parallel_edges() * e;
+        WHIRLWIND_ASSERT(vertex.second + 1 != num_cols());
+        const auto i = static_cast<size_type>(vertex.first);
+        return edge_numbering().right_edge(get_vertex_id(vertex), i);
     }
 
     /**
@@ -446,58 +512,129 @@ public:
         }
     }
 
-protected:
-    [[nodiscard]] constexpr auto
-    make_edge_offsets() const noexcept
+    /**
+     * Invoke a function on each outgoing edge (and corresponding head vertex) of a
+     * vertex.
+     *
+     * Visits the same (edge,head) pairs as `outgoing_edges()`, in the same order, but
+     * without suspending a coroutine between edges. This avoids allocating a coroutine
+     * frame for each call and is preferred in performance-critical inner loops.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     * @param[in] visitor
+     *     A function invocable with arguments `(const edge_type&, const vertex_type&)`.
+     */
+    template<class Visitor>
+    constexpr void
+    for_each_outgoing_edge(const vertex_type& vertex, Visitor visitor) const
     {
-        const auto m = edge_type{num_rows()};
-        const auto n = edge_type{num_cols()};
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
 
-        if ((m == 0) || (n == 0)) WHIRLWIND_UNLIKELY {
-            return std::array<edge_type, 3>{0, 0, 0};
+        const auto i = vertex.first;
+        const auto j = vertex.second;
+
+        // up
+        if (i != 0) WHIRLWIND_LIKELY {
+            const auto head = vertex_type(i - 1, j);
+            WHIRLWIND_DEBUG_ASSERT(contains_vertex(head));
+            visit_parallel_edges(get_up_edge(vertex), head, visitor);
         }
 
-        const auto num_ud_edges = num_parallel_edges() * (m - 1) * n;
-        const auto num_lr_edges = num_parallel_edges() * m * (n - 1);
+        // left
+        if (j != 0) WHIRLWIND_LIKELY {
+            const auto head = vertex_type(i, j - 1);
+            WHIRLWIND_DEBUG_ASSERT(contains_vertex(head));
+            visit_parallel_edges(get_left_edge(vertex), head, visitor);
+        }
 
-        auto off0 = num_ud_edges;
-        auto off1 = off0 + num_lr_edges;
-        auto off2 = off1 + num_ud_edges;
+        // down
+        if (i + 1 != num_rows()) WHIRLWIND_LIKELY {
+            const auto head = vertex_type(i + 1, j);
+            WHIRLWIND_DEBUG_ASSERT(contains_vertex(head));
+            visit_parallel_edges(get_down_edge(vertex), head, visitor);
+        }
 
-        return std::array{off0, off1, off2};
+        // right
+        if (j + 1 != num_cols()) WHIRLWIND_LIKELY {
+            const auto head = vertex_type(i, j + 1);
+            WHIRLWIND_DEBUG_ASSERT(contains_vertex(head));
+            visit_parallel_edges(get_right_edge(vertex), head, visitor);
+        }
     }
 
-    [[nodiscard]] constexpr auto
-    first_up_edge() const noexcept -> edge_type
+protected:
+    template<class Visitor>
+    constexpr void
+    visit_parallel_edges(edge_type first_edge,
+                         const vertex_type& head,
+                         Visitor& visitor) const
     {
-        return edge_type{0};
+        // The number of parallel edges is a compile-time constant, so this loop is
+        // expected to be fully unrolled.
+        for (size_type p = 0; p != num_parallel_edges(); ++p) {
+            const auto edge = static_cast<edge_type>(first_edge + p);
+            WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
+            visitor(edge, head);
+        }
     }
 
-    [[nodiscard]] constexpr auto
-    first_left_edge() const noexcept -> edge_type
-    {
-        WHIRLWIND_DEBUG_ASSERT(std::size(edge_offsets_) > 0);
-        return edge_offsets_[0];
-    }
+    using edge_numbering_type = detail::GridEdgeNumbering<P, edge_type>;
 
     [[nodiscard]] constexpr auto
-    first_down_edge() const noexcept -> edge_type
+    edge_numbering() const noexcept -> edge_numbering_type
     {
-        WHIRLWIND_DEBUG_ASSERT(std::size(edge_offsets_) > 1);
-        return edge_offsets_[1];
+        if constexpr (has_fixed_size()) {
+            constexpr auto fixed_edge_numbering = edge_numbering_type(Rows, Cols);
+            return fixed_edge_numbering;
+        } else {
+            return edge_numbering_;
+        }
     }
 
-    [[nodiscard]] constexpr auto
-    first_right_edge() const noexcept -> edge_type
+private:
+    // The edge numbering is only stored if the grid dimensions aren't fixed at compile
+    // time. A fixed-size graph has no data members.
+    using edge_numbering_storage =
+            std::conditional_t<(Rows != std::dynamic_extent) &&
+                                       (Cols != std::dynamic_extent),
+                               detail::FixedGridEdgeNumbering,
+                               edge_numbering_type>;
+
+    [[nodiscard]] static constexpr auto
+    make_edge_numbering(size_type m, size_type n) noexcept -> edge_numbering_storage
     {
-        WHIRLWIND_DEBUG_ASSERT(std::size(edge_offsets_) > 2);
-        return edge_offsets_[2];
+        if constexpr (has_fixed_size()) {
+            return {};
+        } else {
+            return edge_numbering_type(m, n);
+        }
     }
 
-private:
-    dim_type num_rows_ = {};
-    dim_type num_cols_ = {};
-    std::array<edge_type, 3> edge_offsets_ = {};
+    WHIRLWIND_NO_UNIQUE_ADDRESS detail::GridExtent<dim_type, Rows> num_rows_;
+    WHIRLWIND_NO_UNIQUE_ADDRESS detail::GridExtent<dim_type, Cols> num_cols_;
+    WHIRLWIND_NO_UNIQUE_ADDRESS edge_numbering_storage edge_numbering_;
 };
 
+/**
+ * A 2-dimensional rectangular grid graph whose dimensions are fixed at compile time.
+ *
+ * @tparam Rows
+ *     The number of rows of vertices.
+ * @tparam Cols
+ *     The number of columns of vertices.
+ * @tparam P
+ *     The number of parallel edges between adjacent vertices.
+ * @tparam Dim
+ *     The type used to represent row and column indices of vertices in the graph.
+ * @tparam Index
+ *     The unsigned integer type used to represent edges in the graph.
+ */
+template<std::size_t Rows,
+         std::size_t Cols,
+         std::size_t P = 1,
+         class Dim = std::size_t,
+         class Index = std::size_t>
+using FixedRectangularGridGraph = RectangularGridGraph<P, Dim, Index, Rows, Cols>;
+
 WHIRLWIND_NAMESPACE_END
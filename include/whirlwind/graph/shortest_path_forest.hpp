@@ -1,9 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <utility>
 
-#include <range/v3/algorithm/fill.hpp>
 #include <range/v3/view/filter.hpp>
 
 #include <whirlwind/common/assert.hpp>
@@ -17,6 +17,27 @@
 
 WHIRLWIND_NAMESPACE_BEGIN
 
+/**
+ * A forest of shortest paths in a graph.
+ *
+ * Extends a mutable forest with a per-vertex label ("unreached", "reached", or
+ * "visited") and distance from the root of its tree.
+ *
+ * The forest keeps a list of the vertices whose label or distance has been modified
+ * since it was created or last reset. Resetting the forest and enumerating the reached
+ * or visited vertices costs time proportional to the number of such vertices rather
+ * than the size of the graph.
+ *
+ * @tparam Distance
+ *     The distance type.
+ * @tparam Graph
+ *     The graph type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the internal arrays of labels
+ *     and distances and the list of modified vertices.
+ * @tparam Base
+ *     The base forest type.
+ */
 template<class Distance,
          GraphType Graph,
          template<class> class Container = Vector,
@@ -26,7 +47,11 @@ private:
     using base_type = Base;
 
 protected:
+    // Vertices are initially "untouched". An "untouched" vertex is equivalent to an
+    // "unreached" vertex, except that it has not yet been added to the list of
+    // modified vertices.
     enum struct label_type : std::uint8_t {
+        untouched,
         unreached,
         reached,
         visited,
@@ -45,7 +70,7 @@ public:
 
     explicit constexpr ShortestPathForest(const graph_type& g)
         : base_type(g),
-          label_(g.num_vertices(), label_type::unreached),
+          label_(g.num_vertices(), label_type::untouched),
           distance_(g.num_vertices(), infinity<distance_type>())
     {
         WHIRLWIND_DEBUG_ASSERT(std::size(label_) == g.num_vertices());
@@ -58,7 +83,7 @@ public:
         WHIRLWIND_ASSERT(graph().contains_vertex(vertex));
         const auto vertex_id = graph().get_vertex_id(vertex);
         WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(label_));
-        return label_[vertex_id] != label_type::unreached;
+        return label_[vertex_id] >= label_type::reached;
     }
 
     [[nodiscard]] constexpr auto
@@ -86,6 +111,7 @@ public:
         WHIRLWIND_ASSERT(!has_visited_vertex(vertex));
         const auto vertex_id = graph().get_vertex_id(vertex);
         WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(label_));
+        touch_vertex(vertex, vertex_id);
         label_[vertex_id] = label_type::reached;
     }
 
@@ -105,21 +131,32 @@ public:
         WHIRLWIND_ASSERT(!has_visited_vertex(vertex));
         const auto vertex_id = graph().get_vertex_id(vertex);
         WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(label_));
+        touch_vertex(vertex, vertex_id);
         label_[vertex_id] = label_type::visited;
     }
 
+    /**
+     * Iterate over the vertices that were reached (or visited).
+     *
+     * Vertices are yielded in the order in which they were first modified.
+     */
     [[nodiscard]] constexpr auto
     reached_vertices() const
     {
-        return ranges::views::filter(graph().vertices(), [&](const auto& vertex) {
+        return ranges::views::filter(touched_vertices_, [&](const auto& vertex) {
             return has_reached_vertex(vertex);
         });
     }
 
+    /**
+     * Iterate over the vertices that were visited.
+     *
+     * Vertices are yielded in the order in which they were first modified.
+     */
     [[nodiscard]] constexpr auto
     visited_vertices() const
     {
-        return ranges::views::filter(graph().vertices(), [&](const auto& vertex) {
+        return ranges::views::filter(touched_vertices_, [&](const auto& vertex) {
             return has_visited_vertex(vertex);
         });
     }
@@ -139,20 +176,47 @@ public:
         WHIRLWIND_ASSERT(graph().contains_vertex(vertex));
         const auto vertex_id = graph().get_vertex_id(vertex);
         WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(distance_));
+        touch_vertex(vertex, vertex_id);
         distance_[vertex_id] = std::move(distance);
     }
 
+    /**
+     * Reset the forest to its initial state.
+     *
+     * Each vertex is labeled "unreached" and its distance is set to infinity. Only the
+     * vertices that were modified since the forest was created or last reset are
+     * updated.
+     */
     constexpr void
     reset()
     {
         base_type::reset();
-        ranges::fill(label_, label_type::unreached);
-        ranges::fill(distance_, infinity<distance_type>());
+        for (const auto& vertex : touched_vertices_) {
+            const auto vertex_id = graph().get_vertex_id(vertex);
+            WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(label_));
+            WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(distance_));
+            label_[vertex_id] = label_type::untouched;
+            distance_[vertex_id] = infinity<distance_type>();
+        }
+        touched_vertices_.clear();
+    }
+
+protected:
+    // Add a vertex to the list of modified vertices if it is not already in the list.
+    constexpr void
+    touch_vertex(const vertex_type& vertex, std::size_t vertex_id)
+    {
+        WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(label_));
+        if (label_[vertex_id] == label_type::untouched) {
+            label_[vertex_id] = label_type::unreached;
+            touched_vertices_.push_back(vertex);
+        }
     }
 
 private:
     container_type<label_type> label_;
     container_type<distance_type> distance_;
+    container_type<vertex_type> touched_vertices_ = {};
 };
 
 WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/logging/null_logger.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+#include "successive_shortest_paths.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+// Find the shortest path w.r.t the reduced arc costs from the source to the nearest
+// deficit node using the A* algorithm.
+//
+// Like `dijkstra_ssp`, but nodes are visited in order of their distance from the source
+// plus the heuristic value of the node (a lower bound on its distance to the nearest
+// deficit node), so the search is directed toward the deficit nodes. This is
+// equivalent to Dijkstra's algorithm w.r.t the reduced arc costs that result from
+// adding the heuristic to the node potentials. The heuristic must be consistent: the
+// length of each arc w.r.t these adjusted reduced costs must be nonnegative.
+//
+// The distance of each node stored in `dijkstra` is its distance w.r.t the adjusted
+// reduced costs. Passing `dijkstra` to `update_potential_ssp` therefore updates the
+// node potentials *relative to the heuristic*: the adjusted reduced costs remain
+// nonnegative, but the (unadjusted) reduced costs may not until the heuristic has been
+// added to the potential of each node. The same heuristic must be used for each search
+// until then.
+template<class Dijkstra, class Network, class Heuristic>
+constexpr auto
+astar_ssp(Dijkstra& dijkstra,
+          const Network& network,
+          const typename Network::node_type& source,
+          Heuristic& heuristic) -> std::optional<typename Network::node_type>
+{
+    using Distance = typename Dijkstra::distance_type;
+    WHIRLWIND_STATIC_ASSERT(std::is_same_v<Distance, typename Network::cost_type>);
+
+    WHIRLWIND_ASSERT(network.contains_node(source));
+    WHIRLWIND_ASSERT(std::addressof(dijkstra.graph()) ==
+                     std::addressof(network.residual_graph()));
+
+    dijkstra.reset();
+    WHIRLWIND_DEBUG_ASSERT(dijkstra.done());
+
+    dijkstra.add_source(source);
+    WHIRLWIND_DEBUG_ASSERT(!dijkstra.done());
+
+    while (!dijkstra.done()) {
+        const auto top = dijkstra.pop_next_unvisited_vertex();
+        using std::get;
+        const auto& tail = get<0>(top);
+        const auto& distance = get<1>(top);
+        WHIRLWIND_DEBUG_ASSERT(network.contains_node(tail));
+        WHIRLWIND_DEBUG_ASSERT(distance >= zero<Distance>());
+
+        dijkstra.visit_vertex(tail, distance);
+        WHIRLWIND_DEBUG_ASSERT(dijkstra.has_visited_vertex(tail));
+
+        if (network.is_deficit_node(tail)) {
+            return tail;
+        }
+
+        const auto tail_heuristic = heuristic(tail);
+        WHIRLWIND_DEBUG_ASSERT(tail_heuristic >= zero<Distance>());
+
+        network.for_each_unsaturated_outgoing_arc(
+                tail, [&](const auto& arc, const auto& head) {
+                    WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
+                    WHIRLWIND_DEBUG_ASSERT(network.contains_node(head));
+
+                    // Skip the (relatively costly) heuristic evaluation for visited
+                    // nodes.
+                    if (dijkstra.has_visited_vertex(head)) {
+                        return;
+                    }
+
+                    const auto arc_length = network.arc_reduced_cost(arc, tail, head) +
+                                            heuristic(head) - tail_heuristic;
+                    WHIRLWIND_ASSERT(arc_length >= zero<Distance>());
+
+                    dijkstra.relax_edge(arc, tail, head, distance + arc_length);
+                    WHIRLWIND_DEBUG_ASSERT(dijkstra.has_reached_vertex(head));
+                });
+    }
+
+    return std::nullopt;
+}
+
+/**
+ * Solve a minimum cost flow problem using a goal-directed variant of the successive
+ * shortest paths algorithm.
+ *
+ * Each augmenting path is found by an A* search that is guided toward the deficit
+ * nodes by a heuristic lower bound on the distance from each node to the nearest
+ * deficit node (e.g. `GridDistanceHeuristic`). The resulting flow is optimal, like
+ * that of `successive_shortest_paths()`. Searches visit fewer nodes when the deficit
+ * nodes are sparse and the heuristic is tight (e.g. when the minimum arc cost is large
+ * relative to the average); a heuristic that is identically zero reduces to plain
+ * successive shortest paths.
+ *
+ * The heuristic is treated as a component of the node potentials throughout the solve
+ * and is added to the potential of each node at the end, so it's only required to be
+ * consistent w.r.t the reduced arc costs of the initial network state. (In
+ * particular, it needn't be updated as deficit nodes are exhausted.)
+ *
+ * @tparam Dijkstra
+ *     The shortest path solver type.
+ * @tparam Logger
+ *     The logger type.
+ *
+ * @param[in,out] network
+ *     The network. Must be balanced.
+ * @param[in] heuristic
+ *     A function invocable with argument `(const node_type&)` that returns a
+ *     nonnegative lower bound on the reduced cost of any path from the node to a
+ *     deficit node. For each unsaturated arc from `tail` to `head`, the sum of the
+ *     arc's reduced cost and `heuristic(head)` must be no less than `heuristic(tail)`.
+ */
+template<class Dijkstra, class Logger = NullLogger, class Network, class Heuristic>
+constexpr void
+astar_successive_shortest_paths(Network& network, Heuristic&& heuristic)
+{
+    auto logger = Logger("whirlwind.network.astar_successive_shortest_paths");
+
+    WHIRLWIND_ASSERT(network.is_balanced());
+
+    auto dijkstra = Dijkstra(network);
+    WHIRLWIND_DEBUG_ASSERT(dijkstra.done());
+    WHIRLWIND_DEBUG_ASSERT(std::addressof(dijkstra.graph()) ==
+                           std::addressof(network.residual_graph()));
+
+    const auto num_iter = network.total_excess();
+    using Iter = std::remove_const_t<decltype(num_iter)>;
+    Iter iter = 1;
+    for (const auto& source : network.excess_nodes()) {
+        // Each iteration routes a single unit of flow from the source.
+        while (network.is_excess_node(source)) {
+            if (iter % 100 == 0) {
+                logger.info("Iteration {:>8}/{}", iter, num_iter);
+            }
+
+            const auto sink = astar_ssp(dijkstra, network, source, heuristic);
+            WHIRLWIND_ASSERT(sink);
+
+            augment_flow_ssp(network, dijkstra, *sink);
+            update_potential_ssp(network, dijkstra, *sink);
+
+            ++iter;
+        }
+    }
+
+    WHIRLWIND_ASSERT(network.total_excess() == 0);
+
+    // Fold the heuristic into the node potentials so that the (unadjusted) reduced
+    // cost of each unsaturated arc is nonnegative.
+    for (const auto& node : network.nodes()) {
+        network.increase_node_potential(node, heuristic(node));
+    }
+}
+
+WHIRLWIND_NAMESPACE_END
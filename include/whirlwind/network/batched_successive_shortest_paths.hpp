@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <range/v3/algorithm/remove_if.hpp>
+#include <range/v3/range/conversion.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/logging/null_logger.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+#include "successive_shortest_paths.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+// Check whether flow may be augmented along the path in the shortest path forest from
+// the root of the sink's tree to the sink -- that is, each arc along the path is
+// unsaturated and the root is an excess node.
+//
+// Paths to different sinks in the same tree share a prefix, so once flow has been
+// augmented along one of them, the others may no longer be feasible.
+template<class Network, class Dijkstra>
+[[nodiscard]] constexpr auto
+is_augmenting_path_bssp(const Network& network,
+                        const Dijkstra& dijkstra,
+                        const typename Network::node_type& sink) -> bool
+{
+    WHIRLWIND_ASSERT(network.contains_node(sink));
+    WHIRLWIND_ASSERT(dijkstra.has_visited_vertex(sink));
+    WHIRLWIND_ASSERT(std::addressof(network.residual_graph()) ==
+                     std::addressof(dijkstra.graph()));
+
+    auto root = sink;
+    for (const auto& [tail, arc] : dijkstra.predecessors(sink)) {
+        WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
+        if (network.is_arc_saturated(arc)) {
+            return false;
+        }
+        root = tail;
+    }
+
+    return network.is_excess_node(root);
+}
+
+// Find the shortest paths w.r.t the reduced arc costs from any of the specified excess
+// nodes to each deficit node using Dijkstra's algorithm. Unlike `dijkstra_ssp`, the
+// search continues after the first deficit node is found: one unit of flow is
+// augmented along the path to each visited deficit node, provided that the path is
+// still feasible, until either `max_paths` units have been augmented (if nonzero), the
+// excess of each source has been exhausted, or all reachable nodes have been visited.
+//
+// Flow is augmented as soon as each deficit node is visited. This doesn't affect the
+// remainder of the search since the only arcs whose residual capacity is modified
+// connect pairs of nodes that were already visited (and arcs to visited nodes are
+// never relaxed).
+//
+// Returns the last visited node (the visited node with the greatest distance) and the
+// number of augmenting paths.
+template<class Dijkstra, class Network, class Sources>
+constexpr auto
+dijkstra_bssp(Dijkstra& dijkstra,
+              Network& network,
+              const Sources& sources,
+              std::size_t max_paths = 0)
+        -> std::pair<typename Network::node_type, std::size_t>
+{
+    using Distance = typename Dijkstra::distance_type;
+    WHIRLWIND_STATIC_ASSERT(std::is_same_v<Distance, typename Network::cost_type>);
+
+    WHIRLWIND_ASSERT(!std::empty(sources));
+    WHIRLWIND_ASSERT(std::addressof(dijkstra.graph()) ==
+                     std::addressof(network.residual_graph()));
+
+    dijkstra.reset();
+    WHIRLWIND_DEBUG_ASSERT(dijkstra.done());
+
+    // Add each source to the search and get the total excess among all sources.
+    using Flow = typename Network::flow_type;
+    auto remaining_excess = zero<Flow>();
+    for (const auto& source : sources) {
+        WHIRLWIND_ASSERT(network.is_excess_node(source));
+        dijkstra.add_source(source);
+        WHIRLWIND_DEBUG_ASSERT(dijkstra.has_reached_vertex(source));
+        WHIRLWIND_DEBUG_ASSERT(dijkstra.distance_to_vertex(source) == zero<Distance>());
+        remaining_excess += network.node_excess(source);
+    }
+
+    auto last_visited = *std::begin(sources);
+    std::size_t num_paths = 0;
+
+    while (!dijkstra.done()) {
+        const auto top = dijkstra.pop_next_unvisited_vertex();
+        using std::get;
+        const auto& tail = get<0>(top);
+        const auto& distance = get<1>(top);
+        WHIRLWIND_DEBUG_ASSERT(network.contains_node(tail));
+        WHIRLWIND_DEBUG_ASSERT(distance >= zero<Distance>());
+
+        dijkstra.visit_vertex(tail, distance);
+        WHIRLWIND_DEBUG_ASSERT(dijkstra.has_visited_vertex(tail));
+        WHIRLWIND_DEBUG_ASSERT(dijkstra.distance_to_vertex(tail) == distance);
+        last_visited = tail;
+
+        if (network.is_deficit_node(tail) &&
+            is_augmenting_path_bssp(network, dijkstra, tail)) {
+            augment_flow_ssp(network, dijkstra, tail);
+            ++num_paths;
+            --remaining_excess;
+
+            if ((remaining_excess == zero<Flow>()) || (num_paths == max_paths)) {
+                break;
+            }
+        }
+
+        network.for_each_unsaturated_outgoing_arc(
+                tail, [&](const auto& arc, const auto& head) {
+                    WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
+                    WHIRLWIND_DEBUG_ASSERT(network.contains_node(head));
+
+                    // Skip arcs to previously visited nodes. If flow was just augmented
+                    // along a path to `tail`, the reverse of its predecessor arc is no
+                    // longer saturated and may have negative reduced cost.
+                    if (dijkstra.has_visited_vertex(head)) {
+                        return;
+                    }
+
+                    const auto arc_length = network.arc_reduced_cost(arc, tail, head);
+                    WHIRLWIND_ASSERT(arc_length >= zero<Distance>());
+
+                    dijkstra.relax_edge(arc, tail, head, distance + arc_length);
+                    WHIRLWIND_DEBUG_ASSERT(dijkstra.has_reached_vertex(head));
+                });
+    }
+
+    return {std::move(last_visited), num_paths};
+}
+
+/**
+ * Solve a minimum cost flow problem using a batched variant of the successive shortest
+ * paths algorithm.
+ *
+ * Each iteration runs a single multi-source Dijkstra search from all remaining excess
+ * nodes and augments flow along multiple shortest paths (one per deficit node visited)
+ * before updating the node potentials once per batch. The paths need not be disjoint:
+ * paths within the same shortest path tree may share arcs, and flow is augmented along
+ * each one only if every arc along it still has residual capacity. The resulting flow
+ * is optimal, like that of `successive_shortest_paths()`, but typically requires far
+ * fewer shortest path searches.
+ *
+ * @tparam Dijkstra
+ *     The shortest path solver type.
+ * @tparam Logger
+ *     The logger type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the list of excess nodes.
+ *
+ * @param[in,out] network
+ *     The network. Must be balanced.
+ * @param[in] max_paths_per_batch
+ *     The maximum number of augmenting paths per search. If zero, the number of paths
+ *     per search is unlimited.
+ */
+template<class Dijkstra,
+         class Logger = NullLogger,
+         template<class> class Container = Vector,
+         class Network>
+constexpr void
+batched_successive_shortest_paths(Network& network, std::size_t max_paths_per_batch = 0)
+{
+    auto logger = Logger("whirlwind.network.batched_successive_shortest_paths");
+
+    WHIRLWIND_ASSERT(network.is_balanced());
+
+    auto dijkstra = Dijkstra(network);
+    WHIRLWIND_DEBUG_ASSERT(dijkstra.done());
+    WHIRLWIND_DEBUG_ASSERT(std::addressof(dijkstra.graph()) ==
+                           std::addressof(network.residual_graph()));
+
+    using Node = typename Network::node_type;
+    auto sources = network.excess_nodes() | ranges::to<Container<Node>>();
+
+    std::size_t iter = 1;
+    while (!std::empty(sources)) {
+        logger.info("Iteration {} ({} excess nodes)", iter, std::size(sources));
+
+        const auto [last_visited, num_paths] =
+                dijkstra_bssp(dijkstra, network, sources, max_paths_per_batch);
+        WHIRLWIND_ASSERT(num_paths > 0);
+
+        update_potential_ssp(network, dijkstra, last_visited);
+
+        // Remove any sources whose excess was exhausted.
+        auto it = ranges::remove_if(sources, [&](const auto& source) {
+            return !network.is_excess_node(source);
+        });
+        sources.erase(it, std::end(sources));
+
+        ++iter;
+    }
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,400 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <range/v3/algorithm/remove_if.hpp>
+#include <range/v3/range/conversion.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/pair_like.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/dijkstra_concepts.hpp>
+#include <whirlwind/logging/null_logger.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A shortest augmenting path found by a bidirectional search.
+ *
+ * The path consists of the path in the forward search tree from the source to `tail`,
+ * followed by the arc `arc` from `tail` to `head`, followed by the path in the backward
+ * search tree from `head` to a deficit node.
+ */
+template<class Node, class Arc, class Cost>
+struct BidirectionalAugmentingPath {
+    Node tail;
+    Arc arc;
+    Node head;
+
+    /** The length of the path w.r.t the reduced arc costs. */
+    Cost length;
+
+    /**
+     * The smaller of `length` and the distance of the nearest unvisited node in the
+     * forward search when the search stopped.
+     */
+    Cost forward_radius;
+};
+
+namespace detail {
+
+// A Dijkstra solver whose unvisited vertices are stored in a min-heap ordered by
+// distance, such that the top of the heap is the nearest unvisited vertex (once stale
+// entries have been discarded by `done()`). The stopping criterion of the bidirectional
+// search depends on the distance of the nearest unvisited vertex in each direction,
+// which is not directly available from bucket-based or label-correcting solvers such
+// as `Dial` or `DeltaStepping`.
+template<class Dijkstra>
+concept HeapDijkstraSolverType =
+        DijkstraSolverType<Dijkstra> && requires(Dijkstra& dijkstra) {
+            requires PairLike<std::remove_cvref_t<decltype(dijkstra.heap().top())>,
+                              typename Dijkstra::vertex_type,
+                              typename Dijkstra::distance_type>;
+        };
+
+} // namespace detail
+
+// Find the shortest path w.r.t the reduced arc costs from the source to any of the
+// specified deficit nodes using bidirectional Dijkstra's algorithm.
+//
+// The forward search grows a shortest path tree from the source along outgoing arcs,
+// while the backward search grows a shortest path tree from all sinks along incoming
+// arcs. (In the backward tree, the predecessor of each node is the next node along its
+// shortest path to a sink, and the predecessor arc points from the node to it.) Each
+// step advances whichever search has visited fewer nodes so far. (Alternating by
+// distance instead would let the backward search, which grows from many sinks at once,
+// visit many more nodes than the forward search.) Whenever an arc joins a node reached
+// by one search to a node reached by the other, the length of the corresponding path is
+// compared against the shortest path found so far. The search stops once the sum of the
+// distances of the nearest unvisited nodes in each direction is at least the length of
+// the shortest path found (or either search is exhausted), at which point no shorter
+// path exists.
+//
+// Unlike `dijkstra_ssp`, which must visit every node that is closer to the source than
+// the nearest sink, neither search needs to cover the full distance between source and
+// sink.
+//
+// Returns the path, or nullopt if no sink is reachable from the source.
+template<detail::HeapDijkstraSolverType Dijkstra, class Network, class Sinks>
+constexpr auto
+bidirectional_dijkstra_ssp(Dijkstra& forward,
+                           Dijkstra& backward,
+                           const Network& network,
+                           const typename Network::node_type& source,
+                           const Sinks& sinks)
+        -> std::optional<BidirectionalAugmentingPath<typename Network::node_type,
+                                                     typename Network::arc_type,
+                                                     typename Network::cost_type>>
+{
+    using Distance = typename Dijkstra::distance_type;
+    WHIRLWIND_STATIC_ASSERT(std::is_same_v<Distance, typename Network::cost_type>);
+
+    WHIRLWIND_ASSERT(network.is_excess_node(source));
+    WHIRLWIND_ASSERT(std::addressof(forward.graph()) ==
+                     std::addressof(network.residual_graph()));
+    WHIRLWIND_ASSERT(std::addressof(backward.graph()) ==
+                     std::addressof(network.residual_graph()));
+
+    forward.reset();
+    backward.reset();
+    WHIRLWIND_DEBUG_ASSERT(forward.done());
+    WHIRLWIND_DEBUG_ASSERT(backward.done());
+
+    forward.add_source(source);
+    for (const auto& sink : sinks) {
+        WHIRLWIND_ASSERT(network.is_deficit_node(sink));
+        backward.add_source(sink);
+        WHIRLWIND_DEBUG_ASSERT(backward.distance_to_vertex(sink) == zero<Distance>());
+    }
+
+    using Path = BidirectionalAugmentingPath<typename Network::node_type,
+                                             typename Network::arc_type, Distance>;
+    auto path = std::optional<Path>();
+
+    const auto update_path = [&](const auto& tail, const auto& arc, const auto& head,
+                                 const Distance& length) {
+        if (!path || (length < path->length)) {
+            path = Path{tail, arc, head, length, length};
+        }
+    };
+
+    // Get the distance of the nearest unvisited node in the search (or infinity if
+    // there are none).
+    const auto next_distance = [](Dijkstra& dijkstra) -> Distance {
+        if (dijkstra.done()) {
+            return infinity<Distance>();
+        }
+        using std::get;
+        return get<1>(dijkstra.heap().top());
+    };
+
+    std::size_t num_forward_visited = 0;
+    std::size_t num_backward_visited = 0;
+
+    while (true) {
+        const auto forward_radius = next_distance(forward);
+        const auto backward_radius = next_distance(backward);
+
+        if ((forward_radius == infinity<Distance>()) ||
+            (backward_radius == infinity<Distance>()) ||
+            (path && (forward_radius + backward_radius >= path->length))) {
+            if (path) {
+                path->forward_radius = std::min(forward_radius, path->length);
+            }
+            return path;
+        }
+
+        if (num_forward_visited <= num_backward_visited) {
+            ++num_forward_visited;
+            const auto top = forward.pop_next_unvisited_vertex();
+            using std::get;
+            const auto& tail = get<0>(top);
+            const auto& distance = get<1>(top);
+            WHIRLWIND_DEBUG_ASSERT(network.contains_node(tail));
+            WHIRLWIND_DEBUG_ASSERT(distance >= zero<Distance>());
+
+            forward.visit_vertex(tail, distance);
+            WHIRLWIND_DEBUG_ASSERT(forward.has_visited_vertex(tail));
+
+            network.for_each_unsaturated_outgoing_arc(
+                    tail, [&](const auto& arc, const auto& head) {
+                        WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
+                        WHIRLWIND_DEBUG_ASSERT(network.contains_node(head));
+
+                        const auto arc_length =
+                                network.arc_reduced_cost(arc, tail, head);
+                        WHIRLWIND_ASSERT(arc_length >= zero<Distance>());
+
+                        forward.relax_edge(arc, tail, head, distance + arc_length);
+                        WHIRLWIND_DEBUG_ASSERT(forward.has_reached_vertex(head));
+
+                        if (backward.has_reached_vertex(head)) {
+                            const auto& remaining = backward.distance_to_vertex(head);
+                            update_path(tail, arc, head,
+                                        distance + arc_length + remaining);
+                        }
+                    });
+        } else {
+            ++num_backward_visited;
+            const auto top = backward.pop_next_unvisited_vertex();
+            using std::get;
+            const auto& head = get<0>(top);
+            const auto& distance = get<1>(top);
+            WHIRLWIND_DEBUG_ASSERT(network.contains_node(head));
+            WHIRLWIND_DEBUG_ASSERT(distance >= zero<Distance>());
+
+            backward.visit_vertex(head, distance);
+            WHIRLWIND_DEBUG_ASSERT(backward.has_visited_vertex(head));
+
+            network.for_each_incoming_arc(head, [&](const auto& arc, const auto& tail) {
+                WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
+                WHIRLWIND_DEBUG_ASSERT(network.contains_node(tail));
+
+                if (network.is_arc_saturated(arc)) {
+                    return;
+                }
+
+                const auto arc_length = network.arc_reduced_cost(arc, tail, head);
+                WHIRLWIND_ASSERT(arc_length >= zero<Distance>());
+
+                backward.relax_edge(arc, head, tail, distance + arc_length);
+                WHIRLWIND_DEBUG_ASSERT(backward.has_reached_vertex(tail));
+
+                if (forward.has_reached_vertex(tail)) {
+                    const auto& traveled = forward.distance_to_vertex(tail);
+                    update_path(tail, arc, head, traveled + arc_length + distance);
+                }
+            });
+        }
+    }
+}
+
+// Augment one unit of flow along a path found by `bidirectional_dijkstra_ssp`.
+//
+// Returns the sink (the deficit node at the end of the path).
+template<class Network, class Dijkstra, class Path>
+constexpr auto
+augment_flow_bidirectional_ssp(Network& network,
+                               const Dijkstra& forward,
+                               const Dijkstra& backward,
+                               const Path& path) -> typename Network::node_type
+{
+    using Flow = typename Network::flow_type;
+
+    WHIRLWIND_ASSERT(forward.has_reached_vertex(path.tail));
+    WHIRLWIND_ASSERT(backward.has_reached_vertex(path.head));
+    WHIRLWIND_ASSERT(std::addressof(network.residual_graph()) ==
+                     std::addressof(forward.graph()));
+    WHIRLWIND_ASSERT(std::addressof(network.residual_graph()) ==
+                     std::addressof(backward.graph()));
+
+    constexpr auto delta = one<Flow>();
+
+    WHIRLWIND_DEBUG_ASSERT(network.arc_residual_capacity(path.arc) >= delta);
+    network.increase_arc_flow(path.arc, delta);
+
+    // Walk the forward search tree from the tail of the joining arc to the source.
+    auto source = path.tail;
+    for (const auto& [tail, arc] : forward.predecessors(path.tail)) {
+        WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
+        WHIRLWIND_DEBUG_ASSERT(network.arc_residual_capacity(arc) >= delta);
+        network.increase_arc_flow(arc, delta);
+        source = tail;
+    }
+
+    // Walk the backward search tree from the head of the joining arc to the sink. Each
+    // predecessor arc points toward the sink.
+    auto sink = path.head;
+    for (const auto& [head, arc] : backward.predecessors(path.head)) {
+        WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
+        WHIRLWIND_DEBUG_ASSERT(network.arc_residual_capacity(arc) >= delta);
+        network.increase_arc_flow(arc, delta);
+        sink = head;
+    }
+
+    WHIRLWIND_ASSERT(network.is_excess_node(source));
+    network.decrease_node_excess(source, delta);
+
+    WHIRLWIND_ASSERT(network.is_deficit_node(sink));
+    network.increase_node_excess(sink, delta);
+
+    return sink;
+}
+
+// Update the node potentials after augmenting flow along a path found by
+// `bidirectional_dijkstra_ssp` so that the reduced cost of each unsaturated arc remains
+// nonnegative.
+//
+// Let L be the length of the path, r the forward radius of the search (the smaller of
+// L and the distance of the nearest unvisited node in the forward search), and
+// s = L - r. The potential of each node visited by the forward search at distance d < r
+// is increased by r - d, and the potential of each node visited by the backward search
+// at distance d < s from the sinks is decreased by s - d. Other nodes are unaffected.
+// This is equivalent to offsetting the potentials by the clamped distance
+// min(d_f, max(r, L - d_b)), where d_f and d_b are the (exact) distances from the
+// source and to the nearest sink, which is a feasible potential function and is tight
+// along the path.
+template<class Network, class Dijkstra, class Path>
+constexpr void
+update_potential_bidirectional_ssp(Network& network,
+                                   const Dijkstra& forward,
+                                   const Dijkstra& backward,
+                                   const Path& path)
+{
+    using Distance = typename Dijkstra::distance_type;
+    WHIRLWIND_STATIC_ASSERT(std::is_same_v<Distance, typename Network::cost_type>);
+
+    WHIRLWIND_ASSERT(std::addressof(network.residual_graph()) ==
+                     std::addressof(forward.graph()));
+    WHIRLWIND_ASSERT(std::addressof(network.residual_graph()) ==
+                     std::addressof(backward.graph()));
+
+    const auto forward_radius = path.forward_radius;
+    const auto backward_radius = path.length - forward_radius;
+    WHIRLWIND_DEBUG_ASSERT(forward_radius >= zero<Distance>());
+    WHIRLWIND_DEBUG_ASSERT(backward_radius >= zero<Distance>());
+
+    for (const auto& node : forward.visited_vertices()) {
+        const auto distance = forward.distance_to_vertex(node);
+        if (distance < forward_radius) {
+            network.increase_node_potential(node, forward_radius - distance);
+        }
+    }
+
+    for (const auto& node : backward.visited_vertices()) {
+        const auto distance = backward.distance_to_vertex(node);
+        if (distance < backward_radius) {
+            network.decrease_node_potential(node, backward_radius - distance);
+        }
+    }
+}
+
+/**
+ * Solve a minimum cost flow problem using a bidirectional variant of the successive
+ * shortest paths algorithm.
+ *
+ * Each augmenting path is found by a bidirectional Dijkstra search that proceeds
+ * forward from an excess node and backward from all remaining deficit nodes until the
+ * two searches meet. The resulting flow is optimal, like that of
+ * `successive_shortest_paths()`. When excess and deficit nodes are few and far apart,
+ * each search typically visits fewer nodes than the unidirectional search. When there
+ * are many deficit nodes, the cost of seeding the backward search with each of them on
+ * every iteration tends to outweigh the savings, and `successive_shortest_paths()` or
+ * `batched_successive_shortest_paths()` should be preferred.
+ *
+ * The backward search traverses the incoming arcs of each node, which are found from
+ * the transposes of its outgoing arcs in the residual graph.
+ *
+ * @tparam Dijkstra
+ *     The shortest path solver type. Must be a heap-based solver (e.g. `Dijkstra`)
+ *     whose `heap().top()` is the nearest unvisited node.
+ * @tparam Logger
+ *     The logger type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the list of deficit nodes.
+ *
+ * @param[in,out] network
+ *     The network. Must be balanced.
+ */
+template<detail::HeapDijkstraSolverType Dijkstra,
+         class Logger = NullLogger,
+         template<class> class Container = Vector,
+         class Network>
+constexpr void
+bidirectional_successive_shortest_paths(Network& network)
+{
+    auto logger = Logger("whirlwind.network.bidirectional_successive_shortest_paths");
+
+    WHIRLWIND_ASSERT(network.is_balanced());
+
+    auto forward = Dijkstra(network);
+    auto backward = Dijkstra(network);
+    WHIRLWIND_DEBUG_ASSERT(forward.done());
+    WHIRLWIND_DEBUG_ASSERT(backward.done());
+
+    using Node = typename Network::node_type;
+    auto sinks = network.deficit_nodes() | ranges::to<Container<Node>>();
+
+    const auto num_iter = network.total_excess();
+    using Iter = std::remove_const_t<decltype(num_iter)>;
+    Iter iter = 1;
+    for (const auto& source : network.excess_nodes()) {
+        // Each iteration routes a single unit of flow from the source.
+        while (network.is_excess_node(source)) {
+            if (iter % 100 == 0) {
+                logger.info("Iteration {:>8}/{}", iter, num_iter);
+            }
+
+            const auto path = bidirectional_dijkstra_ssp(forward, backward, network,
+                                                         source, sinks);
+            WHIRLWIND_ASSERT(path);
+
+            const auto sink =
+                    augment_flow_bidirectional_ssp(network, forward, backward, *path);
+            update_potential_bidirectional_ssp(network, forward, backward, *path);
+
+            // Remove the sink from the list if its deficit was exhausted.
+            if (!network.is_deficit_node(sink)) {
+                auto it = ranges::remove_if(sinks, [&](const auto& node) {
+                    return node == sink;
+                });
+                sinks.erase(it, std::end(sinks));
+            }
+
+            ++iter;
+        }
+    }
+
+    WHIRLWIND_ASSERT(std::empty(sinks));
+    WHIRLWIND_ASSERT(network.total_excess() == 0);
+}
+
+WHIRLWIND_NAMESPACE_END
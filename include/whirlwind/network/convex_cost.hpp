@@ -0,0 +1,327 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/graph_concepts.hpp>
+#include <whirlwind/math/math.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+#include "unit_capacity.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A table of convex piecewise-linear arc cost functions.
+ *
+ * A convex cost function f of the (integer) flow along a link between two adjacent
+ * nodes is modeled by P parallel unit-capacity edges, the k-th of which carries the
+ * k-th unit of flow at the incremental cost f(k) - f(k-1). Convexity guarantees that
+ * the incremental costs are nondecreasing, so a min cost flow never routes flow
+ * through a parallel edge while a cheaper one remains unsaturated.
+ *
+ * The P incremental costs of each link are stored contiguously, in the same order as
+ * the corresponding parallel edges of a `RectangularGridGraph<P>` (or
+ * `FlatRectangularGridGraph<P>`). The table can therefore be indexed directly by edge
+ * index: the incremental cost of the edge with index `e` is at position `e`.
+ *
+ * @tparam Cost
+ *     The cost type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the incremental costs.
+ */
+template<class Cost, template<class> class Container = Vector>
+class ConvexCostTable {
+public:
+    using cost_type = Cost;
+    using size_type = std::size_t;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    /**
+     * Create a new `ConvexCostTable` from a cost function.
+     *
+     * @param[in] num_links
+     *     The number of links.
+     * @param[in] num_segments
+     *     The number of linear segments of each cost function (i.e. the number of
+     *     parallel edges of each link). Must be at least 1.
+     * @param[in] cost_function
+     *     A function invocable with arguments `(size_type link, size_type flow)` that
+     *     returns the total cost of `flow` units of flow along the link, for each
+     *     `flow` in [0, `num_segments`]. Each function must be convex and
+     *     nondecreasing.
+     */
+    template<class CostFunction>
+    constexpr ConvexCostTable(size_type num_links,
+                              size_type num_segments,
+                              CostFunction cost_function)
+        : num_segments_(num_segments), incremental_costs_(num_links * num_segments)
+    {
+        WHIRLWIND_ASSERT(num_segments_ >= 1);
+
+        for (size_type link = 0; link < num_links; ++link) {
+            auto prev_cost = static_cast<cost_type>(cost_function(link, size_type{0}));
+            for (size_type k = 0; k < num_segments_; ++k) {
+                const auto cost = static_cast<cost_type>(cost_function(link, k + 1));
+                incremental_costs_[link * num_segments_ + k] = cost - prev_cost;
+                prev_cost = cost;
+            }
+        }
+
+        check_convexity();
+    }
+
+    /**
+     * Create a new `ConvexCostTable` from sampled cost functions.
+     *
+     * @param[in] num_segments
+     *     The number of linear segments of each cost function (i.e. the number of
+     *     parallel edges of each link). Must be at least 1.
+     * @param[in] samples
+     *     The total cost of 0, 1, ..., `num_segments` units of flow along each link.
+     *     The `num_segments + 1` samples of each link are contiguous. Each sampled
+     *     function must be convex and nondecreasing.
+     */
+    template<class RandomAccessRange>
+    constexpr ConvexCostTable(size_type num_segments, const RandomAccessRange& samples)
+        : ConvexCostTable(
+                  std::size(samples) / (num_segments + 1), num_segments,
+                  [&](size_type link, size_type flow) {
+                      return samples[link * (num_segments + 1) + flow];
+                  })
+    {
+        WHIRLWIND_ASSERT(std::size(samples) % (num_segments + 1) == 0);
+    }
+
+    /** The number of links. */
+    [[nodiscard]] constexpr auto
+    num_links() const noexcept -> size_type
+    {
+        return std::size(incremental_costs_) / num_segments_;
+    }
+
+    /** The number of linear segments of each cost function. */
+    [[nodiscard]] constexpr auto
+    num_segments() const noexcept -> size_type
+    {
+        return num_segments_;
+    }
+
+    /**
+     * Get the incremental cost of a unit of flow along a link.
+     *
+     * @param[in] link
+     *     The link index. Must be less than `num_links()`.
+     * @param[in] segment
+     *     The segment index. Must be less than `num_segments()`.
+     *
+     * @returns
+     *     The cost of the `segment+1`-th unit of flow along the link, in excess of the
+     *     cost of `segment` units.
+     */
+    [[nodiscard]] constexpr auto
+    incremental_cost(size_type link, size_type segment) const -> const cost_type&
+    {
+        WHIRLWIND_ASSERT(link < num_links());
+        WHIRLWIND_ASSERT(segment < num_segments());
+        return incremental_costs_[link * num_segments_ + segment];
+    }
+
+    /**
+     * The incremental costs of all links, indexed by edge index.
+     *
+     * The incremental cost of segment `k` of link `l` is at position
+     * `l * num_segments() + k`.
+     */
+    [[nodiscard]] constexpr auto
+    incremental_costs() const noexcept -> std::span<const cost_type>
+    {
+        return incremental_costs_;
+    }
+
+private:
+    constexpr void
+    check_convexity() const
+    {
+        for (size_type link = 0; link < num_links(); ++link) {
+            for (size_type k = 0; k < num_segments_; ++k) {
+                [[maybe_unused]] const auto& cost = incremental_cost(link, k);
+                if constexpr (std::is_floating_point_v<cost_type>) {
+                    WHIRLWIND_ASSERT(!std::isnan(cost));
+                }
+                WHIRLWIND_ASSERT(cost >= ((k == 0) ? zero<cost_type>()
+                                                   : incremental_cost(link, k - 1)));
+            }
+        }
+    }
+
+    size_type num_segments_;
+    container_type<cost_type> incremental_costs_;
+};
+
+/**
+ * A capacity mixin for grid networks with convex piecewise-linear arc costs.
+ *
+ * Each link between adjacent nodes of the grid is modeled by P parallel unit-capacity
+ * edges with nondecreasing costs (see `ConvexCostTable`), so the residual graph
+ * contains 2P parallel arcs from each node to each of its neighbors: P forward arcs,
+ * with nondecreasing costs, interleaved with P reverse arcs, with nonincreasing
+ * (nonpositive) costs. Among these, the cheapest unsaturated arc is the last
+ * unsaturated reverse arc if there is one, or else the first unsaturated forward arc,
+ * so the other parallel arcs needn't be considered when searching for shortest
+ * paths.
+ *
+ * `for_each_unsaturated_outgoing_arc()` therefore visits only the cheapest
+ * unsaturated arc to each neighbor. It's found by scanning the saturation state of
+ * the parallel arcs without loading their costs, so shortest path searches relax at
+ * most one arc per neighbor regardless of P. All other members, including
+ * `for_each_outgoing_arc()`, see every parallel arc.
+ *
+ * This relies only on the costs of the parallel edges of each link being
+ * nondecreasing, which is checked when the network is created. It doesn't require the
+ * saturated parallel edges of each link to be a prefix of them, as they are when flow
+ * is only ever augmented along the cheapest unsaturated arcs. (Flows found by
+ * `cost_scaling()` or `network_simplex()`, for example, may saturate any subset of the
+ * parallel edges.)
+ *
+ * @tparam Graph
+ *     The graph type. Must be a `RectangularGridGraph` or `FlatRectangularGridGraph`.
+ * @tparam Flow
+ *     The flow type.
+ * @tparam Container
+ *     A `std::vector`-like type template.
+ * @tparam CapacityMixin
+ *     The underlying unit-capacity mixin.
+ */
+template<GraphType Graph,
+         class Flow,
+         template<class> class Container = Vector,
+         class CapacityMixin = UnitCapacityMixin<Graph, Flow, Container>>
+class ConvexCostMixin : public CapacityMixin {
+private:
+    using super_type = CapacityMixin;
+
+public:
+    using residual_graph_type = typename super_type::residual_graph_type;
+    using node_type = typename super_type::node_type;
+    using arc_type = typename super_type::arc_type;
+    using size_type = typename super_type::size_type;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    using super_type::contains_node;
+    using super_type::get_arc_id;
+    using super_type::is_arc_saturated;
+
+    /**
+     * Invoke a function on the cheapest unsaturated outgoing arc (and corresponding
+     * head node) from a node to each of its neighbors.
+     *
+     * Neighbors are visited in the same order as in `for_each_outgoing_arc()`.
+     * Neighbors to which each parallel arc is saturated are skipped.
+     *
+     * @param[in] node
+     *     The input node. Must be a valid node in the network.
+     * @param[in] visitor
+     *     A function invocable with arguments `(const arc_type&, const node_type&)`.
+     */
+    template<class Visitor>
+    constexpr void
+    for_each_unsaturated_outgoing_arc(const node_type& node, Visitor visitor) const
+    {
+        WHIRLWIND_ASSERT(contains_node(node));
+
+        // The parallel arcs to each neighbor are visited consecutively, starting with
+        // the forward arc of the first parallel edge, whose arc index is a multiple of
+        // the number of parallel arcs. They're inspected once the last of them has
+        // been reached.
+        this->residual_graph().for_each_outgoing_edge(
+                node, [&](const auto& arc, const auto& head) {
+                    const auto arc_id = this->get_arc_id(arc);
+                    if ((arc_id + 1) % num_parallel_arcs() == 0) {
+                        const auto first_arc_id = arc_id + 1 - num_parallel_arcs();
+                        visit_cheapest_unsaturated_arc(first_arc_id, head, visitor);
+                    }
+                });
+    }
+
+    /**
+     * Check that the costs of the parallel edges of each link are nondecreasing, as
+     * required by `for_each_unsaturated_outgoing_arc()`.
+     *
+     * Called by `Network` on construction.
+     *
+     * @param[in] cost
+     *     The unit cost of each arc in the residual graph, indexed by arc index.
+     */
+    template<class RandomAccessRange>
+    constexpr void
+    check_arc_costs([[maybe_unused]] const RandomAccessRange& cost) const
+    {
+        constexpr auto num_parallel_edges = num_parallel_arcs() / 2;
+        WHIRLWIND_ASSERT(std::size(cost) % num_parallel_arcs() == 0);
+
+        for (size_type first_arc_id = 0; first_arc_id < std::size(cost);
+             first_arc_id += num_parallel_arcs()) {
+            for (size_type p = 1; p < num_parallel_edges; ++p) {
+                [[maybe_unused]] const auto& prev_cost = cost[first_arc_id + 2 * p - 2];
+                WHIRLWIND_ASSERT(cost[first_arc_id + 2 * p] >= prev_cost);
+            }
+        }
+    }
+
+private:
+    [[nodiscard]] static constexpr auto
+    num_parallel_arcs() noexcept -> size_type
+    {
+        return residual_graph_type::num_parallel_edges();
+    }
+
+    // Invoke `visitor` on the cheapest unsaturated arc among the parallel arcs from a
+    // node to `head`, given the arc index of the first of them. The p-th parallel edge
+    // has its forward arc at offset 2p and its reverse arc at offset 2p+1. The reverse
+    // arcs are scanned in order of increasing cost, followed by the forward arcs.
+    //
+    // Each reverse arc costs no more than any forward arc, since the edge costs are
+    // nonnegative, and the costs of the forward arcs are nondecreasing in p, so the
+    // first unsaturated arc found is the cheapest regardless of which parallel edges
+    // carry flow.
+    template<class Visitor>
+    constexpr void
+    visit_cheapest_unsaturated_arc(size_type first_arc_id,
+                                   const node_type& head,
+                                   Visitor& visitor) const
+    {
+        constexpr auto num_parallel_edges = num_parallel_arcs() / 2;
+
+        for (auto p = num_parallel_edges; p > 0; --p) {
+            const auto reverse_arc = static_cast<arc_type>(first_arc_id + 2 * p - 1);
+            if (!this->is_arc_saturated(reverse_arc)) {
+                visitor(reverse_arc, head);
+                return;
+            }
+        }
+
+        for (size_type p = 0; p < num_parallel_edges; ++p) {
+            const auto forward_arc = static_cast<arc_type>(first_arc_id + 2 * p);
+            if (!this->is_arc_saturated(forward_arc)) {
+                visitor(forward_arc, head);
+                return;
+            }
+        }
+    }
+
+protected:
+    using super_type::super_type;
+};
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,588 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/heap.hpp>
+#include <whirlwind/container/queue.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/logging/null_logger.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A minimum cost flow solver based on Goldberg & Tarjan's cost scaling push-relabel
+ * algorithm.
+ *
+ * The solver maintains an $\epsilon$-optimal pseudoflow w.r.t. a set of node prices,
+ * i.e. each unsaturated arc has reduced cost $\geq -\epsilon$. Each scaling phase
+ * ("refine") divides $\epsilon$ by a constant factor, saturates every arc with negative
+ * reduced cost, and then repeatedly discharges active (excess) nodes in FIFO order,
+ * pushing flow along admissible arcs (unsaturated arcs with negative reduced cost) and
+ * relabeling nodes that have none.
+ *
+ * Arc costs are internally scaled by $n + 1$ (where $n$ is the number of nodes) so that
+ * the final phase, with $\epsilon = 1$, yields an optimal flow. Reduced costs in the
+ * scaled problem are therefore stored using a 64-bit integer type.
+ *
+ * Two standard heuristics are used:
+ *
+ * - Global price updates periodically recompute the prices from the (approximate)
+ *   distances from each node to the nearest deficit node in the residual graph, which
+ *   sharply reduces the number of relabel operations.
+ * - Arc fixing excludes arcs whose reduced cost magnitude exceeds $2 n \epsilon$ at the
+ *   start of a phase. The flow on such an arc is the same in every optimal solution, so
+ *   they never need to be examined again.
+ *
+ * The prices are owned by the solver. Once solved, they're converted to an optimal
+ * dual solution and stored as the node potentials of the network, so that every
+ * unsaturated arc in the residual graph has nonnegative reduced cost.
+ *
+ * @tparam Network
+ *     The network type. Its cost type must be integral.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store per-node and per-arc state.
+ */
+template<class Network, template<class> class Container = Vector>
+class CostScalingPushRelabel {
+public:
+    using network_type = Network;
+    using node_type = typename network_type::node_type;
+    using arc_type = typename network_type::arc_type;
+    using cost_type = typename network_type::cost_type;
+    using flow_type = typename network_type::flow_type;
+    using price_type = std::int64_t;
+    using size_type = std::size_t;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<cost_type>);
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<flow_type>);
+
+    /**
+     * Create a new solver for the specified network.
+     *
+     * The solver's prices are initialized from the node potentials of the network.
+     *
+     * @param[in,out] network
+     *     The network. Must be balanced.
+     * @param[in] scale_factor
+     *     The factor by which $\epsilon$ is divided in each phase. Must be >= 2.
+     */
+    explicit constexpr CostScalingPushRelabel(network_type& network,
+                                              price_type scale_factor = 8)
+        : network_(&network),
+          scale_factor_(scale_factor),
+          cost_scale_(static_cast<price_type>(network.num_nodes()) + 1),
+          price_(network.num_nodes()),
+          is_arc_fixed_(network.num_arcs(), false),
+          distance_(network.num_nodes())
+    {
+        WHIRLWIND_ASSERT(network.is_balanced());
+        WHIRLWIND_ASSERT(scale_factor >= 2);
+
+        for (const auto& node : network.nodes()) {
+            get_price(node) =
+                    static_cast<price_type>(network.node_potential(node)) * cost_scale_;
+        }
+
+        // Uncapacitated arcs are treated as if their capacity were equal to the total
+        // supply, which is an upper bound on the flow in any arc of some optimal
+        // solution (since arc costs are nonnegative).
+        for (const auto& node : network.excess_nodes()) {
+            max_flow_ += network.node_excess(node);
+        }
+    }
+
+    /** The network. */
+    [[nodiscard]] constexpr auto
+    network() const noexcept -> const network_type&
+    {
+        return *network_;
+    }
+
+    /** The network. */
+    [[nodiscard]] constexpr auto
+    network() noexcept -> network_type&
+    {
+        return *network_;
+    }
+
+    /** The factor by which $\epsilon$ is divided in each phase. */
+    [[nodiscard]] constexpr auto
+    scale_factor() const noexcept -> price_type
+    {
+        return scale_factor_;
+    }
+
+    /** The current value of $\epsilon$ (in units of the scaled arc costs). */
+    [[nodiscard]] constexpr auto
+    epsilon() const noexcept -> price_type
+    {
+        return epsilon_;
+    }
+
+    /** The price of a node (in units of the scaled arc costs). */
+    [[nodiscard]] constexpr auto
+    node_price(const node_type& node) const -> price_type
+    {
+        WHIRLWIND_ASSERT(network().contains_node(node));
+        const auto node_id = network().get_node_id(node);
+        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(price_));
+        return price_[node_id];
+    }
+
+    /**
+     * Get the reduced cost of an arc w.r.t. the scaled arc costs and the current node
+     * prices.
+     *
+     * @param[in] arc
+     *     The input arc.
+     * @param[in] tail
+     *     The arc's tail node.
+     * @param[in] head
+     *     The arc's head node.
+     *
+     * @returns
+     *     The scaled reduced cost of the arc.
+     */
+    [[nodiscard]] constexpr auto
+    arc_reduced_cost(const arc_type& arc,
+                     const node_type& tail,
+                     const node_type& head) const -> price_type
+    {
+        const auto cost = static_cast<price_type>(network().arc_cost(arc));
+        return cost * cost_scale_ - node_price(tail) + node_price(head);
+    }
+
+    /**
+     * Get the residual capacity of an arc, with the capacity of uncapacitated arcs
+     * bounded by the total supply.
+     *
+     * @param[in] arc
+     *     The input arc.
+     *
+     * @returns
+     *     The (bounded) residual capacity of the arc.
+     */
+    [[nodiscard]] constexpr auto
+    arc_residual_capacity(const arc_type& arc) const -> flow_type
+    {
+        const auto residual_capacity = network().arc_residual_capacity(arc);
+        if (residual_capacity == infinity<flow_type>()) {
+            WHIRLWIND_DEBUG_ASSERT(network().arc_flow(arc) <= max_flow_);
+            return max_flow_ - network().arc_flow(arc);
+        }
+        return residual_capacity;
+    }
+
+    /** Check whether an arc has been excluded from the residual graph. */
+    [[nodiscard]] constexpr auto
+    is_arc_fixed(const arc_type& arc) const -> bool
+    {
+        WHIRLWIND_ASSERT(network().contains_arc(arc));
+        const auto arc_id = network().get_arc_id(arc);
+        WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(is_arc_fixed_));
+        return is_arc_fixed_[arc_id];
+    }
+
+    /**
+     * Check whether an arc is admissible -- that is, it's neither saturated nor fixed
+     * and has negative reduced cost.
+     */
+    [[nodiscard]] constexpr auto
+    is_arc_admissible(const arc_type& arc,
+                      const node_type& tail,
+                      const node_type& head) const -> bool
+    {
+        return is_arc_residual(arc) && (arc_reduced_cost(arc, tail, head) < 0);
+    }
+
+    /**
+     * Solve the minimum cost flow problem and write the optimal potentials to the
+     * network.
+     *
+     * Throws `std::overflow_error` if any optimal potential can't be represented by
+     * the network's cost type, in which case the network is left with the optimal
+     * flow but its node potentials are unchanged.
+     */
+    template<class Logger = NullLogger>
+    constexpr void
+    run()
+    {
+        auto logger = Logger("whirlwind.network.cost_scaling");
+
+        if (max_flow_ == zero<flow_type>()) {
+            return;
+        }
+
+        // Any pseudoflow is trivially C-optimal, where C is the max (scaled) arc cost
+        // magnitude.
+        epsilon_ = 1;
+        for (const auto& tail : network().nodes()) {
+            network().for_each_outgoing_arc(
+                    tail, [&](const auto& arc, const auto& head) {
+                        const auto reduced_cost = arc_reduced_cost(arc, tail, head);
+                        epsilon_ = std::max(epsilon_, -reduced_cost);
+                    });
+        }
+
+        std::size_t phase = 1;
+        do {
+            // Arc fixing is only valid for a (balanced) epsilon-optimal flow, so it's
+            // skipped prior to the first phase.
+            if (phase > 1) {
+                fix_arcs();
+            }
+            epsilon_ = std::max(epsilon_ / scale_factor(), price_type{1});
+            logger.info("Phase {} (epsilon = {})", phase, epsilon_);
+            refine();
+            ++phase;
+        } while (epsilon_ > 1);
+
+        WHIRLWIND_ASSERT(network().is_balanced());
+
+        write_potentials();
+    }
+
+protected:
+    [[nodiscard]] constexpr auto
+    get_price(const node_type& node) -> price_type&
+    {
+        WHIRLWIND_ASSERT(network().contains_node(node));
+        const auto node_id = network().get_node_id(node);
+        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(price_));
+        return price_[node_id];
+    }
+
+    [[nodiscard]] constexpr auto
+    get_distance(const node_type& node) -> size_type&
+    {
+        const auto node_id = network().get_node_id(node);
+        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(distance_));
+        return distance_[node_id];
+    }
+
+    [[nodiscard]] constexpr auto
+    is_arc_residual(const arc_type& arc) const -> bool
+    {
+        return !is_arc_fixed(arc) && (arc_residual_capacity(arc) > zero<flow_type>());
+    }
+
+    [[nodiscard]] static constexpr auto
+    unreached() noexcept -> size_type
+    {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    // Push `delta` units of flow along the arc, updating the excess of its endpoints.
+    // The head is appended to the queue of active nodes if it became active.
+    constexpr void
+    push(const arc_type& arc,
+         const node_type& tail,
+         const node_type& head,
+         const flow_type& delta)
+    {
+        WHIRLWIND_DEBUG_ASSERT(delta > zero<flow_type>());
+        WHIRLWIND_DEBUG_ASSERT(delta <= arc_residual_capacity(arc));
+
+        network().increase_arc_flow(arc, delta);
+        network().decrease_node_excess(tail, delta);
+
+        const auto was_active = network().is_excess_node(head);
+        network().increase_node_excess(head, delta);
+        if (!was_active && network().is_excess_node(head)) {
+            active_nodes_.push(head);
+        }
+    }
+
+    // Exclude each arc whose reduced cost magnitude exceeds 2n * epsilon (along with
+    // its transpose arc) from the residual graph. Must be called while the current flow
+    // is epsilon-optimal (i.e. at the end of a phase).
+    constexpr void
+    fix_arcs()
+    {
+        const auto num_nodes = static_cast<price_type>(network().num_nodes());
+        const auto threshold = 2 * num_nodes * epsilon_;
+
+        for (const auto& tail : network().nodes()) {
+            network().for_each_outgoing_arc(
+                    tail, [&](const auto& arc, const auto& head) {
+                        if (is_arc_fixed(arc)) {
+                            return;
+                        }
+                        const auto reduced_cost = arc_reduced_cost(arc, tail, head);
+                        if ((reduced_cost > threshold) || (reduced_cost < -threshold)) {
+                            const auto arc_id = network().get_arc_id(arc);
+                            const auto transpose_arc_id =
+                                    network().get_transpose_arc_id(arc);
+                            is_arc_fixed_[arc_id] = true;
+                            is_arc_fixed_[transpose_arc_id] = true;
+                        }
+                    });
+        }
+    }
+
+    // Convert the current epsilon-optimal flow into an epsilon/alpha-optimal flow.
+    constexpr void
+    refine()
+    {
+        // Saturate each arc with negative reduced cost, which makes the pseudoflow
+        // 0-optimal but typically unbalanced.
+        for (const auto& tail : network().nodes()) {
+            network().for_each_outgoing_arc(
+                    tail, [&](const auto& arc, const auto& head) {
+                        if (is_arc_admissible(arc, tail, head)) {
+                            push(arc, tail, head, arc_residual_capacity(arc));
+                        }
+                    });
+        }
+
+        active_nodes_.clear();
+        for (const auto& node : network().excess_nodes()) {
+            active_nodes_.push(node);
+        }
+
+        update_prices();
+
+        while (!std::empty(active_nodes_)) {
+            const auto node = active_nodes_.front();
+            active_nodes_.pop();
+            discharge(node);
+
+            // Perform a global price update after every n relabel operations.
+            if (num_relabels_ >= network().num_nodes()) {
+                update_prices();
+            }
+        }
+    }
+
+    // Push flow from an active node along admissible arcs until its excess is
+    // exhausted, relabeling the node whenever it has no remaining admissible arcs.
+    constexpr void
+    discharge(const node_type& tail)
+    {
+        while (network().is_excess_node(tail)) {
+            // Track the min reduced cost among residual arcs that weren't admissible.
+            // If the node still has excess after the scan, each admissible arc was
+            // saturated and so this is the min reduced cost of any residual arc.
+            auto min_reduced_cost = std::numeric_limits<price_type>::max();
+
+            network().for_each_outgoing_arc(
+                    tail, [&](const auto& arc, const auto& head) {
+                        if (!network().is_excess_node(tail) || !is_arc_residual(arc)) {
+                            return;
+                        }
+
+                        const auto reduced_cost = arc_reduced_cost(arc, tail, head);
+                        if (reduced_cost >= 0) {
+                            min_reduced_cost = std::min(min_reduced_cost, reduced_cost);
+                            return;
+                        }
+
+                        const auto delta = std::min(network().node_excess(tail),
+                                                    arc_residual_capacity(arc));
+                        push(arc, tail, head, delta);
+                    });
+
+            if (network().is_excess_node(tail)) {
+                // Relabel the node. Afterwards, the min reduced cost among its
+                // outgoing residual arcs is -epsilon.
+                WHIRLWIND_ASSERT(min_reduced_cost !=
+                                 std::numeric_limits<price_type>::max());
+                get_price(tail) += min_reduced_cost + epsilon_;
+                ++num_relabels_;
+            }
+        }
+    }
+
+    // Update the node prices based on the distance from each node to the nearest
+    // deficit node in the residual graph, where the length of each residual arc is its
+    // reduced cost in units of epsilon (rounded up so that arcs along shortest paths
+    // become admissible). The pseudoflow remains epsilon-optimal.
+    constexpr void
+    update_prices()
+    {
+        num_relabels_ = 0;
+        heap_.clear();
+
+        size_type num_active = 0;
+        for (const auto& node : network().nodes()) {
+            if (network().is_deficit_node(node)) {
+                get_distance(node) = 0;
+                heap_.emplace(node, size_type{0});
+            } else {
+                get_distance(node) = unreached();
+                if (network().is_excess_node(node)) {
+                    ++num_active;
+                }
+            }
+        }
+
+        // Run Dijkstra's algorithm in the reverse residual graph, stopping once the
+        // distance to each active node is known.
+        size_type max_distance = 0;
+        while (!std::empty(heap_) && (num_active > 0)) {
+            const auto top = heap_.top();
+            heap_.pop();
+            using std::get;
+            const auto& head = get<0>(top);
+            const auto& distance = get<1>(top);
+
+            // Skip stale heap entries.
+            if (distance != get_distance(head)) {
+                continue;
+            }
+            max_distance = distance;
+
+            if (network().is_excess_node(head)) {
+                --num_active;
+            }
+
+            // Relax each incoming residual arc.
+            network().for_each_outgoing_arc(
+                    head, [&](const auto& arc, const auto& tail) {
+                        const auto transpose_arc = static_cast<arc_type>(
+                                network().get_transpose_arc_id(arc));
+                        if (!is_arc_residual(transpose_arc)) {
+                            return;
+                        }
+
+                        const auto reduced_cost =
+                                arc_reduced_cost(transpose_arc, tail, head);
+                        const auto arc_length =
+                                (reduced_cost < 0)
+                                        ? size_type{0}
+                                        : static_cast<size_type>(reduced_cost /
+                                                                 epsilon_) + 1;
+
+                        const auto new_distance = distance + arc_length;
+                        auto& tail_distance = get_distance(tail);
+                        if (new_distance < tail_distance) {
+                            tail_distance = new_distance;
+                            heap_.emplace(tail, new_distance);
+                        }
+                    });
+        }
+        WHIRLWIND_ASSERT(num_active == 0);
+
+        // Nodes whose distance wasn't finalized are assigned the max distance among
+        // scanned nodes.
+        for (const auto& node : network().nodes()) {
+            const auto distance = std::min(get_distance(node), max_distance);
+            get_price(node) += static_cast<price_type>(distance) * epsilon_;
+        }
+    }
+
+    // Set the node potentials of the network to an optimal dual solution.
+    //
+    // The final prices are 1-optimal w.r.t. the scaled arc costs, so rounding them
+    // down to unscaled units leaves each unsaturated arc with reduced cost >= -1. The
+    // flow is optimal, so the residual graph has no negative cycles, and the rounded
+    // prices are then corrected by a FIFO label-correcting search that raises the
+    // price of the head of each unsaturated arc with negative reduced cost. Since most
+    // arcs already have nonnegative reduced cost, few nodes are typically revisited.
+    constexpr void
+    write_potentials()
+    {
+        for (auto& price : price_) {
+            const auto rounded = price / cost_scale_;
+            price = ((price % cost_scale_ < 0) ? rounded - 1 : rounded);
+        }
+
+        // Arc fixing no longer applies, since the search considers every unsaturated
+        // arc. The distance array flags the nodes in the queue.
+        active_nodes_.clear();
+        for (const auto& node : network().nodes()) {
+            active_nodes_.push(node);
+            get_distance(node) = 1;
+        }
+
+        while (!std::empty(active_nodes_)) {
+            const auto tail = active_nodes_.front();
+            active_nodes_.pop();
+            get_distance(tail) = 0;
+
+            const auto tail_price = get_price(tail);
+            network().for_each_outgoing_arc(
+                    tail, [&](const arc_type& arc, const node_type& head) {
+                        if (network().is_arc_saturated(arc)) {
+                            return;
+                        }
+                        const auto& cost = network().arc_cost(arc);
+                        const auto price = tail_price - static_cast<price_type>(cost);
+                        auto& head_price = get_price(head);
+                        if (head_price < price) {
+                            head_price = price;
+                            if (get_distance(head) == 0) {
+                                active_nodes_.push(head);
+                                get_distance(head) = 1;
+                            }
+                        }
+                    });
+        }
+
+        for (const auto& node : network().nodes()) {
+            if (!std::in_range<cost_type>(get_price(node))) WHIRLWIND_UNLIKELY {
+                throw std::overflow_error("node potential overflows the cost type");
+            }
+        }
+        for (const auto& node : network().nodes()) {
+            const auto potential = static_cast<cost_type>(get_price(node));
+            const auto delta = potential - network().node_potential(node);
+            network().increase_node_potential(node, delta);
+        }
+    }
+
+private:
+    network_type* network_;
+    price_type scale_factor_;
+    price_type cost_scale_;
+    price_type epsilon_ = 1;
+    flow_type max_flow_ = zero<flow_type>();
+    container_type<price_type> price_;
+    container_type<bool> is_arc_fixed_;
+    container_type<size_type> distance_;
+    Queue<node_type> active_nodes_ = {};
+    RadixHeap<node_type, size_type, Container> heap_ = {};
+    size_type num_relabels_ = 0;
+};
+
+/**
+ * Solve a minimum cost flow problem using the cost scaling push-relabel algorithm.
+ *
+ * This is a drop-in alternative to `primal_dual()` and `successive_shortest_paths()`.
+ * Its running time is bounded by the number of scaling phases, $O(\log(nC))$ (where $C$
+ * is the max arc cost magnitude), rather than by the total supply.
+ *
+ * @tparam Logger
+ *     The logger type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the solver's state.
+ *
+ * @param[in,out] network
+ *     The network. Must be balanced and have integral costs.
+ * @param[in] scale_factor
+ *     The factor by which $\epsilon$ is divided in each phase. Must be >= 2.
+ */
+template<class Logger = NullLogger,
+         template<class> class Container = Vector,
+         class Network>
+constexpr void
+cost_scaling(Network& network, std::int64_t scale_factor = 8)
+{
+    auto solver = CostScalingPushRelabel<Network, Container>(network, scale_factor);
+    solver.template run<Logger>();
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A lower bound on the distance from each node of a grid network to the nearest
+ * deficit node, for use as an A* heuristic (see `astar_successive_shortest_paths()`).
+ *
+ * Any path between two nodes of a grid has at least as many arcs as the Manhattan
+ * distance between them. The heuristic value of a node is therefore the Manhattan
+ * distance to the nearest deficit node, multiplied by the minimum reduced cost of any
+ * unsaturated arc in the network (clamped to half the largest value representable by
+ * the cost type). The heuristic values of adjacent nodes differ by no more than the
+ * minimum reduced arc cost, so the heuristic is consistent. Both the deficit nodes and
+ * the minimum reduced arc cost are captured from the state of the network when the
+ * heuristic is created.
+ *
+ * Deficit nodes are indexed by a coarse occupancy grid that partitions the nodes into
+ * square blocks and stores the list of deficit nodes in each block. The nearest
+ * deficit node is found by scanning the blocks in rings of increasing size around the
+ * node's block until no closer deficit node is possible. Each node's heuristic value is
+ * cached when it's first computed.
+ *
+ * @tparam Network
+ *     The network type. Its residual graph must be a `RectangularGridGraph` or a
+ *     `FlatRectangularGridGraph`.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the occupancy grid and the
+ *     cached heuristic values.
+ */
+template<class Network, template<class> class Container = Vector>
+class GridDistanceHeuristic {
+public:
+    using network_type = Network;
+    using node_type = typename network_type::node_type;
+    using cost_type = typename network_type::cost_type;
+    using size_type = std::size_t;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    /**
+     * Create a new `GridDistanceHeuristic`.
+     *
+     * @param[in] network
+     *     The network. The reduced cost of each unsaturated arc must be nonnegative.
+     * @param[in] block_size
+     *     The number of rows & columns of nodes in each block of the occupancy grid.
+     *     If zero, the block size is chosen such that the number of blocks is roughly
+     *     equal to the total deficit of all deficit nodes.
+     */
+    explicit constexpr GridDistanceHeuristic(const network_type& network,
+                                             size_type block_size = 0)
+        : num_rows_(network.residual_graph().num_rows()),
+          num_cols_(network.residual_graph().num_cols()),
+          min_arc_cost_(min_reduced_arc_cost(network))
+    {
+        if (block_size == 0) {
+            const auto total_deficit = static_cast<double>(-network.total_deficit());
+            const auto num_nodes = static_cast<double>(network.num_nodes());
+            const auto area = num_nodes / std::max(total_deficit, 1.0);
+            block_size = static_cast<size_type>(std::sqrt(area));
+        }
+        block_size_ = std::max(block_size, size_type{1});
+
+        num_block_rows_ = (num_rows_ + block_size_ - 1) / block_size_;
+        num_block_cols_ = (num_cols_ + block_size_ - 1) / block_size_;
+
+        // Bucket the deficit nodes by block using a counting sort.
+        const auto num_blocks = num_block_rows_ * num_block_cols_;
+        block_offsets_ = container_type<size_type>(num_blocks + 1, 0);
+        for (const auto& node : network.deficit_nodes()) {
+            ++block_offsets_[get_block_id(node) + 1];
+        }
+        for (size_type block_id = 0; block_id < num_blocks; ++block_id) {
+            block_offsets_[block_id + 1] += block_offsets_[block_id];
+        }
+        deficit_nodes_ = container_type<size_type>(block_offsets_.back());
+        auto next = container_type<size_type>(std::begin(block_offsets_),
+                                              std::end(block_offsets_));
+        for (const auto& node : network.deficit_nodes()) {
+            deficit_nodes_[next[get_block_id(node)]++] = get_linear_index(node);
+        }
+
+        cache_ = container_type<cost_type>(network.num_nodes(), infinity<cost_type>());
+    }
+
+    /** The number of rows & columns of nodes in each block of the occupancy grid. */
+    [[nodiscard]] constexpr auto
+    block_size() const noexcept -> size_type
+    {
+        return block_size_;
+    }
+
+    /** The minimum reduced cost of any unsaturated arc in the network. */
+    [[nodiscard]] constexpr auto
+    min_arc_cost() const noexcept -> const cost_type&
+    {
+        return min_arc_cost_;
+    }
+
+    /**
+     * Get the heuristic value of a node.
+     *
+     * @param[in] node
+     *     The input node. Must be a valid node in the network.
+     *
+     * @returns
+     *     A lower bound on the reduced cost of any path from the node to a deficit
+     *     node.
+     */
+    [[nodiscard]] constexpr auto
+    operator()(const node_type& node) -> cost_type
+    {
+        if ((min_arc_cost_ == zero<cost_type>()) || std::empty(deficit_nodes_)) {
+            return zero<cost_type>();
+        }
+
+        const auto index = get_linear_index(node);
+        WHIRLWIND_ASSERT(index < std::size(cache_));
+        auto& value = cache_[index];
+        if (value == infinity<cost_type>()) {
+            const auto distance = distance_to_nearest_deficit_node(index);
+            value = get_heuristic_value(distance);
+        }
+        return value;
+    }
+
+private:
+    // Get the row-major linear index of a node. Nodes of a `FlatRectangularGridGraph`
+    // are linear indices, whereas nodes of a `RectangularGridGraph` are (row,col)
+    // pairs.
+    [[nodiscard]] constexpr auto
+    get_linear_index(const node_type& node) const -> size_type
+    {
+        if constexpr (std::is_integral_v<node_type>) {
+            return static_cast<size_type>(node);
+        } else {
+            using std::get;
+            const auto row = static_cast<size_type>(get<0>(node));
+            const auto col = static_cast<size_type>(get<1>(node));
+            WHIRLWIND_ASSERT(row < num_rows_);
+            WHIRLWIND_ASSERT(col < num_cols_);
+            return row * num_cols_ + col;
+        }
+    }
+
+    [[nodiscard]] constexpr auto
+    get_block_id(const node_type& node) const -> size_type
+    {
+        const auto index = get_linear_index(node);
+        return get_block_id(index / num_cols_ / block_size_,
+                            index % num_cols_ / block_size_);
+    }
+
+    [[nodiscard]] constexpr auto
+    get_block_id(size_type block_row, size_type block_col) const -> size_type
+    {
+        WHIRLWIND_DEBUG_ASSERT(block_row < num_block_rows_);
+        WHIRLWIND_DEBUG_ASSERT(block_col < num_block_cols_);
+        return block_row * num_block_cols_ + block_col;
+    }
+
+    // Get the heuristic value corresponding to a Manhattan distance, i.e. the product
+    // of the distance and the minimum reduced arc cost. The product may not be
+    // representable by `cost_type` (and the sum of the heuristic value and the distance
+    // to a node may not be either), so it's clamped to half the largest finite value.
+    // The minimum of a consistent heuristic and a constant is still consistent.
+    [[nodiscard]] constexpr auto
+    get_heuristic_value(size_type distance) const -> cost_type
+    {
+        WHIRLWIND_ASSERT(min_arc_cost_ > zero<cost_type>());
+        constexpr auto max_value = std::numeric_limits<cost_type>::max() / 2;
+
+        if constexpr (std::is_integral_v<cost_type>) {
+            // Compare against the largest distance whose product doesn't exceed the
+            // maximum value rather than computing the (possibly overflowing) product.
+            const auto max_distance = max_value / min_arc_cost_;
+            if (distance > static_cast<size_type>(max_distance)) {
+                return max_value;
+            }
+            return min_arc_cost_ * static_cast<cost_type>(distance);
+        } else {
+            const auto value = min_arc_cost_ * static_cast<cost_type>(distance);
+            return std::min(value, max_value);
+        }
+    }
+
+    // Get the Manhattan distance from the node with the specified linear index to the
+    // nearest deficit node.
+    [[nodiscard]] constexpr auto
+    distance_to_nearest_deficit_node(size_type index) const -> size_type
+    {
+        const auto row = index / num_cols_;
+        const auto col = index % num_cols_;
+        const auto block_row = row / block_size_;
+        const auto block_col = col / block_size_;
+
+        const auto abs_diff = [](size_type a, size_type b) {
+            return (a > b) ? a - b : b - a;
+        };
+
+        auto distance = std::numeric_limits<size_type>::max();
+        const auto visit = [&](size_type i, size_type j) {
+            const auto block_id = get_block_id(i, j);
+            const auto first = block_offsets_[block_id];
+            const auto last = block_offsets_[block_id + 1];
+            for (auto k = first; k != last; ++k) {
+                const auto other = deficit_nodes_[k];
+                const auto d = abs_diff(row, other / num_cols_) +
+                               abs_diff(col, other % num_cols_);
+                distance = std::min(distance, d);
+            }
+        };
+
+        const auto max_radius = std::max({block_row, num_block_rows_ - 1 - block_row,
+                                          block_col, num_block_cols_ - 1 - block_col});
+
+        for (size_type radius = 0; radius <= max_radius; ++radius) {
+            // Each node in a block on the ring at this radius is farther away than
+            // this, so no closer deficit node remains.
+            if ((radius != 0) && ((radius - 1) * block_size_ >= distance)) {
+                break;
+            }
+
+            const auto i0 = (block_row >= radius) ? block_row - radius : 0;
+            const auto i1 = std::min(block_row + radius, num_block_rows_ - 1);
+            const auto j0 = (block_col >= radius) ? block_col - radius : 0;
+            const auto j1 = std::min(block_col + radius, num_block_cols_ - 1);
+
+            for (auto i = i0; i <= i1; ++i) {
+                if (abs_diff(i, block_row) == radius) {
+                    for (auto j = j0; j <= j1; ++j) {
+                        visit(i, j);
+                    }
+                } else {
+                    if (block_col >= radius) {
+                        visit(i, block_col - radius);
+                    }
+                    if (block_col + radius < num_block_cols_) {
+                        visit(i, block_col + radius);
+                    }
+                }
+            }
+        }
+
+        WHIRLWIND_DEBUG_ASSERT(distance != std::numeric_limits<size_type>::max());
+        return distance;
+    }
+
+    [[nodiscard]] static constexpr auto
+    min_reduced_arc_cost(const network_type& network) -> cost_type
+    {
+        auto min_cost = infinity<cost_type>();
+        for (const auto& tail : network.nodes()) {
+            network.for_each_outgoing_arc(tail, [&](const auto& arc, const auto& head) {
+                if (!network.is_arc_saturated(arc)) {
+                    const auto cost = network.arc_reduced_cost(arc, tail, head);
+                    min_cost = std::min(min_cost, cost);
+                }
+            });
+        }
+
+        if (min_cost == infinity<cost_type>()) {
+            return zero<cost_type>();
+        }
+        WHIRLWIND_ASSERT(min_cost >= zero<cost_type>());
+        return min_cost;
+    }
+
+    size_type num_rows_;
+    size_type num_cols_;
+    cost_type min_arc_cost_;
+    size_type block_size_ = 1;
+    size_type num_block_rows_ = 0;
+    size_type num_block_cols_ = 0;
+    container_type<size_type> block_offsets_;
+    container_type<size_type> deficit_nodes_;
+    container_type<cost_type> cache_;
+};
+
+WHIRLWIND_NAMESPACE_END
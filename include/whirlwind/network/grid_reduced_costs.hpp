@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/** The direction of the arcs in a row of arcs of a grid network. */
+enum class GridDirection { up, left, down, right };
+
+namespace detail {
+
+// Get the node at the specified row & column of a grid network. Nodes of a
+// `FlatRectangularGridGraph` are linear indices, whereas nodes of a
+// `RectangularGridGraph` are (row,col) pairs.
+template<class Network>
+[[nodiscard]] constexpr auto
+get_grid_node(const Network& network, std::size_t row, std::size_t col)
+        -> typename Network::node_type
+{
+    using Node = typename Network::node_type;
+    if constexpr (std::is_integral_v<Node>) {
+        const auto num_cols = static_cast<std::size_t>(
+                network.residual_graph().num_cols());
+        return static_cast<Node>(row * num_cols + col);
+    } else {
+        using Dim = typename Node::first_type;
+        return {static_cast<Dim>(row), static_cast<Dim>(col)};
+    }
+}
+
+// The tail nodes of the arcs in a row of arcs are the `num_cols` consecutive nodes in
+// row `row` starting at column `first_col`. Their head nodes are the same number of
+// consecutive nodes in row `head_row` starting at column `first_head_col`.
+struct GridRowExtent {
+    std::size_t first_col;
+    std::size_t num_cols;
+    std::size_t head_row;
+    std::size_t first_head_col;
+};
+
+template<class Network>
+[[nodiscard]] constexpr auto
+get_grid_row_extent(const Network& network, std::size_t row, GridDirection direction)
+        -> GridRowExtent
+{
+    const auto num_rows = static_cast<std::size_t>(network.residual_graph().num_rows());
+    const auto num_cols = static_cast<std::size_t>(network.residual_graph().num_cols());
+    WHIRLWIND_ASSERT(row < num_rows);
+
+    switch (direction) {
+    case GridDirection::up:
+        if (row == 0) {
+            return {0, 0, row, 0};
+        }
+        return {0, num_cols, row - 1, 0};
+    case GridDirection::left:
+        if (num_cols < 2) {
+            return {0, 0, row, 0};
+        }
+        return {1, num_cols - 1, row, 0};
+    case GridDirection::down:
+        if (row + 1 == num_rows) {
+            return {0, 0, row, 0};
+        }
+        return {0, num_cols, row + 1, 0};
+    case GridDirection::right:
+        if (num_cols < 2) {
+            return {0, 0, row, 0};
+        }
+        return {0, num_cols - 1, row, 1};
+    }
+
+    WHIRLWIND_ASSERT(false);
+    return {0, 0, row, 0};
+}
+
+// Get the arc index of the first outgoing arc of a node in the specified direction.
+template<class Network>
+[[nodiscard]] constexpr auto
+get_grid_row_first_arc_id(const Network& network,
+                          const typename Network::node_type& tail,
+                          GridDirection direction) -> std::size_t
+{
+    const auto& residual_graph = network.residual_graph();
+    switch (direction) {
+    case GridDirection::up:
+        return network.get_arc_id(residual_graph.get_up_edge(tail));
+    case GridDirection::left:
+        return network.get_arc_id(residual_graph.get_left_edge(tail));
+    case GridDirection::down:
+        return network.get_arc_id(residual_graph.get_down_edge(tail));
+    case GridDirection::right:
+        return network.get_arc_id(residual_graph.get_right_edge(tail));
+    }
+
+    WHIRLWIND_ASSERT(false);
+    return 0;
+}
+
+} // namespace detail
+
+/**
+ * Get the number of arcs in a row of arcs of a grid network.
+ *
+ * A row of arcs consists of each arc emanating in the specified direction from the
+ * nodes in one row of the grid, including each parallel arc between adjacent nodes.
+ *
+ * @param[in] network
+ *     The network. Its residual graph must be a `RectangularGridGraph` or a
+ *     `FlatRectangularGridGraph`.
+ * @param[in] row
+ *     The row index of the tail nodes.
+ * @param[in] direction
+ *     The direction of the arcs.
+ *
+ * @returns
+ *     The number of arcs in the row.
+ */
+template<class Network>
+[[nodiscard]] constexpr auto
+grid_row_num_arcs(const Network& network, std::size_t row, GridDirection direction)
+        -> std::size_t
+{
+    using ResidualGraph = typename Network::residual_graph_type;
+    const auto extent = detail::get_grid_row_extent(network, row, direction);
+    return extent.num_cols * ResidualGraph::num_parallel_edges();
+}
+
+/**
+ * Compute the reduced cost of each arc in a row of arcs of a grid network.
+ *
+ * The arcs in a row (see `grid_row_num_arcs()`) have consecutive arc indices, ordered
+ * by the column of their tail node and then by their position among the parallel arcs
+ * between the same pair of nodes. Their tail nodes (and head nodes) are likewise
+ * consecutive, so unless the capacity mixin stores the arc costs itself (see
+ * `Network::arc_costs()`), the reduced costs of an entire row are computed by a single
+ * pass over contiguous runs of arc costs & node potentials, which compilers are able to
+ * vectorize. This is useful when the reduced cost of every arc must be materialized;
+ * computations that also depend on the state of each arc (e.g. its saturation) may be
+ * just as fast when visiting the outgoing arcs of each node.
+ *
+ * @param[in] network
+ *     The network. Its residual graph must be a `RectangularGridGraph` or a
+ *     `FlatRectangularGridGraph`.
+ * @param[in] row
+ *     The row index of the tail nodes.
+ * @param[in] direction
+ *     The direction of the arcs.
+ * @param[out] reduced_costs
+ *     The output reduced cost of each arc in the row, in order of increasing arc index.
+ *     Its size must be equal to `grid_row_num_arcs(network, row, direction)`.
+ *
+ * @returns
+ *     The arc index of the first arc in the row. The reduced cost of the arc with index
+ *     `first + k` is written to `reduced_costs[k]`. If the row contains no arcs, the
+ *     return value is unspecified.
+ */
+template<class Network>
+constexpr auto
+grid_row_reduced_costs(const Network& network,
+                       std::size_t row,
+                       GridDirection direction,
+                       std::span<typename Network::cost_type> reduced_costs)
+        -> std::size_t
+{
+    using ResidualGraph = typename Network::residual_graph_type;
+    using Arc = typename Network::arc_type;
+    constexpr auto num_parallel_arcs = ResidualGraph::num_parallel_edges();
+
+    const auto extent = detail::get_grid_row_extent(network, row, direction);
+    WHIRLWIND_ASSERT(std::size(reduced_costs) == extent.num_cols * num_parallel_arcs);
+    if (extent.num_cols == 0) {
+        return 0;
+    }
+
+    const auto first_tail = detail::get_grid_node(network, row, extent.first_col);
+    const auto first_head =
+            detail::get_grid_node(network, extent.head_row, extent.first_head_col);
+    const auto first_arc_id = detail::get_grid_row_first_arc_id(network, first_tail,
+                                                                 direction);
+
+    if constexpr (requires { network.arc_costs(); }) {
+        // Operate directly on the contiguous runs of arc costs & node potentials. Node
+        // indices of grid graphs are row-major linear indices.
+        const auto cost = network.arc_costs().subspan(first_arc_id);
+        const auto potential = network.relative_node_potentials();
+        const auto tail_potential = potential.subspan(network.get_node_id(first_tail));
+        const auto head_potential = potential.subspan(network.get_node_id(first_head));
+        for (std::size_t k = 0; k < extent.num_cols; ++k) {
+            const auto potential_diff = head_potential[k] - tail_potential[k];
+            for (std::size_t p = 0; p < num_parallel_arcs; ++p) {
+                const auto i = k * num_parallel_arcs + p;
+                reduced_costs[i] = cost[i] + potential_diff;
+            }
+        }
+    } else {
+        for (std::size_t k = 0; k < extent.num_cols; ++k) {
+            const auto tail = detail::get_grid_node(network, row, extent.first_col + k);
+            const auto head = detail::get_grid_node(network, extent.head_row,
+                                                    extent.first_head_col + k);
+            for (std::size_t p = 0; p < num_parallel_arcs; ++p) {
+                const auto i = k * num_parallel_arcs + p;
+                const auto arc = static_cast<Arc>(first_arc_id + i);
+                reduced_costs[i] = network.arc_reduced_cost(arc, tail, head);
+            }
+        }
+    }
+
+    return first_arc_id;
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -1,26 +1,107 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <concepts>
 #include <cstddef>
 #include <functional>
+#include <span>
 #include <type_traits>
 #include <utility>
 
 #include <range/v3/algorithm/fold_left.hpp>
+#include <range/v3/algorithm/remove_if.hpp>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/filter.hpp>
 #include <range/v3/view/transform.hpp>
 
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/bit_vector.hpp>
 #include <whirlwind/container/vector.hpp>
 #include <whirlwind/graph/graph_concepts.hpp>
 #include <whirlwind/math/numbers.hpp>
 
+#include "convex_cost.hpp"
+#include "packed_unit_capacity.hpp"
 #include "uncapacitated.hpp"
 
 WHIRLWIND_NAMESPACE_BEGIN
 
+namespace detail {
+
+// A list of the excess (or deficit) nodes of a network, maintained as node excesses are
+// updated.
+//
+// A node is appended when it becomes an excess node but isn't removed when its excess
+// is exhausted. Instead, the list may contain stale entries, which are filtered out on
+// access, so that it can be traversed while the excess of the listed nodes is reduced
+// (e.g. by augmenting flow from each excess node in turn). Each node is listed at most
+// once. Stale entries are purged before appending a node once the list has doubled in
+// size since the last purge, so updates take amortized constant time and the length
+// of the list is proportional to the number of residues.
+template<class Node, template<class> class Container>
+class ResidueList {
+public:
+    using node_type = Node;
+    using size_type = std::size_t;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    explicit constexpr ResidueList(size_type num_nodes) : is_listed_(num_nodes) {}
+
+    // The listed nodes, including stale entries, in the order they were appended.
+    [[nodiscard]] constexpr auto
+    nodes() const noexcept -> const container_type<node_type>&
+    {
+        return nodes_;
+    }
+
+    // Append a node to the list unless it's already listed. `is_residue` is a function
+    // invocable with argument `(const node_type&)` that checks whether a listed node is
+    // still a residue, and `get_node_id` returns the index of a node.
+    template<class IsResidue, class GetNodeId>
+    constexpr void
+    insert(const node_type& node,
+           size_type node_id,
+           IsResidue is_residue,
+           GetNodeId get_node_id)
+    {
+        if (is_listed_.test(node_id)) {
+            return;
+        }
+
+        if (std::size(nodes_) >= max_size_) {
+            auto it = ranges::remove_if(nodes_, [&](const auto& listed_node) {
+                if (is_residue(listed_node)) {
+                    return false;
+                }
+                is_listed_.reset(get_node_id(listed_node));
+                return true;
+            });
+            nodes_.erase(it, std::end(nodes_));
+            max_size_ = std::max(2 * std::size(nodes_), min_max_size());
+        }
+
+        nodes_.push_back(node);
+        is_listed_.set(node_id);
+    }
+
+private:
+    [[nodiscard]] static constexpr auto
+    min_max_size() noexcept -> size_type
+    {
+        return 64;
+    }
+
+    container_type<node_type> nodes_;
+    BitVector<Container> is_listed_;
+    size_type max_size_ = min_max_size();
+};
+
+} // namespace detail
+
 template<GraphType Graph,
          class Cost,
          class Flow,
@@ -64,11 +145,18 @@ public:
         : super_type(graph),
           node_excess_(std::move(surplus)),
           node_potential_(num_nodes(), zero<cost_type>()),
-          arc_cost_(make_residual_arc_costs(cost))
+          arc_cost_(init_arc_costs(make_residual_arc_costs(cost))),
+          excess_node_list_(num_nodes()),
+          deficit_node_list_(num_nodes())
     {
         WHIRLWIND_ASSERT(std::size(node_excess_) == num_nodes());
-        WHIRLWIND_DEBUG_ASSERT(std::size(arc_cost_) == num_arcs());
+        for (const auto& node : nodes()) {
+            update_residue_lists(node, get_node_id(node));
+        }
+        WHIRLWIND_DEBUG_ASSERT(std::size(arc_cost_) ==
+                               (mixin_stores_arc_costs() ? 0 : num_arcs()));
         WHIRLWIND_DEBUG_ASSERT(std::size(node_potential_) == num_nodes());
+        check_arc_costs();
     }
 
     template<class InputRange, class RandomAccessRange>
@@ -78,11 +166,53 @@ public:
         : super_type(graph),
           node_excess_(ranges::to<container_type<flow_type>>(surplus)),
           node_potential_(num_nodes(), zero<cost_type>()),
-          arc_cost_(make_residual_arc_costs(cost))
+          arc_cost_(init_arc_costs(make_residual_arc_costs(cost))),
+          excess_node_list_(num_nodes()),
+          deficit_node_list_(num_nodes())
     {
         WHIRLWIND_ASSERT(std::size(node_excess_) == num_nodes());
-        WHIRLWIND_DEBUG_ASSERT(std::size(arc_cost_) == num_arcs());
+        for (const auto& node : nodes()) {
+            update_residue_lists(node, get_node_id(node));
+        }
+        WHIRLWIND_DEBUG_ASSERT(std::size(arc_cost_) ==
+                               (mixin_stores_arc_costs() ? 0 : num_arcs()));
         WHIRLWIND_DEBUG_ASSERT(std::size(node_potential_) == num_nodes());
+        check_arc_costs();
+    }
+
+    /**
+     * Create a network with convex piecewise-linear arc costs.
+     *
+     * Each link of the graph (a run of P parallel edges between the same pair of
+     * nodes, as in `RectangularGridGraph<P>`) is assigned the P incremental costs of
+     * the corresponding link in `cost`, so that the k-th parallel edge carries the
+     * k-th unit of flow. Typically used with `ConvexCostMixin`.
+     *
+     * @param[in] graph
+     *     The network's underlying graph.
+     * @param[in] surplus
+     *     The surplus of each node.
+     * @param[in] cost
+     *     The arc cost functions. The number of segments of each function must equal
+     *     the number of parallel edges P, and the number of links must be the number
+     *     of edges of the graph divided by P.
+     */
+    template<template<class> class UContainer>
+    constexpr Network(const graph_type& graph,
+                      container_type<flow_type> surplus,
+                      const ConvexCostTable<cost_type, UContainer>& cost)
+        : Network(graph, std::move(surplus), cost.incremental_costs())
+    {
+        check_num_segments(cost);
+    }
+
+    template<class InputRange, template<class> class UContainer>
+    constexpr Network(const graph_type& graph,
+                      const InputRange& surplus,
+                      const ConvexCostTable<cost_type, UContainer>& cost)
+        : Network(graph, surplus, cost.incremental_costs())
+    {
+        check_num_segments(cost);
     }
 
     [[nodiscard]] constexpr auto
@@ -101,6 +231,7 @@ public:
         const auto node_id = get_node_id(node);
         WHIRLWIND_DEBUG_ASSERT(node_id < std::size(node_excess_));
         node_excess_[node_id] += delta;
+        update_residue_lists(node, node_id);
     }
 
     constexpr void
@@ -110,6 +241,7 @@ public:
         const auto node_id = get_node_id(node);
         WHIRLWIND_DEBUG_ASSERT(node_id < std::size(node_excess_));
         node_excess_[node_id] -= delta;
+        update_residue_lists(node, node_id);
     }
 
     [[nodiscard]] constexpr auto
@@ -126,18 +258,37 @@ public:
         return node_excess(node) < zero<flow_type>();
     }
 
+    /**
+     * Get a view of the excess nodes in the network.
+     *
+     * The excess nodes are tracked as node excesses are updated, so the view is
+     * traversed in time proportional to the number of excess nodes rather than the
+     * total number of nodes. The nodes are initially listed in order of increasing node
+     * index; nodes that later become excess nodes follow in the order they did so.
+     *
+     * The view remains valid while the excess of any node is reduced, but may be
+     * invalidated when a node becomes an excess node.
+     */
     [[nodiscard]] constexpr auto
     excess_nodes() const
     {
-        return ranges::views::filter(
-                nodes(), [&](const auto& node) { return is_excess_node(node); });
+        return ranges::views::filter(excess_node_list_.nodes(), [&](const auto& node) {
+            return is_excess_node(node);
+        });
     }
 
+    /**
+     * Get a view of the deficit nodes in the network.
+     *
+     * See `excess_nodes()`. The view remains valid while the excess of any node is
+     * increased, but may be invalidated when a node becomes a deficit node.
+     */
     [[nodiscard]] constexpr auto
     deficit_nodes() const
     {
-        return ranges::views::filter(
-                nodes(), [&](const auto& node) { return is_deficit_node(node); });
+        return ranges::views::filter(deficit_node_list_.nodes(), [&](const auto& node) {
+            return is_deficit_node(node);
+        });
     }
 
     /**
@@ -172,18 +323,46 @@ public:
     [[nodiscard]] constexpr auto
     is_balanced() const -> bool
     {
-        const auto imbalance =
-                ranges::fold_left(node_excess_, 0, std::plus<ssize_type>());
-        return imbalance == ssize_type{0};
+        return total_excess() + total_deficit() == ssize_type{0};
     }
 
+    /**
+     * Get the potential of a node.
+     *
+     * The potential of each node is stored relative to a global offset, which is
+     * shared by all nodes (see `increase_all_node_potentials()`).
+     *
+     * @param[in] node
+     *     The input node. Must be a valid node in the network.
+     *
+     * @returns
+     *     The node potential.
+     */
     [[nodiscard]] constexpr auto
-    node_potential(const node_type& node) const -> const cost_type&
+    node_potential(const node_type& node) const -> cost_type
     {
-        WHIRLWIND_ASSERT(contains_node(node));
-        const auto node_id = get_node_id(node);
-        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(node_potential_));
-        return node_potential_[node_id];
+        return relative_node_potential(node) + node_potential_offset_;
+    }
+
+    /**
+     * The potential of each node relative to the global potential offset, indexed by
+     * node index.
+     *
+     * The potential of the node with index `i` is `relative_node_potentials()[i] +
+     * node_potential_offset()`. Intended for bulk computations of reduced arc costs, in
+     * which the offset cancels out.
+     */
+    [[nodiscard]] constexpr auto
+    relative_node_potentials() const noexcept -> std::span<const cost_type>
+    {
+        return node_potential_;
+    }
+
+    /** The global offset shared by the potentials of all nodes. */
+    [[nodiscard]] constexpr auto
+    node_potential_offset() const noexcept -> const cost_type&
+    {
+        return node_potential_offset_;
     }
 
     constexpr void
@@ -204,6 +383,154 @@ public:
         node_potential_[node_id] -= delta;
     }
 
+    /**
+     * Increase the potential of every node in the network by the same amount.
+     *
+     * Takes constant time: the global potential offset is updated, rather than the
+     * potential of each node. Reduced arc costs are unaffected.
+     *
+     * @param[in] delta
+     *     The amount to add to each node potential.
+     */
+    constexpr void
+    increase_all_node_potentials(const cost_type& delta)
+    {
+        node_potential_offset_ += delta;
+    }
+
+    /**
+     * Decrease the potential of every node in the network by the same amount.
+     *
+     * See `increase_all_node_potentials()`.
+     *
+     * @param[in] delta
+     *     The amount to subtract from each node potential.
+     */
+    constexpr void
+    decrease_all_node_potentials(const cost_type& delta)
+    {
+        node_potential_offset_ -= delta;
+    }
+
+    /**
+     * Get the potential of each node, indexed by node index.
+     *
+     * Used along with `forward_arc_flows()` to save the state of a solved network, in
+     * order to warm-start a subsequent solve (see `set_node_potentials()`).
+     *
+     * @returns
+     *     The node potentials.
+     */
+    [[nodiscard]] constexpr auto
+    node_potentials() const -> container_type<cost_type>
+    {
+        auto potential = container_type<cost_type>(num_nodes());
+        for (size_type i = 0; i < num_nodes(); ++i) {
+            potential[i] = node_potential_[i] + node_potential_offset_;
+        }
+        return potential;
+    }
+
+    /**
+     * Set the potential of each node.
+     *
+     * Typically used to warm-start the network from the potentials of a previously
+     * solved network with the same underlying graph. Unless the arc costs and flows are
+     * unchanged, some unsaturated arcs may then have negative reduced costs, which
+     * must be fixed by `restore_reduced_cost_optimality()` before solving.
+     *
+     * @param[in] potential
+     *     The potential of each node, indexed by node index. Its size must be equal
+     *     to the number of nodes.
+     */
+    template<class RandomAccessRange>
+    constexpr void
+    set_node_potentials(const RandomAccessRange& potential)
+    {
+        WHIRLWIND_ASSERT(std::size(potential) == num_nodes());
+        for (size_type i = 0; i < num_nodes(); ++i) {
+            node_potential_[i] = static_cast<cost_type>(potential[i]);
+        }
+        node_potential_offset_ = zero<cost_type>();
+    }
+
+    /**
+     * Get the flow in each forward arc, indexed by edge index.
+     *
+     * The flows are indexed the same way as the arc costs passed to the constructor.
+     *
+     * @returns
+     *     The arc flows.
+     */
+    [[nodiscard]] constexpr auto
+    forward_arc_flows() const -> container_type<flow_type>
+    {
+        auto flow = container_type<flow_type>(num_forward_arcs());
+        for (const auto& arc : forward_arcs()) {
+            const auto edge_id = this->get_edge_id(arc);
+            WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(flow));
+            flow[edge_id] = arc_flow(arc);
+        }
+        return flow;
+    }
+
+    /**
+     * Set the flow in each forward arc.
+     *
+     * Typically used to warm-start the network from the flows of a previously solved
+     * network with the same underlying graph. The excess of each node is updated to
+     * account for the change in its net outflow. If the flows were those of a solution
+     * for similar node surpluses, only the nodes whose surplus differs are therefore
+     * left with nonzero excess.
+     *
+     * @param[in] flow
+     *     The flow in each forward arc, indexed by edge index (as in
+     *     `forward_arc_flows()`). Its size must be equal to the number of forward arcs.
+     *     Each flow must be nonnegative and must not exceed the capacity of the arc.
+     */
+    template<class RandomAccessRange>
+    constexpr void
+    set_forward_arc_flows(const RandomAccessRange& flow)
+    {
+        WHIRLWIND_ASSERT(std::size(flow) == num_forward_arcs());
+        for (const auto& tail : nodes()) {
+            this->for_each_outgoing_arc(tail, [&](const arc_type& arc,
+                                                  const node_type& head) {
+                if (is_forward_arc(arc)) {
+                    const auto edge_id = this->get_edge_id(arc);
+                    WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(flow));
+                    const auto new_flow = static_cast<flow_type>(flow[edge_id]);
+                    set_arc_flow(arc, tail, head, new_flow);
+                }
+            });
+        }
+    }
+
+    /**
+     * Send flow along an arc, updating the excess of its endpoints.
+     *
+     * @param[in] arc
+     *     The input arc. Must be a valid arc in the network.
+     * @param[in] tail
+     *     The tail node of the arc.
+     * @param[in] head
+     *     The head node of the arc.
+     * @param[in] delta
+     *     The amount of flow to send. Must be > 0 and <= the arc's residual capacity.
+     */
+    constexpr void
+    push_arc_flow(const arc_type& arc,
+                  const node_type& tail,
+                  const node_type& head,
+                  const flow_type& delta)
+    {
+        WHIRLWIND_ASSERT(delta > zero<flow_type>());
+        WHIRLWIND_ASSERT(this->arc_residual_capacity(arc) >= delta);
+        this->increase_arc_flow(arc, delta);
+        decrease_node_excess(tail, delta);
+        increase_node_excess(head, delta);
+    }
+
     /**
      * Get the cost per unit of flow in an arc.
      *
@@ -217,10 +544,27 @@ public:
     [[nodiscard]] constexpr auto
     arc_cost(const arc_type& arc) const -> const cost_type&
     {
-        WHIRLWIND_ASSERT(contains_arc(arc));
-        const auto arc_id = get_arc_id(arc);
-        WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(arc_cost_));
-        return arc_cost_[arc_id];
+        if constexpr (mixin_stores_arc_costs()) {
+            return super_type::arc_cost(arc);
+        } else {
+            WHIRLWIND_ASSERT(contains_arc(arc));
+            const auto arc_id = get_arc_id(arc);
+            WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(arc_cost_));
+            return arc_cost_[arc_id];
+        }
+    }
+
+    /**
+     * The unit cost of each arc, indexed by arc index.
+     *
+     * Unavailable if the capacity mixin stores the arc costs itself (e.g.
+     * `PackedUnitCapacityMixin`).
+     */
+    [[nodiscard]] constexpr auto
+    arc_costs() const noexcept -> std::span<const cost_type>
+        requires(!Network::mixin_stores_arc_costs())
+    {
+        return arc_cost_;
     }
 
     [[nodiscard]] constexpr auto
@@ -231,19 +575,31 @@ public:
         WHIRLWIND_ASSERT(contains_arc(arc));
         WHIRLWIND_ASSERT(contains_node(tail));
         WHIRLWIND_ASSERT(contains_node(head));
-        return arc_cost(arc) - node_potential(tail) + node_potential(head);
+        // The global potential offset cancels out.
+        return arc_cost(arc) - relative_node_potential(tail) +
+               relative_node_potential(head);
     }
 
     [[nodiscard]] constexpr auto
     total_cost() const -> cost_type
     {
-        auto arc_costs = ranges::views::transform(forward_arcs(), [&](const auto& arc) {
-            const auto flow = arc_flow(arc);
-            const auto cost = arc_cost(arc);
-            return cost * flow;
-        });
-        return ranges::fold_left(std::move(arc_costs), zero<cost_type>(),
-                                 std::plus<cost_type>());
+        // If the network provides it, use the bulk scan of arcs with unit flow, which
+        // skips runs of arcs without flow.
+        if constexpr (requires { this->num_saturated_forward_arcs(); }) {
+            auto cost = zero<cost_type>();
+            this->for_each_saturated_forward_arc(
+                    [&](const auto& arc) { cost += arc_cost(arc); });
+            return cost;
+        } else {
+            auto arc_costs =
+                    ranges::views::transform(forward_arcs(), [&](const auto& arc) {
+                        const auto flow = arc_flow(arc);
+                        const auto cost = arc_cost(arc);
+                        return cost * flow;
+                    });
+            return ranges::fold_left(std::move(arc_costs), zero<cost_type>(),
+                                     std::plus<cost_type>());
+        }
     }
 
 protected:
@@ -265,7 +621,8 @@ protected:
                        WHIRLWIND_ASSERT(cost >= zero<cost_type>());
                        return cost;
                    } else {
-                       const auto transpose_arc = this->get_transpose_arc_id(arc);
+                       const auto transpose_arc =
+                               static_cast<arc_type>(this->get_transpose_arc_id(arc));
                        const auto edge_id = this->get_edge_id(transpose_arc);
 
                        WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(forward_cost));
@@ -281,9 +638,101 @@ protected:
     }
 
 private:
+    // Set the flow in a forward arc by pushing the difference along the arc or back
+    // along its transpose.
+    constexpr void
+    set_arc_flow(const arc_type& arc,
+                 const node_type& tail,
+                 const node_type& head,
+                 const flow_type& new_flow)
+    {
+        WHIRLWIND_ASSERT(is_forward_arc(arc));
+        WHIRLWIND_ASSERT(new_flow >= zero<flow_type>());
+
+        const auto old_flow = arc_flow(arc);
+        if (new_flow > old_flow) {
+            push_arc_flow(arc, tail, head, new_flow - old_flow);
+        } else if (new_flow < old_flow) {
+            const auto transpose_arc =
+                    static_cast<arc_type>(this->get_transpose_arc_id(arc));
+            push_arc_flow(transpose_arc, head, tail, old_flow - new_flow);
+        }
+    }
+
+    // Get the potential of a node relative to the global potential offset.
+    [[nodiscard]] constexpr auto
+    relative_node_potential(const node_type& node) const -> const cost_type&
+    {
+        WHIRLWIND_ASSERT(contains_node(node));
+        const auto node_id = get_node_id(node);
+        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(node_potential_));
+        return node_potential_[node_id];
+    }
+
+    // Add a node to the list of excess or deficit nodes if it's not already listed.
+    constexpr void
+    update_residue_lists(const node_type& node, size_type node_id)
+    {
+        auto get_id = [&](const node_type& n) { return get_node_id(n); };
+        if (is_excess_node(node)) {
+            auto is_excess = [&](const node_type& n) { return is_excess_node(n); };
+            excess_node_list_.insert(node, node_id, is_excess, get_id);
+        } else if (is_deficit_node(node)) {
+            auto is_deficit = [&](const node_type& n) { return is_deficit_node(n); };
+            deficit_node_list_.insert(node, node_id, is_deficit, get_id);
+        }
+    }
+
+    // Check whether the mixin stores the arc costs alongside its own per-arc state
+    // (e.g. `PackedUnitCapacityMixin`), in which case `arc_cost_` is left empty.
+    [[nodiscard]] static constexpr auto
+    mixin_stores_arc_costs() noexcept -> bool
+    {
+        return requires(const super_type& mixin, const arc_type& arc) {
+            { mixin.arc_cost(arc) } -> std::same_as<const cost_type&>;
+        };
+    }
+
+    // Hand the residual arc costs over to the mixin if it stores them. Returns the
+    // contents of `arc_cost_`.
+    [[nodiscard]] constexpr auto
+    init_arc_costs(container_type<cost_type> cost) -> container_type<cost_type>
+    {
+        if constexpr (mixin_stores_arc_costs()) {
+            super_type::set_arc_costs(cost);
+            return {};
+        } else {
+            return cost;
+        }
+    }
+
+    // Let the mixin check the arc costs if it places any requirements on them (e.g.
+    // `ConvexCostMixin`).
+    constexpr void
+    check_arc_costs() const
+    {
+        if constexpr (requires(const super_type& mixin) {
+                          mixin.check_arc_costs(arc_cost_);
+                      }) {
+            super_type::check_arc_costs(arc_cost_);
+        }
+    }
+
+    template<class CostTable>
+    static constexpr void
+    check_num_segments([[maybe_unused]] const CostTable& cost)
+    {
+        if constexpr (requires { graph_type::num_parallel_edges(); }) {
+            WHIRLWIND_ASSERT(cost.num_segments() == graph_type::num_parallel_edges());
+        }
+    }
+
     container_type<flow_type> node_excess_;
     container_type<cost_type> node_potential_;
+    cost_type node_potential_offset_ = zero<cost_type>();
     container_type<cost_type> arc_cost_;
+    detail::ResidueList<node_type, Container> excess_node_list_;
+    detail::ResidueList<node_type, Container> deficit_node_list_;
 };
 
 WHIRLWIND_NAMESPACE_END
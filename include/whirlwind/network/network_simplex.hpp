@@ -0,0 +1,601 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <range/v3/range/conversion.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/logging/null_logger.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A minimum cost flow solver based on the primal network simplex algorithm.
+ *
+ * The solver maintains a strongly feasible spanning tree basis over the network's
+ * nodes plus an artificial root node, which is initially connected to every other node
+ * by a high-cost artificial arc. Each pivot selects an entering arc using block search
+ * (scanning the arcs of the residual graph in fixed-size blocks, in round-robin order,
+ * and choosing the arc with the most negative reduced cost within the first block that
+ * contains any eligible arc), augments flow around the cycle it forms with the tree,
+ * and replaces the leaving arc with the entering arc.
+ *
+ * The solver works on the network in place: the basis is formed from arcs of the
+ * network's residual graph, and flow is pushed directly along them, starting from the
+ * network's existing flow. The flow in the artificial arc of each node is the node's
+ * excess, so it isn't stored separately. Once solved, the node potentials are set to
+ * the optimal dual solution, so that every unsaturated arc in the residual graph has
+ * nonnegative reduced cost.
+ *
+ * @tparam Network
+ *     The network type. Its cost type must be integral.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store per-node state.
+ */
+template<class Network, template<class> class Container = Vector>
+class NetworkSimplex {
+public:
+    using network_type = Network;
+    using node_type = typename network_type::node_type;
+    using arc_type = typename network_type::arc_type;
+    using cost_type = typename network_type::cost_type;
+    using flow_type = typename network_type::flow_type;
+    using potential_type = std::int64_t;
+    using size_type = std::size_t;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<cost_type>);
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<flow_type>);
+
+    /**
+     * Create a new solver for the specified network.
+     *
+     * The existing flow in the network is taken as the starting point: the initial
+     * basis routes the excess of each node to (or from) the root.
+     *
+     * @param[in,out] network
+     *     The network. Must be balanced.
+     * @param[in] block_size
+     *     The number of arcs examined per block during the entering arc search. If
+     *     zero, the square root of the number of arcs is used.
+     */
+    explicit constexpr NetworkSimplex(network_type& network, size_type block_size = 0)
+        : network_(&network),
+          nodes_(network.nodes() | ranges::to<container_type<node_type>>())
+    {
+        WHIRLWIND_ASSERT(network.is_balanced());
+
+        init_tree();
+
+        if (block_size == 0) {
+            const auto m = static_cast<double>(network.num_arcs());
+            block_size = static_cast<size_type>(std::sqrt(m));
+        }
+        block_size_ = std::max(block_size, size_type{10});
+    }
+
+    /** The network. */
+    [[nodiscard]] constexpr auto
+    network() const noexcept -> const network_type&
+    {
+        return *network_;
+    }
+
+    /** The network. */
+    [[nodiscard]] constexpr auto
+    network() noexcept -> network_type&
+    {
+        return *network_;
+    }
+
+    /** The number of arcs examined per block during the entering arc search. */
+    [[nodiscard]] constexpr auto
+    block_size() const noexcept -> size_type
+    {
+        return block_size_;
+    }
+
+    /** The total number of pivots performed so far. */
+    [[nodiscard]] constexpr auto
+    num_pivots() const noexcept -> size_type
+    {
+        return num_pivots_;
+    }
+
+    /**
+     * Solve the minimum cost flow problem and write the optimal potentials to the
+     * network.
+     *
+     * Throws `std::overflow_error` if any optimal potential can't be represented by
+     * the network's cost type, in which case the network is left with the optimal
+     * flow but its node potentials are unchanged.
+     */
+    template<class Logger = NullLogger>
+    constexpr void
+    run()
+    {
+        auto logger = Logger("whirlwind.network.network_simplex");
+
+        auto in_arc = ResidualArc();
+        while (find_entering_arc(in_arc)) {
+            pivot(in_arc);
+            ++num_pivots_;
+
+            if (num_pivots_ % 10000 == 0) {
+                logger.info("Pivot {}", num_pivots_);
+            }
+        }
+        logger.info("Done after {} pivots", num_pivots_);
+
+        write_potentials();
+    }
+
+protected:
+    // The direction of an arc between a tree node and its parent: `up` if the arc is
+    // oriented from the node to its parent, `down` if it's oriented from the parent to
+    // the node.
+    enum Direction : std::int8_t { up = 1, down = -1 };
+
+    // An arc of the network's residual graph, or an artificial arc between a node and
+    // the root (in which case `arc` is unused), identified by its endpoints' node ids.
+    struct ResidualArc {
+        size_type tail = 0;
+        size_type head = 0;
+        arc_type arc = {};
+    };
+
+    [[nodiscard]] static constexpr auto
+    npos() noexcept -> size_type
+    {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    [[nodiscard]] constexpr auto
+    num_nodes() const noexcept -> size_type
+    {
+        return std::size(nodes_);
+    }
+
+    [[nodiscard]] constexpr auto
+    root() const noexcept -> size_type
+    {
+        return num_nodes();
+    }
+
+    [[nodiscard]] constexpr auto
+    is_artificial(const ResidualArc& arc) const noexcept -> bool
+    {
+        return (arc.tail == root()) || (arc.head == root());
+    }
+
+    [[nodiscard]] constexpr auto
+    get_transpose_arc(const arc_type& arc) const -> arc_type
+    {
+        return static_cast<arc_type>(network().get_transpose_arc_id(arc));
+    }
+
+    // The flow in the artificial arc of each node is its excess, measured in the
+    // direction from the node to the root. Artificial arcs are oriented such that
+    // their flow is initially nonnegative and is bounded by the total supply.
+    [[nodiscard]] constexpr auto
+    artificial_residual_capacity(size_type node_id, Direction direction) const
+            -> flow_type
+    {
+        const auto& excess = network().node_excess(nodes_[node_id]);
+        if (artificial_direction_[node_id] == Direction::up) {
+            return (direction == Direction::up) ? max_capacity_ - excess : excess;
+        }
+        return (direction == Direction::up) ? -excess : max_capacity_ + excess;
+    }
+
+    [[nodiscard]] constexpr auto
+    residual_capacity(const ResidualArc& arc) const -> flow_type
+    {
+        if (arc.head == root()) {
+            return artificial_residual_capacity(arc.tail, Direction::up);
+        }
+        if (arc.tail == root()) {
+            return artificial_residual_capacity(arc.head, Direction::down);
+        }
+        return network().arc_residual_capacity(arc.arc);
+    }
+
+    [[nodiscard]] constexpr auto
+    reduced_cost(const ResidualArc& arc) const -> potential_type
+    {
+        auto cost = potential_type{0};
+        if (arc.head == root()) {
+            cost = (artificial_direction_[arc.tail] == Direction::up)
+                           ? artificial_cost_
+                           : -artificial_cost_;
+        } else if (arc.tail == root()) {
+            cost = (artificial_direction_[arc.head] == Direction::down)
+                           ? artificial_cost_
+                           : -artificial_cost_;
+        } else {
+            cost = static_cast<potential_type>(network().arc_cost(arc.arc));
+        }
+        return cost - potential_[arc.tail] + potential_[arc.head];
+    }
+
+    // The tree arc between a node and its parent, in the specified direction.
+    [[nodiscard]] constexpr auto
+    get_tree_arc(size_type node_id, Direction direction) const -> ResidualArc
+    {
+        const auto parent = parent_[node_id];
+        if (direction == Direction::down) {
+            return {parent, node_id, pred_[node_id]};
+        }
+        if (parent == root()) {
+            return {node_id, parent, pred_[node_id]};
+        }
+        return {node_id, parent, get_transpose_arc(pred_[node_id])};
+    }
+
+    // Push flow along an arc. Pushing flow along an artificial arc has no effect since
+    // it's always part of a cycle, along which the excess of the non-root endpoint is
+    // updated by the flow pushed along its other incident arc.
+    constexpr void
+    push_flow(const ResidualArc& arc, const flow_type& delta)
+    {
+        if (is_artificial(arc)) {
+            return;
+        }
+        network().increase_arc_flow(arc.arc, delta);
+        network().decrease_node_excess(nodes_[arc.tail], delta);
+        network().increase_node_excess(nodes_[arc.head], delta);
+    }
+
+    // Build the initial (strongly feasible) basis, in which each node is a child of the
+    // root, connected by an artificial arc that carries the node's excess.
+    constexpr void
+    init_tree()
+    {
+        // Bound the capacity of each artificial arc by the total supply, which is an
+        // upper bound on the flow in any artificial arc.
+        max_capacity_ = zero<flow_type>();
+        for (const auto& node : nodes_) {
+            max_capacity_ += std::max(network().node_excess(node), zero<flow_type>());
+        }
+
+        // The cost of each artificial arc must exceed the cost of any path in the
+        // network.
+        auto max_cost = potential_type{0};
+        for (const auto& node : nodes_) {
+            network().for_each_outgoing_arc(
+                    node, [&](const arc_type& arc, const node_type&) {
+                        const auto cost =
+                                static_cast<potential_type>(network().arc_cost(arc));
+                        max_cost = std::max(max_cost, (cost < 0) ? -cost : cost);
+                    });
+        }
+        artificial_cost_ = (max_cost + 1) * static_cast<potential_type>(num_nodes());
+
+        const auto n = num_nodes() + 1;
+        parent_ = container_type<size_type>(n, npos());
+        pred_ = container_type<arc_type>(n);
+        artificial_direction_ = container_type<Direction>(n, Direction::up);
+        depth_ = container_type<size_type>(n, 0);
+        first_child_ = container_type<size_type>(n, npos());
+        next_sibling_ = container_type<size_type>(n, npos());
+        prev_sibling_ = container_type<size_type>(n, npos());
+        potential_ = container_type<potential_type>(n, 0);
+
+        for (size_type node_id = 0; node_id < num_nodes(); ++node_id) {
+            if (network().node_excess(nodes_[node_id]) >= zero<flow_type>()) {
+                artificial_direction_[node_id] = Direction::up;
+                potential_[node_id] = artificial_cost_;
+            } else {
+                artificial_direction_[node_id] = Direction::down;
+                potential_[node_id] = -artificial_cost_;
+            }
+            depth_[node_id] = 1;
+            add_child(root(), node_id);
+        }
+    }
+
+    constexpr void
+    add_child(size_type parent, size_type child)
+    {
+        parent_[child] = parent;
+        prev_sibling_[child] = npos();
+        next_sibling_[child] = first_child_[parent];
+        if (first_child_[parent] != npos()) {
+            prev_sibling_[first_child_[parent]] = child;
+        }
+        first_child_[parent] = child;
+    }
+
+    constexpr void
+    remove_child(size_type parent, size_type child)
+    {
+        const auto prev = prev_sibling_[child];
+        const auto next = next_sibling_[child];
+        if (prev == npos()) {
+            WHIRLWIND_DEBUG_ASSERT(first_child_[parent] == child);
+            first_child_[parent] = next;
+        } else {
+            next_sibling_[prev] = next;
+        }
+        if (next != npos()) {
+            prev_sibling_[next] = prev;
+        }
+    }
+
+    // Find an arc to enter the basis using block search over the outgoing arcs of each
+    // node (including its artificial arcs), in round-robin order of nodes. Returns
+    // false if there are no eligible arcs (i.e. the current solution is optimal).
+    [[nodiscard]] constexpr auto
+    find_entering_arc(ResidualArc& in_arc) -> bool
+    {
+        auto min_reduced_cost = potential_type{0};
+        size_type count = 0;
+
+        const auto check_arc = [&](const ResidualArc& arc) {
+            const auto cost = reduced_cost(arc);
+            if ((cost < min_reduced_cost) &&
+                (residual_capacity(arc) > zero<flow_type>())) {
+                min_reduced_cost = cost;
+                in_arc = arc;
+            }
+            ++count;
+        };
+
+        auto node_id = next_node_;
+        for (size_type i = 0; i < num_nodes(); ++i) {
+            check_arc({node_id, root()});
+            check_arc({root(), node_id});
+            network().for_each_outgoing_arc(
+                    nodes_[node_id], [&](const arc_type& arc, const node_type& head) {
+                        check_arc({node_id, network().get_node_id(head), arc});
+                    });
+
+            node_id = (node_id + 1 == num_nodes()) ? 0 : node_id + 1;
+
+            if (count >= block_size()) {
+                if (min_reduced_cost < 0) {
+                    next_node_ = node_id;
+                    return true;
+                }
+                count = 0;
+            }
+        }
+
+        next_node_ = node_id;
+        return min_reduced_cost < 0;
+    }
+
+    [[nodiscard]] constexpr auto
+    find_join_node(size_type u, size_type v) const -> size_type
+    {
+        while (u != v) {
+            if (depth_[u] < depth_[v]) {
+                v = parent_[v];
+            } else {
+                u = parent_[u];
+            }
+        }
+        return u;
+    }
+
+    // Pivot on the specified entering arc: augment flow around the cycle that it forms
+    // with the basis and then update the basis.
+    constexpr void
+    pivot(const ResidualArc& in_arc)
+    {
+        // Flow is pushed along the entering arc from its tail to its head and then back
+        // around the cycle through the tree.
+        const auto join = find_join_node(in_arc.tail, in_arc.head);
+
+        // Find the leaving arc -- the arc with the min residual capacity along the
+        // cycle. Ties are broken by choosing the last such arc in the direction of the
+        // cycle starting from the join node, which preserves strong feasibility.
+        auto delta = residual_capacity(in_arc);
+        auto u_out = npos();
+        auto leaving_side = 0;
+
+        for (auto u = in_arc.tail; u != join; u = parent_[u]) {
+            const auto residual = residual_capacity(get_tree_arc(u, Direction::down));
+            if (residual < delta) {
+                delta = residual;
+                u_out = u;
+                leaving_side = 1;
+            }
+        }
+        for (auto u = in_arc.head; u != join; u = parent_[u]) {
+            const auto residual = residual_capacity(get_tree_arc(u, Direction::up));
+            if (residual <= delta) {
+                delta = residual;
+                u_out = u;
+                leaving_side = 2;
+            }
+        }
+
+        // Augment flow around the cycle.
+        if (delta > zero<flow_type>()) {
+            push_flow(in_arc, delta);
+            for (auto u = in_arc.tail; u != join; u = parent_[u]) {
+                push_flow(get_tree_arc(u, Direction::down), delta);
+            }
+            for (auto u = in_arc.head; u != join; u = parent_[u]) {
+                push_flow(get_tree_arc(u, Direction::up), delta);
+            }
+        }
+
+        // If the entering arc is also the leaving arc, it's now saturated and remains
+        // outside the basis.
+        if (leaving_side == 0) {
+            return;
+        }
+
+        // The subtree rooted at `u_out`, which contains `u_in`, is detached and
+        // reattached via the entering arc.
+        const auto u_in = (leaving_side == 1) ? in_arc.tail : in_arc.head;
+        const auto v_in = (leaving_side == 1) ? in_arc.head : in_arc.tail;
+        update_tree(in_arc, u_in, v_in, u_out);
+    }
+
+    // Replace the predecessor arc of `u_out` with the entering arc (`u_in`,`v_in`) by
+    // reversing the tree path from `u_in` to `u_out` and then updating the depth and
+    // potential of each node in the subtree now rooted at `u_in`.
+    constexpr void
+    update_tree(const ResidualArc& in_arc,
+                size_type u_in,
+                size_type v_in,
+                size_type u_out)
+    {
+        // The potential of each node in the subtree changes by the same amount such
+        // that the entering arc has zero reduced cost.
+        const auto sigma = (u_in == in_arc.tail) ? reduced_cost(in_arc)
+                                                 : -reduced_cost(in_arc);
+
+        // Each predecessor arc is oriented from the parent to the child.
+        const auto in_pred = ((u_in == in_arc.head) || is_artificial(in_arc))
+                                     ? in_arc.arc
+                                     : get_transpose_arc(in_arc.arc);
+
+        remove_child(parent_[u_out], u_out);
+
+        auto u = u_in;
+        auto new_parent = v_in;
+        auto new_pred = in_pred;
+        while (true) {
+            const auto old_parent = parent_[u];
+            const auto old_pred = pred_[u];
+            if (u != u_out) {
+                remove_child(old_parent, u);
+            }
+
+            add_child(new_parent, u);
+            pred_[u] = new_pred;
+
+            if (u == u_out) {
+                break;
+            }
+
+            // The old parent of `u` is below `u_out`, so it isn't the root, and its
+            // new predecessor arc is the reverse of the old predecessor arc of `u`.
+            new_parent = u;
+            new_pred = get_transpose_arc(old_pred);
+            u = old_parent;
+        }
+
+        // Traverse the subtree in depth-first order.
+        stack_.clear();
+        stack_.push_back(u_in);
+        while (!std::empty(stack_)) {
+            const auto v = stack_.back();
+            stack_.pop_back();
+
+            depth_[v] = depth_[parent_[v]] + 1;
+            potential_[v] += sigma;
+
+            for (auto w = first_child_[v]; w != npos(); w = next_sibling_[w]) {
+                stack_.push_back(w);
+            }
+        }
+    }
+
+    // Set the node potentials of the network to those of the current basis.
+    constexpr void
+    write_potentials()
+    {
+        // Potentials are relative to the root, so any constant offset is irrelevant.
+        // They're shifted such that the largest potential is zero, which minimizes
+        // their magnitude. Each must then be representable by `cost_type`: potentials
+        // may be as large as the total cost of a path through every node, which may
+        // overflow narrow cost types on large networks. All of them are checked before
+        // any is modified.
+        auto max_potential = std::numeric_limits<potential_type>::lowest();
+        for (size_type node_id = 0; node_id < num_nodes(); ++node_id) {
+            max_potential = std::max(max_potential, potential_[node_id]);
+        }
+        for (size_type node_id = 0; node_id < num_nodes(); ++node_id) {
+            const auto shifted_potential = potential_[node_id] - max_potential;
+            if (!std::in_range<cost_type>(shifted_potential)) WHIRLWIND_UNLIKELY {
+                throw std::overflow_error("node potential overflows the cost type");
+            }
+        }
+
+        for (size_type node_id = 0; node_id < num_nodes(); ++node_id) {
+            const auto& node = nodes_[node_id];
+
+            // Any excess remaining at a node is flow in its artificial arc, which
+            // indicates that the problem was infeasible.
+            WHIRLWIND_ASSERT(network().node_excess(node) == zero<flow_type>());
+
+            const auto shifted_potential = potential_[node_id] - max_potential;
+            const auto potential = static_cast<cost_type>(shifted_potential);
+            const auto delta = potential - network().node_potential(node);
+            network().increase_node_potential(node, delta);
+        }
+    }
+
+private:
+    network_type* network_;
+    container_type<node_type> nodes_;
+
+    // The capacity & unit cost of each artificial arc.
+    flow_type max_capacity_ = zero<flow_type>();
+    potential_type artificial_cost_ = 0;
+
+    // Node data, including the root. The predecessor arc of each tree node is the arc
+    // from its parent in the network's residual graph (unused for children of the
+    // root). Each tree node's children form a doubly-linked list.
+    container_type<size_type> parent_ = {};
+    container_type<arc_type> pred_ = {};
+    container_type<Direction> artificial_direction_ = {};
+    container_type<size_type> depth_ = {};
+    container_type<size_type> first_child_ = {};
+    container_type<size_type> next_sibling_ = {};
+    container_type<size_type> prev_sibling_ = {};
+    container_type<potential_type> potential_ = {};
+
+    container_type<size_type> stack_ = {};
+    size_type block_size_ = 0;
+    size_type next_node_ = 0;
+    size_type num_pivots_ = 0;
+};
+
+/**
+ * Solve a minimum cost flow problem using the primal network simplex algorithm.
+ *
+ * This is a drop-in alternative to `primal_dual()` and `successive_shortest_paths()`.
+ * In addition to the optimal flow, the network's node potentials are set to an optimal
+ * dual solution.
+ *
+ * @tparam Logger
+ *     The logger type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the solver's state.
+ *
+ * @param[in,out] network
+ *     The network. Must be balanced and have integral costs.
+ * @param[in] block_size
+ *     The number of arcs examined per block during the entering arc search. If zero,
+ *     the square root of the number of arcs is used.
+ */
+template<class Logger = NullLogger,
+         template<class> class Container = Vector,
+         class Network>
+constexpr void
+network_simplex(Network& network, std::size_t block_size = 0)
+{
+    auto solver = NetworkSimplex<Network, Container>(network, block_size);
+    solver.template run<Logger>();
+}
+
+WHIRLWIND_NAMESPACE_END
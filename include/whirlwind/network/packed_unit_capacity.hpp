@@ -0,0 +1,318 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/graph_concepts.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+#include "residual_graph.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+namespace detail {
+
+// The per-arc state of `PackedUnitCapacityMixin`: the arc's unit cost and saturation
+// state, plus the index of its transpose arc if it's not computed arithmetically by the
+// residual graph mixin.
+template<class Cost, class ArcId, bool StoreTranspose>
+struct PackedArcRecord {
+    Cost cost;
+    ArcId transpose_arc_id;
+    bool is_saturated;
+};
+
+template<class Cost, class ArcId>
+struct PackedArcRecord<Cost, ArcId, false> {
+    Cost cost;
+    bool is_saturated;
+};
+
+} // namespace detail
+
+/**
+ * A unit-capacity mixin that stores the state of each arc in a single packed record.
+ *
+ * By default, the unit cost, saturation state & transpose of each arc are stored in
+ * separate containers (by `Network`, `UnitCapacityMixin` & `ResidualGraphMixin`,
+ * respectively), so relaxing an arc touches up to three distinct cache lines in
+ * addition to the potentials of its endpoints. This mixin instead stores an array of
+ * records (cost, saturation state and, for graphs whose transpose arcs aren't computed
+ * arithmetically, the transpose arc index), so that each of them is fetched by a
+ * single memory access. The transpose arc indices are then stored only in the
+ * records: the residual graph mixin's own array of transposes is released after
+ * construction. `Network` detects that the mixin stores the arc costs and forwards
+ * `arc_cost()` to it.
+ *
+ * The packed layout trades the compactness of the default layout for locality of
+ * access to individual arcs. Which is faster depends on the network: the default
+ * layout's saturation bits are small enough to remain cached on moderately large
+ * networks, in which case the costs of saturated arcs are never loaded, whereas the
+ * packed layout loads a single record per arc regardless of its state. Each record is
+ * also larger than the cost alone, and `Network::total_cost()` falls back to visiting
+ * each forward arc. See `bench/network/bench_arc_layout.cpp` for a comparison.
+ *
+ * @tparam Graph
+ *     The graph type.
+ * @tparam Cost
+ *     The cost type. Must match the cost type of the `Network`.
+ * @tparam Flow
+ *     The flow type.
+ * @tparam Container
+ *     A `std::vector`-like type template.
+ * @tparam ResidualGraphMixin
+ *     The residual graph mixin.
+ */
+template<GraphType Graph,
+         class Cost,
+         class Flow,
+         template<class> class Container = Vector,
+         class ResidualGraphMixin = ResidualGraphMixin<Graph, Container>>
+class PackedUnitCapacityMixin : public ResidualGraphMixin {
+private:
+    using super_type = ResidualGraphMixin;
+
+public:
+    using node_type = typename super_type::node_type;
+    using arc_type = typename super_type::arc_type;
+    using size_type = typename super_type::size_type;
+    using cost_type = Cost;
+    using flow_type = Flow;
+
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<flow_type>);
+
+    template<class T>
+    using container_type = Container<T>;
+
+    using super_type::arcs;
+    using super_type::contains_arc;
+    using super_type::get_arc_id;
+    using super_type::is_forward_arc;
+    using super_type::num_arcs;
+
+    /** True if each arc record stores the index of the arc's transpose. */
+    [[nodiscard]] static constexpr auto
+    stores_transpose_arc_ids() noexcept -> bool
+    {
+        return !std::is_base_of_v<detail::GridResidualGraphMixin<Graph>, super_type>;
+    }
+
+    using arc_record_type =
+            detail::PackedArcRecord<cost_type, arc_type, stores_transpose_arc_ids()>;
+
+    [[nodiscard]] constexpr auto
+    get_transpose_arc_id(const arc_type& arc) const -> size_type
+    {
+        if constexpr (stores_transpose_arc_ids()) {
+            return static_cast<size_type>(arc_record(arc).transpose_arc_id);
+        } else {
+            return super_type::get_transpose_arc_id(arc);
+        }
+    }
+
+    /**
+     * Invoke a function on each incoming arc (and corresponding tail node) of a node.
+     *
+     * See `ResidualGraphMixin::for_each_incoming_arc()`.
+     *
+     * @param[in] node
+     *     The input node. Must be a valid node in the network.
+     * @param[in] visitor
+     *     A function invocable with arguments `(const arc_type&, const node_type&)`.
+     */
+    template<class Visitor>
+    constexpr void
+    for_each_incoming_arc(const node_type& node, Visitor visitor) const
+    {
+        this->for_each_outgoing_arc(node, [&](const auto& arc, const auto& tail) {
+            const auto transpose_arc = static_cast<arc_type>(get_transpose_arc_id(arc));
+            visitor(transpose_arc, tail);
+        });
+    }
+
+    /**
+     * Get the cost per unit of flow in an arc.
+     *
+     * @param[in] arc
+     *     The input arc. Must be a valid arc in the network's residual graph (though
+     *     its residual capacity may be zero).
+     *
+     * @returns
+     *     The unit cost of flow in the arc.
+     */
+    [[nodiscard]] constexpr auto
+    arc_cost(const arc_type& arc) const -> const cost_type&
+    {
+        return arc_record(arc).cost;
+    }
+
+    /**
+     * Get the upper capacity of an arc in the network.
+     *
+     * @param[in] arc
+     *     The input arc. Must be a valid arc in the network's residual graph (though
+     *     its residual capacity may be zero).
+     *
+     * @returns
+     *     The upper capacity of the arc.
+     */
+    [[nodiscard]] constexpr auto
+    arc_capacity([[maybe_unused]] const arc_type& arc) const -> flow_type
+    {
+        WHIRLWIND_ASSERT(contains_arc(arc));
+        return one<flow_type>();
+    }
+
+    /**
+     * Check whether an arc is saturated.
+     *
+     * @param[in] arc
+     *     The input arc. Must be a valid arc in the network's residual graph (though
+     *     its residual capacity may be zero).
+     *
+     * @returns
+     *     True if the arc is saturated (i.e. its residual capacity is zero); otherwise
+     *     false.
+     */
+    [[nodiscard]] constexpr auto
+    is_arc_saturated(const arc_type& arc) const -> bool
+    {
+        return arc_record(arc).is_saturated;
+    }
+
+    /**
+     * Get the residual capacity of an arc.
+     *
+     * @param[in] arc
+     *     The input arc. Must be a valid arc in the network's residual graph (though
+     *     its residual capacity may be zero).
+     *
+     * @returns
+     *     The residual capacity of the arc.
+     */
+    [[nodiscard]] constexpr auto
+    arc_residual_capacity(const arc_type& arc) const -> flow_type
+    {
+        return is_arc_saturated(arc) ? zero<flow_type>() : one<flow_type>();
+    }
+
+    /**
+     * Get the amount of flow in an arc.
+     *
+     * @param[in] arc
+     *     The input arc. Must be a valid arc in the network's residual graph (though
+     *     its residual capacity may be zero).
+     *
+     * @returns
+     *     The amount of flow in the arc.
+     */
+    [[nodiscard]] constexpr auto
+    arc_flow(const arc_type& arc) const -> flow_type
+    {
+        return is_arc_saturated(arc) ? one<flow_type>() : zero<flow_type>();
+    }
+
+    /**
+     * Invoke a function on each unsaturated outgoing arc (and corresponding head node)
+     * of a node.
+     *
+     * See `UnitCapacityMixin::for_each_unsaturated_outgoing_arc()`.
+     *
+     * @param[in] node
+     *     The input node. Must be a valid node in the network.
+     * @param[in] visitor
+     *     A function invocable with arguments `(const arc_type&, const node_type&)`.
+     */
+    template<class Visitor>
+    constexpr void
+    for_each_unsaturated_outgoing_arc(const node_type& node, Visitor visitor) const
+    {
+        this->for_each_outgoing_arc(node, [&](const auto& arc, const auto& head) {
+            if (!is_arc_saturated(arc)) {
+                visitor(arc, head);
+            }
+        });
+    }
+
+    /**
+     * Increase flow in an arc.
+     *
+     * See `UnitCapacityMixin::increase_arc_flow()`.
+     *
+     * @param[in] arc
+     *     The input arc. Must be a valid, unsaturated arc in the network.
+     * @param[in] delta
+     *     The amount of additional flow to add to the arc. Must be 1.
+     */
+    constexpr void
+    increase_arc_flow(const arc_type& arc, [[maybe_unused]] const flow_type& delta)
+    {
+        WHIRLWIND_ASSERT(!is_arc_saturated(arc));
+        WHIRLWIND_ASSERT(delta == one<flow_type>());
+        const auto transpose_arc = static_cast<arc_type>(get_transpose_arc_id(arc));
+        arc_record(arc).is_saturated = true;
+        arc_record(transpose_arc).is_saturated = false;
+    }
+
+protected:
+    template<class... Args>
+    constexpr PackedUnitCapacityMixin(Args&&... args)
+        : super_type(std::forward<Args>(args)...), arc_records_(num_arcs())
+    {
+        // Initially, each forward arc is empty & each reverse arc is saturated.
+        for (const auto& arc : arcs()) {
+            auto& record = arc_record(arc);
+            record.cost = zero<cost_type>();
+            record.is_saturated = !is_forward_arc(arc);
+        }
+        WHIRLWIND_DEBUG_ASSERT(std::size(arc_records_) == num_arcs());
+
+        // Move the transpose of each arc into its record, so that it isn't stored
+        // twice.
+        if constexpr (stores_transpose_arc_ids()) {
+            const auto transpose_arc_id = super_type::release_transpose_arc_ids();
+            WHIRLWIND_ASSERT(std::size(transpose_arc_id) == num_arcs());
+            for (size_type i = 0; i < num_arcs(); ++i) {
+                arc_records_[i].transpose_arc_id = transpose_arc_id[i];
+            }
+        }
+    }
+
+    // Set the unit cost of each arc, indexed by arc index. Called by `Network`.
+    template<class RandomAccessRange>
+    constexpr void
+    set_arc_costs(const RandomAccessRange& cost)
+    {
+        WHIRLWIND_ASSERT(std::size(cost) == num_arcs());
+        for (size_type i = 0; i < num_arcs(); ++i) {
+            arc_records_[i].cost = cost[i];
+        }
+    }
+
+private:
+    [[nodiscard]] constexpr auto
+    arc_record(const arc_type& arc) const -> const arc_record_type&
+    {
+        WHIRLWIND_ASSERT(contains_arc(arc));
+        const auto arc_id = get_arc_id(arc);
+        WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(arc_records_));
+        return arc_records_[arc_id];
+    }
+
+    [[nodiscard]] constexpr auto
+    arc_record(const arc_type& arc) -> arc_record_type&
+    {
+        WHIRLWIND_ASSERT(contains_arc(arc));
+        const auto arc_id = get_arc_id(arc);
+        WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(arc_records_));
+        return arc_records_[arc_id];
+    }
+
+    container_type<arc_record_type> arc_records_;
+};
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,720 @@
+#pragma once
+
+#include <algorithm>
+#include <barrier>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <range/v3/algorithm/sort.hpp>
+#include <range/v3/algorithm/unique.hpp>
+#include <range/v3/range/conversion.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/common/parallel.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/logging/null_logger.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+#include "primal_dual.hpp"
+#include "successive_shortest_paths.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A multithreaded implementation of a single primal-dual iteration.
+ *
+ * The nodes of the network are partitioned into contiguous ranges of node indices
+ * ("strips" -- for a grid graph, each is a band of consecutive rows), one per thread.
+ * Each thread owns the shortest path state and the buckets of the nodes in its strip.
+ *
+ * Shortest paths from all excess nodes are found using a bulk-synchronous variant of
+ * the delta-stepping algorithm. The nodes in the current bucket are processed
+ * concurrently, with chunks of work distributed by a `WorkStealingScheduler`. Rather
+ * than updating the distance to each arc's head directly, each thread sends a
+ * relaxation request to the head's owner, which applies all incoming requests after the
+ * next barrier. Every write to per-node state is thus made by its owner, so no atomic
+ * operations are needed on the distance labels.
+ *
+ * The resulting shortest path forest is used exactly as in `primal_dual()`. Flow is
+ * augmented along the path from each source to its nearest sink. These paths belong to
+ * different trees of the forest, so they are vertex-disjoint. The paths are traced
+ * concurrently, but the flow updates are committed serially because the network's
+ * per-arc state may be bit-packed.
+ *
+ * @tparam Network
+ *     The network type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the solver's state.
+ */
+template<class Network, template<class> class Container = Vector>
+class ParallelPrimalDual {
+public:
+    using network_type = Network;
+    using node_type = typename network_type::node_type;
+    using arc_type = typename network_type::arc_type;
+    using cost_type = typename network_type::cost_type;
+    using flow_type = typename network_type::flow_type;
+    using distance_type = cost_type;
+    using size_type = std::size_t;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    /**
+     * Create a new solver for the specified network.
+     *
+     * @param[in,out] network
+     *     The network.
+     * @param[in] num_threads
+     *     The number of worker threads. Must be >= 1.
+     */
+    ParallelPrimalDual(network_type& network, size_type num_threads)
+        : network_(&network),
+          nodes_(network.nodes() | ranges::to<container_type<node_type>>()),
+          num_threads_(num_threads),
+          distance_(num_nodes(), infinity<distance_type>()),
+          pred_arc_(num_nodes()),
+          pred_tail_(num_nodes(), npos()),
+          source_(num_nodes(), npos()),
+          in_frontier_(num_nodes(), 0),
+          is_settled_(num_nodes(), 0),
+          workers_(num_threads),
+          scheduler_(num_threads),
+          thread_pool_(num_threads)
+    {
+        WHIRLWIND_ASSERT(num_threads >= 1);
+
+        for (auto& worker : workers_) {
+            worker.outbox = container_type<container_type<Request>>(num_threads);
+        }
+    }
+
+    /** The network. */
+    [[nodiscard]] auto
+    network() const noexcept -> const network_type&
+    {
+        return *network_;
+    }
+
+    /** The network. */
+    [[nodiscard]] auto
+    network() noexcept -> network_type&
+    {
+        return *network_;
+    }
+
+    /** The number of worker threads. */
+    [[nodiscard]] auto
+    num_threads() const noexcept -> size_type
+    {
+        return num_threads_;
+    }
+
+    /** The bucket width used by the most recent shortest path search. */
+    [[nodiscard]] auto
+    bucket_width() const noexcept -> distance_type
+    {
+        return delta_;
+    }
+
+    /**
+     * Get the distance from the nearest excess node to the specified node, as found by
+     * the most recent shortest path search.
+     */
+    [[nodiscard]] auto
+    distance_to_node(const node_type& node) const -> distance_type
+    {
+        WHIRLWIND_ASSERT(network().contains_node(node));
+        const auto node_id = network().get_node_id(node);
+        WHIRLWIND_DEBUG_ASSERT(node_id < num_nodes());
+        return distance_[node_id];
+    }
+
+    /**
+     * Find the shortest path w.r.t the reduced arc costs to each node from any excess
+     * node.
+     */
+    void
+    find_shortest_paths()
+    {
+        auto barrier = std::barrier(static_cast<std::ptrdiff_t>(num_threads()));
+        thread_pool_.run([&](size_type thread_id) {
+            find_shortest_paths(thread_id, barrier);
+        });
+    }
+
+    /**
+     * Augment one unit of flow along the shortest path from each excess node to its
+     * nearest deficit node, as found by the most recent shortest path search.
+     */
+    void
+    augment_flow()
+    {
+        // Get the nearest sink to each source. Ties are broken by node index, as in
+        // `augment_flow_pd()`. The deficit nodes aren't listed in any particular order
+        // (and the sort isn't stable), so the node index is part of the sort key.
+        sinks_.clear();
+        for (const auto& node : network().deficit_nodes()) {
+            const auto node_id = network().get_node_id(node);
+            WHIRLWIND_ASSERT(source_[node_id] != npos());
+            sinks_.push_back(node_id);
+        }
+        ranges::sort(sinks_, [&](const auto& lhs, const auto& rhs) {
+            return std::tie(source_[lhs], distance_[lhs], lhs) <
+                   std::tie(source_[rhs], distance_[rhs], rhs);
+        });
+        auto it = ranges::unique(sinks_, {}, [&](const auto& sink) {
+            return source_[sink];
+        });
+        sinks_.erase(it, std::end(sinks_));
+
+        // Trace each path concurrently.
+        const auto num_sinks = std::size(sinks_);
+        for (size_type thread_id = 0; thread_id < num_threads(); ++thread_id) {
+            const auto begin = num_sinks * thread_id / num_threads();
+            const auto end = num_sinks * (thread_id + 1) / num_threads();
+            scheduler_.reset_slice(thread_id, end - begin);
+        }
+        thread_pool_.run([&](size_type thread_id) {
+            auto& worker = workers_[thread_id];
+            worker.paths.clear();
+            worker.path_arcs.clear();
+            while (const auto chunk = scheduler_.next(thread_id)) {
+                const auto offset = num_sinks * chunk->slice / num_threads();
+                for (auto i = chunk->begin; i < chunk->end; ++i) {
+                    trace_path(worker, sinks_[offset + i]);
+                }
+            }
+        });
+
+        // Commit the flow updates.
+        constexpr auto delta = one<flow_type>();
+        for (const auto& worker : workers_) {
+            for (const auto& path : worker.paths) {
+                const auto& sink = nodes_[path.sink];
+                WHIRLWIND_ASSERT(network().is_deficit_node(sink));
+                network().increase_node_excess(sink, delta);
+
+                for (auto i = path.begin; i < path.end; ++i) {
+                    const auto& arc = worker.path_arcs[i];
+                    WHIRLWIND_DEBUG_ASSERT(network().arc_residual_capacity(arc) >=
+                                           delta);
+                    network().increase_arc_flow(arc, delta);
+                }
+
+                const auto& source = nodes_[source_[path.sink]];
+                WHIRLWIND_ASSERT(network().is_excess_node(source));
+                network().decrease_node_excess(source, delta);
+            }
+        }
+    }
+
+    /**
+     * Update the node potentials based on the distances found by the most recent
+     * shortest path search.
+     *
+     * As in `update_potential_pd()`, the distance of each node that wasn't reached by
+     * the search is taken to be the maximum distance of any reached node, so that the
+     * reduced cost of each unsaturated arc remains nonnegative.
+     */
+    void
+    update_potential()
+    {
+        // Find the maximum distance of any reached node.
+        thread_pool_.run([&](size_type thread_id) {
+            auto max_distance = zero<distance_type>();
+            const auto strip_end = strip_begin(thread_id + 1);
+            for (auto node_id = strip_begin(thread_id); node_id < strip_end;
+                 ++node_id) {
+                const auto distance = distance_[node_id];
+                if (distance != infinity<distance_type>()) {
+                    max_distance = std::max(max_distance, distance);
+                }
+            }
+            workers_[thread_id].max_distance = max_distance;
+        });
+        auto max_distance = zero<distance_type>();
+        for (const auto& worker : workers_) {
+            max_distance = std::max(max_distance, worker.max_distance);
+        }
+
+        // Shift all potentials uniformly, then correct those of the reached nodes.
+        network().decrease_all_node_potentials(max_distance);
+        thread_pool_.run([&](size_type thread_id) {
+            const auto strip_end = strip_begin(thread_id + 1);
+            for (auto node_id = strip_begin(thread_id); node_id < strip_end;
+                 ++node_id) {
+                const auto distance = distance_[node_id];
+                if (distance != infinity<distance_type>()) {
+                    WHIRLWIND_DEBUG_ASSERT(distance <= max_distance);
+                    network().increase_node_potential(nodes_[node_id],
+                                                      max_distance - distance);
+                }
+            }
+        });
+    }
+
+protected:
+    // A request to update the distance to a node (owned by the recipient).
+    struct Request {
+        size_type head;
+        distance_type distance;
+        arc_type arc;
+        size_type tail;
+        size_type source;
+    };
+
+    // An augmenting path, stored as a range of arcs in a worker's `path_arcs` list.
+    struct Path {
+        size_type sink;
+        size_type begin;
+        size_type end;
+    };
+
+    // Per-thread state. Each thread's buckets contain the nodes in its strip.
+    struct alignas(64) Worker {
+        container_type<container_type<size_type>> buckets = {};
+        size_type min_bucket = 0;
+        container_type<size_type> frontier = {};
+        container_type<size_type> settled = {};
+        container_type<container_type<Request>> outbox = {};
+        container_type<Request> inbox = {};
+        container_type<Path> paths = {};
+        container_type<arc_type> path_arcs = {};
+        double sum_arc_length = 0.0;
+        size_type num_arcs = 0;
+        distance_type max_distance = zero<distance_type>();
+    };
+
+    [[nodiscard]] static constexpr auto
+    npos() noexcept -> size_type
+    {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    [[nodiscard]] auto
+    num_nodes() const noexcept -> size_type
+    {
+        return std::size(nodes_);
+    }
+
+    // The first node index in the specified thread's strip.
+    [[nodiscard]] auto
+    strip_begin(size_type thread_id) const noexcept -> size_type
+    {
+        return (thread_id * num_nodes() + num_threads() - 1) / num_threads();
+    }
+
+    // The index of the thread that owns the specified node.
+    [[nodiscard]] auto
+    get_owner(size_type node_id) const noexcept -> size_type
+    {
+        return node_id * num_threads() / num_nodes();
+    }
+
+    [[nodiscard]] auto
+    get_bucket_id(const distance_type& distance) const -> size_type
+    {
+        WHIRLWIND_DEBUG_ASSERT(distance >= zero<distance_type>());
+        return static_cast<size_type>(distance / delta_);
+    }
+
+    // Find the index of the first non-empty bucket in the worker's buckets, starting
+    // from the specified index. Returns `npos()` if all such buckets are empty.
+    [[nodiscard]] static auto
+    find_min_bucket(const Worker& worker, size_type first) -> size_type
+    {
+        for (auto bucket_id = first; bucket_id < std::size(worker.buckets);
+             ++bucket_id) {
+            if (!std::empty(worker.buckets[bucket_id])) {
+                return bucket_id;
+            }
+        }
+        return npos();
+    }
+
+    // Reset the state of each node in the thread's strip, add each excess node as a
+    // source, and accumulate the reduced costs of the strip's unsaturated arcs.
+    void
+    init_strip(size_type thread_id)
+    {
+        auto& worker = workers_[thread_id];
+        for (auto& bucket : worker.buckets) {
+            bucket.clear();
+        }
+        worker.sum_arc_length = 0.0;
+        worker.num_arcs = 0;
+
+        const auto strip_end = strip_begin(thread_id + 1);
+        for (auto node_id = strip_begin(thread_id); node_id < strip_end; ++node_id) {
+            const auto& tail = nodes_[node_id];
+            pred_tail_[node_id] = npos();
+            in_frontier_[node_id] = 0;
+            is_settled_[node_id] = 0;
+
+            if (network().is_excess_node(tail)) {
+                distance_[node_id] = zero<distance_type>();
+                source_[node_id] = node_id;
+            } else {
+                distance_[node_id] = infinity<distance_type>();
+                source_[node_id] = npos();
+            }
+
+            network().for_each_unsaturated_outgoing_arc(
+                    tail, [&](const auto& arc, const auto& head) {
+                        const auto arc_length =
+                                network().arc_reduced_cost(arc, tail, head);
+                        WHIRLWIND_ASSERT(arc_length >= zero<distance_type>());
+                        worker.sum_arc_length += static_cast<double>(arc_length);
+                        ++worker.num_arcs;
+                    });
+        }
+    }
+
+    // Choose the bucket width. Following Meyer & Sanders, this is the mean length of
+    // the unsaturated arcs divided by their mean out-degree, which bounds the expected
+    // number of times each node is re-relaxed within a bucket.
+    void
+    init_bucket_width(size_type thread_id)
+    {
+        auto sum_arc_length = 0.0;
+        size_type num_arcs = 0;
+        for (const auto& worker : workers_) {
+            sum_arc_length += worker.sum_arc_length;
+            num_arcs += worker.num_arcs;
+        }
+
+        auto delta = one<distance_type>();
+        if (num_arcs > 0) {
+            const auto m = static_cast<double>(num_arcs);
+            const auto mean_arc_length = sum_arc_length / m;
+            const auto mean_degree = m / static_cast<double>(num_nodes());
+            const auto width = mean_arc_length / mean_degree;
+            delta = std::max(static_cast<distance_type>(width), one<distance_type>());
+        }
+
+        // Each thread computes the same value, but only one thread stores it.
+        if (thread_id == 0) {
+            delta_ = delta;
+        }
+    }
+
+    // Push each source in the thread's strip into the first bucket.
+    void
+    push_sources(size_type thread_id)
+    {
+        auto& worker = workers_[thread_id];
+        const auto strip_end = strip_begin(thread_id + 1);
+        for (auto node_id = strip_begin(thread_id); node_id < strip_end; ++node_id) {
+            if (source_[node_id] == node_id) {
+                push_node(worker, node_id, zero<distance_type>());
+            }
+        }
+        worker.min_bucket = find_min_bucket(worker, 0);
+    }
+
+    void
+    push_node(Worker& worker, size_type node_id, const distance_type& distance)
+    {
+        const auto bucket_id = get_bucket_id(distance);
+        if (bucket_id >= std::size(worker.buckets)) {
+            worker.buckets.resize(bucket_id + 1);
+        }
+        worker.buckets[bucket_id].push_back(node_id);
+    }
+
+    // Move the contents of the thread's current bucket into its frontier, skipping
+    // stale and duplicate entries. Returns the size of the frontier.
+    auto
+    extract_frontier(size_type thread_id, size_type bucket_id) -> size_type
+    {
+        auto& worker = workers_[thread_id];
+        worker.frontier.clear();
+        if (bucket_id >= std::size(worker.buckets)) {
+            return 0;
+        }
+
+        auto& bucket = worker.buckets[bucket_id];
+        for (const auto& node_id : bucket) {
+            if (in_frontier_[node_id] != 0) {
+                continue;
+            }
+            if (get_bucket_id(distance_[node_id]) != bucket_id) {
+                continue;
+            }
+
+            in_frontier_[node_id] = 1;
+            worker.frontier.push_back(node_id);
+
+            if (is_settled_[node_id] == 0) {
+                is_settled_[node_id] = 1;
+                worker.settled.push_back(node_id);
+            }
+        }
+        bucket.clear();
+
+        return std::size(worker.frontier);
+    }
+
+    // Relax each outgoing arc of the specified node whose length is either <= delta
+    // (`light` is true) or > delta (`light` is false), sending a request to the owner
+    // of the arc's head for each arc that would shorten the distance to the head.
+    void
+    relax_node(Worker& worker, size_type tail_id, bool light)
+    {
+        const auto& tail = nodes_[tail_id];
+        const auto distance = distance_[tail_id];
+        const auto source = source_[tail_id];
+
+        network().for_each_unsaturated_outgoing_arc(
+                tail, [&](const auto& arc, const auto& head) {
+                    const auto arc_length = network().arc_reduced_cost(arc, tail, head);
+                    WHIRLWIND_ASSERT(arc_length >= zero<distance_type>());
+                    if ((arc_length <= delta_) != light) {
+                        return;
+                    }
+
+                    // Distances are only modified between barriers by the owner of each
+                    // node, so this read doesn't race with any write.
+                    const auto head_id = network().get_node_id(head);
+                    const auto new_distance = distance + arc_length;
+                    if (new_distance < distance_[head_id]) {
+                        auto& outbox = worker.outbox[get_owner(head_id)];
+                        outbox.push_back({head_id, new_distance, arc, tail_id, source});
+                    }
+                });
+    }
+
+    // Relax the outgoing arcs of each node in the specified frontier lists, which are
+    // distributed among threads via work stealing.
+    template<class GetList>
+    void
+    relax_nodes(size_type thread_id, GetList get_list, bool light)
+    {
+        auto& worker = workers_[thread_id];
+        while (const auto chunk = scheduler_.next(thread_id)) {
+            const auto& list = get_list(workers_[chunk->slice]);
+            for (auto i = chunk->begin; i < chunk->end; ++i) {
+                relax_node(worker, list[i], light);
+            }
+        }
+    }
+
+    // Apply each request addressed to the specified thread.
+    //
+    // The order in which requests arrive depends on how work was distributed among
+    // threads, so the requests are sorted before they're applied. Among the requests
+    // for each node, the one with the shortest distance wins, with ties broken by
+    // lowest source index, then tail index, then arc index. The resulting shortest
+    // path forest is thus independent of the number of threads and of scheduling.
+    void
+    apply_requests(size_type thread_id)
+    {
+        auto& worker = workers_[thread_id];
+        auto& inbox = worker.inbox;
+        inbox.clear();
+        for (auto& sender : workers_) {
+            auto& outbox = sender.outbox[thread_id];
+            inbox.insert(std::end(inbox), std::begin(outbox), std::end(outbox));
+            outbox.clear();
+        }
+
+        ranges::sort(inbox, [&](const Request& lhs, const Request& rhs) {
+            const auto lhs_arc_id = network().get_arc_id(lhs.arc);
+            const auto rhs_arc_id = network().get_arc_id(rhs.arc);
+            return std::tie(lhs.head, lhs.distance, lhs.source, lhs.tail, lhs_arc_id) <
+                   std::tie(rhs.head, rhs.distance, rhs.source, rhs.tail, rhs_arc_id);
+        });
+
+        for (const auto& request : inbox) {
+            const auto node_id = request.head;
+            WHIRLWIND_DEBUG_ASSERT(get_owner(node_id) == thread_id);
+            if (request.distance < distance_[node_id]) {
+                distance_[node_id] = request.distance;
+                pred_arc_[node_id] = request.arc;
+                pred_tail_[node_id] = request.tail;
+                source_[node_id] = request.source;
+                push_node(worker, node_id, request.distance);
+            }
+        }
+    }
+
+    void
+    find_shortest_paths(size_type thread_id, std::barrier<>& barrier)
+    {
+        auto& worker = workers_[thread_id];
+
+        init_strip(thread_id);
+        barrier.arrive_and_wait();
+
+        init_bucket_width(thread_id);
+        barrier.arrive_and_wait();
+
+        push_sources(thread_id);
+
+        while (true) {
+            barrier.arrive_and_wait();
+
+            // Find the first non-empty bucket among all threads. Each thread computes
+            // the same value.
+            auto bucket_id = npos();
+            for (const auto& other : workers_) {
+                bucket_id = std::min(bucket_id, other.min_bucket);
+            }
+            if (bucket_id == npos()) {
+                break;
+            }
+
+            // Repeatedly relax light arcs from nodes in the current bucket until it
+            // remains empty.
+            while (true) {
+                const auto frontier_size = extract_frontier(thread_id, bucket_id);
+                scheduler_.reset_slice(thread_id, frontier_size);
+                barrier.arrive_and_wait();
+
+                size_type total_frontier_size = 0;
+                for (const auto& other : workers_) {
+                    total_frontier_size += std::size(other.frontier);
+                }
+                if (total_frontier_size == 0) {
+                    break;
+                }
+
+                relax_nodes(
+                        thread_id,
+                        [](const Worker& w) -> const auto& { return w.frontier; },
+                        true);
+                barrier.arrive_and_wait();
+
+                for (const auto& node_id : worker.frontier) {
+                    in_frontier_[node_id] = 0;
+                }
+                apply_requests(thread_id);
+            }
+
+            // Relax the heavy arcs from each node that was settled in this bucket.
+            scheduler_.reset_slice(thread_id, std::size(worker.settled));
+            barrier.arrive_and_wait();
+
+            relax_nodes(
+                    thread_id, [](const Worker& w) -> const auto& { return w.settled; },
+                    false);
+            barrier.arrive_and_wait();
+
+            apply_requests(thread_id);
+            worker.settled.clear();
+            worker.min_bucket = find_min_bucket(worker, bucket_id);
+        }
+    }
+
+    // Append the arcs along the path from the source to the specified sink (in reverse
+    // order) to the worker's list of paths.
+    void
+    trace_path(Worker& worker, size_type sink_id) const
+    {
+        const auto begin = std::size(worker.path_arcs);
+        for (auto node_id = sink_id; pred_tail_[node_id] != npos();
+             node_id = pred_tail_[node_id]) {
+            worker.path_arcs.push_back(pred_arc_[node_id]);
+        }
+        worker.paths.push_back({sink_id, begin, std::size(worker.path_arcs)});
+    }
+
+private:
+    network_type* network_;
+    container_type<node_type> nodes_;
+    size_type num_threads_;
+    distance_type delta_ = one<distance_type>();
+
+    container_type<distance_type> distance_;
+    container_type<arc_type> pred_arc_;
+    container_type<size_type> pred_tail_;
+    container_type<size_type> source_;
+
+    // Per-node flags. These are stored as bytes rather than bits so that threads may
+    // modify the flags of distinct nodes concurrently.
+    container_type<std::uint8_t> in_frontier_;
+    container_type<std::uint8_t> is_settled_;
+
+    container_type<Worker> workers_;
+    WorkStealingScheduler scheduler_;
+    container_type<size_type> sinks_ = {};
+
+    // The worker threads are started once and reused by each phase of each
+    // iteration.
+    ThreadPool thread_pool_;
+};
+
+/**
+ * Solve a minimum cost flow problem using a multithreaded variant of the primal-dual
+ * algorithm.
+ *
+ * Each iteration is equivalent to an iteration of `primal_dual()`, but the shortest
+ * path search, path tracing, and potential updates are performed concurrently (see
+ * `ParallelPrimalDual`). The resulting flow is optimal, with the same total cost as
+ * that of the serial algorithm.
+ *
+ * @tparam Dijkstra
+ *     The shortest path solver type used by `successive_shortest_paths()` if the
+ *     maximum number of iterations is reached.
+ * @tparam Logger
+ *     The logger type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the solver's state.
+ *
+ * @param[in,out] network
+ *     The network. Must be balanced.
+ * @param[in] num_threads
+ *     The number of worker threads. If zero, `default_num_threads()` is used.
+ * @param[in] maxiter
+ *     The maximum number of primal-dual iterations, after which any remaining excess
+ *     is routed using successive shortest paths. If zero, the number of iterations is
+ *     unlimited.
+ */
+template<class Dijkstra,
+         class Logger = NullLogger,
+         template<class> class Container = Vector,
+         class Network>
+void
+parallel_primal_dual(Network& network,
+                     std::size_t num_threads = 0,
+                     std::size_t maxiter = 0)
+{
+    auto logger = Logger("whirlwind.network.parallel_primal_dual");
+
+    WHIRLWIND_ASSERT(network.is_balanced());
+
+    if (num_threads == 0) {
+        num_threads = default_num_threads();
+    }
+    auto solver = ParallelPrimalDual<Network, Container>(network, num_threads);
+
+    std::size_t iter = 1;
+    while (true) {
+        logger.info("Iteration {}", iter);
+
+        solver.find_shortest_paths();
+        solver.augment_flow();
+        solver.update_potential();
+
+        if (!contains_any_excess_node(network)) {
+            return;
+        }
+
+        if (iter == maxiter) {
+            break;
+        }
+
+        ++iter;
+    }
+
+    successive_shortest_paths<Dijkstra, Logger>(network);
+}
+
+WHIRLWIND_NAMESPACE_END
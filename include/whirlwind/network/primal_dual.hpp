@@ -1,12 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <memory>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
-#include <range/v3/algorithm/fill.hpp>
 #include <range/v3/algorithm/sort.hpp>
 #include <range/v3/algorithm/unique.hpp>
 #include <range/v3/range/conversion.hpp>
@@ -14,6 +17,7 @@
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
 #include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/dijkstra_concepts.hpp>
 #include <whirlwind/logging/null_logger.hpp>
 #include <whirlwind/math/numbers.hpp>
 
@@ -38,6 +42,7 @@ public:
 
     using super_type::distance_to_vertex;
     using super_type::graph;
+    using super_type::is_root_vertex;
     using super_type::predecessor_vertex;
 
     template<class Network>
@@ -104,6 +109,46 @@ public:
         }
     }
 
+    /**
+     * Perform a complete concurrent search from the specified sources (see
+     * `ParallelDijkstraSolverType`), then set the source of each visited vertex to the
+     * root of its tree in the resulting shortest path forest.
+     */
+    template<class Sources, class EdgeLength>
+        requires ParallelDijkstraSolverType<super_type>
+    void
+    run(Sources&& sources, EdgeLength edge_length)
+    {
+        super_type::run(std::forward<Sources>(sources), std::move(edge_length));
+
+        auto is_assigned = container_type<std::uint8_t>(graph().num_vertices(), 0);
+        auto path = container_type<vertex_type>();
+        for (const auto& vertex : this->visited_vertices()) {
+            // Follow the predecessors of the vertex until reaching either the root of
+            // its tree or a vertex whose source was already assigned.
+            auto node = vertex;
+            while (is_assigned[graph().get_vertex_id(node)] == 0 &&
+                   !is_root_vertex(node)) {
+                path.push_back(node);
+                node = predecessor_vertex(node);
+            }
+
+            const auto node_id = graph().get_vertex_id(node);
+            if (is_assigned[node_id] == 0) {
+                source_[node_id] = node;
+                is_assigned[node_id] = 1;
+            }
+
+            const auto& source = source_[node_id];
+            for (const auto& v : path) {
+                const auto vertex_id = graph().get_vertex_id(v);
+                source_[vertex_id] = source;
+                is_assigned[vertex_id] = 1;
+            }
+            path.clear();
+        }
+    }
+
     [[nodiscard]] constexpr auto
     source_fill_value() const noexcept -> const vertex_type&
     {
@@ -113,8 +158,14 @@ public:
     constexpr void
     reset()
     {
+        // Only the sources of reached vertices are ever assigned, so the cost of the
+        // reset is proportional to the number of vertices touched by the search.
+        for (const auto& vertex : this->reached_vertices()) {
+            const auto vertex_id = graph().get_vertex_id(vertex);
+            WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(source_));
+            source_[vertex_id] = source_fill_value();
+        }
         super_type::reset();
-        ranges::fill(source_, source_fill_value());
     }
 
 private:
@@ -122,6 +173,18 @@ private:
     vertex_type source_fill_value_;
 };
 
+namespace detail {
+
+// A Dijkstra solver that can't relax edges longer than `max_edge_length()`.
+template<class Dijkstra>
+concept BoundedEdgeLengthSolverType = requires(const Dijkstra& dijkstra) {
+    {
+        dijkstra.max_edge_length()
+    } -> std::convertible_to<typename Dijkstra::distance_type>;
+};
+
+} // namespace detail
+
 template<class Network>
 [[nodiscard]] constexpr auto
 contains_any_excess_node(const Network& network) -> bool
@@ -132,11 +195,17 @@ contains_any_excess_node(const Network& network) -> bool
     return false;
 }
 
-// Find the shortest path w.r.t the reduced arc costs to each node from any excess node
-// using Dijkstra's algorithm.
+// Find the shortest path w.r.t the reduced arc costs from any excess node to each node
+// using Dijkstra's algorithm, stopping once each deficit node has been visited. If the
+// solver supports concurrent searches, a complete search is performed concurrently
+// instead.
+//
+// Returns the distance of the last visited node, which is no less than the distance
+// of any visited node and no greater than the distance of any unvisited node.
 template<class Dijkstra, class Network>
-constexpr void
+constexpr auto
 dijkstra_pd(Dijkstra& dijkstra, const Network& network)
+        -> typename Dijkstra::distance_type
 {
     using Distance = typename Dijkstra::distance_type;
     WHIRLWIND_STATIC_ASSERT(std::is_same_v<Distance, typename Network::cost_type>);
@@ -144,6 +213,28 @@ dijkstra_pd(Dijkstra& dijkstra, const Network& network)
     WHIRLWIND_ASSERT(std::addressof(dijkstra.graph()) ==
                      std::addressof(network.residual_graph()));
 
+    if constexpr (ParallelDijkstraSolverType<Dijkstra>) {
+        dijkstra.run(network.excess_nodes(),
+                     [&](const auto& arc, const auto& tail, const auto& head) {
+                         if (network.is_arc_saturated(arc)) {
+                             return infinity<Distance>();
+                         }
+                         return network.arc_reduced_cost(arc, tail, head);
+                     });
+
+        auto max_distance = zero<Distance>();
+        for (const auto& node : dijkstra.visited_vertices()) {
+            max_distance = std::max(max_distance, dijkstra.distance_to_vertex(node));
+        }
+        return max_distance;
+    }
+
+    std::size_t num_deficit_nodes = 0;
+    for ([[maybe_unused]] const auto& node : network.deficit_nodes()) {
+        ++num_deficit_nodes;
+    }
+    auto last_distance = zero<Distance>();
+
     for (const auto& source : network.excess_nodes()) {
         dijkstra.add_source(source);
         WHIRLWIND_DEBUG_ASSERT(dijkstra.has_reached_vertex(source));
@@ -151,29 +242,41 @@ dijkstra_pd(Dijkstra& dijkstra, const Network& network)
     }
 
     while (!dijkstra.done()) {
-        const auto [tail, distance] = dijkstra.pop_next_unvisited_vertex();
+        const auto top = dijkstra.pop_next_unvisited_vertex();
+        using std::get;
+        const auto& tail = get<0>(top);
+        const auto& distance = get<1>(top);
         WHIRLWIND_DEBUG_ASSERT(network.contains_node(tail));
         WHIRLWIND_DEBUG_ASSERT(distance >= zero<Distance>());
 
         dijkstra.visit_vertex(tail, distance);
         WHIRLWIND_DEBUG_ASSERT(dijkstra.has_visited_vertex(tail));
         WHIRLWIND_DEBUG_ASSERT(dijkstra.distance_to_vertex(tail) == distance);
-
-        for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
-            WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
-            WHIRLWIND_DEBUG_ASSERT(network.contains_node(head));
-
-            if (network.is_arc_saturated(arc)) {
-                continue;
+        last_distance = distance;
+
+        // The remainder of the search wouldn't affect the augmenting paths, and the
+        // potentials of the unvisited nodes are updated uniformly.
+        if (network.is_deficit_node(tail)) {
+            --num_deficit_nodes;
+            if (num_deficit_nodes == 0) {
+                break;
             }
+        }
 
-            const auto arc_length = network.arc_reduced_cost(arc, tail, head);
-            WHIRLWIND_ASSERT(arc_length >= zero<Distance>());
+        network.for_each_unsaturated_outgoing_arc(
+                tail, [&](const auto& arc, const auto& head) {
+                    WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
+                    WHIRLWIND_DEBUG_ASSERT(network.contains_node(head));
 
-            dijkstra.relax_edge(arc, tail, head, distance + arc_length);
-            WHIRLWIND_DEBUG_ASSERT(dijkstra.has_reached_vertex(head));
-        }
+                    const auto arc_length = network.arc_reduced_cost(arc, tail, head);
+                    WHIRLWIND_ASSERT(arc_length >= zero<Distance>());
+
+                    dijkstra.relax_edge(arc, tail, head, distance + arc_length);
+                    WHIRLWIND_DEBUG_ASSERT(dijkstra.has_reached_vertex(head));
+                });
     }
+
+    return last_distance;
 }
 
 template<template<class> class Container = Vector, class Network, class Dijkstra>
@@ -193,14 +296,15 @@ augment_flow_pd(Network& network, const Dijkstra& dijkstra)
 
         const auto lhs_source_id = network.get_node_id(lhs_source);
         const auto rhs_source_id = network.get_node_id(rhs_source);
-
-        if (lhs_source_id == rhs_source_id) {
-            const auto lhs_distance = dijkstra.distance_to_vertex(lhs);
-            const auto rhs_distance = dijkstra.distance_to_vertex(rhs);
-            return lhs_distance < rhs_distance;
-        }
-
-        return lhs_source_id < rhs_source_id;
+        const auto lhs_distance = dijkstra.distance_to_vertex(lhs);
+        const auto rhs_distance = dijkstra.distance_to_vertex(rhs);
+        const auto lhs_id = network.get_node_id(lhs);
+        const auto rhs_id = network.get_node_id(rhs);
+
+        // Ties are broken by node index, so the chosen sinks don't depend on the
+        // order of the deficit nodes (the sort isn't stable).
+        return std::tie(lhs_source_id, lhs_distance, lhs_id) <
+               std::tie(rhs_source_id, rhs_distance, rhs_id);
     });
     auto it = ranges::unique(sinks, {}, [&](const auto& sink) {
         const auto source = dijkstra.source_vertex(sink);
@@ -216,7 +320,7 @@ augment_flow_pd(Network& network, const Dijkstra& dijkstra)
     for (const auto& sink : sinks) {
         WHIRLWIND_DEBUG_ASSERT(network.is_deficit_node(sink));
         network.increase_node_excess(sink, delta);
-        WHIRLWIND_ASSERT(!network.is_deficit_node(sink));
+        WHIRLWIND_ASSERT(!network.is_excess_node(sink));
 
         auto head = sink;
         for (const auto& [tail, arc] : dijkstra.predecessors(sink)) {
@@ -233,26 +337,38 @@ augment_flow_pd(Network& network, const Dijkstra& dijkstra)
 
         WHIRLWIND_ASSERT(network.is_excess_node(head));
         network.decrease_node_excess(head, delta);
-        WHIRLWIND_ASSERT(!network.is_excess_node(head));
+        WHIRLWIND_ASSERT(!network.is_deficit_node(head));
     }
 }
 
+// Decrease the potential of each node by its distance found by `dijkstra_pd`, where the
+// distance of each unvisited node is taken to be `max_distance` (the distance returned
+// by `dijkstra_pd`). The reduced cost of each unsaturated arc remains nonnegative.
+//
+// The potentials of the unvisited nodes are updated in constant time via the global
+// potential offset, so the update costs time proportional to the number of visited
+// nodes. The reduced cost of any unsaturated arc increases by at most `max_distance`.
 template<class Network, class Dijkstra>
 constexpr void
-update_potential_pd(Network& network, const Dijkstra& dijkstra)
+update_potential_pd(Network& network,
+                    const Dijkstra& dijkstra,
+                    const typename Dijkstra::distance_type& max_distance)
 {
     using Distance = typename Dijkstra::distance_type;
     WHIRLWIND_STATIC_ASSERT(std::is_same_v<Distance, typename Network::cost_type>);
 
     WHIRLWIND_ASSERT(std::addressof(network.residual_graph()) ==
                      std::addressof(dijkstra.graph()));
+    WHIRLWIND_ASSERT(max_distance >= zero<Distance>());
+
+    network.decrease_all_node_potentials(max_distance);
 
-    for (const auto& node : network.nodes()) {
-        WHIRLWIND_DEBUG_ASSERT(dijkstra.has_visited_vertex(node));
+    for (const auto& node : dijkstra.visited_vertices()) {
+        WHIRLWIND_DEBUG_ASSERT(network.contains_node(node));
         const auto distance = dijkstra.distance_to_vertex(node);
         WHIRLWIND_DEBUG_ASSERT(distance >= zero<Distance>());
-        network.decrease_node_potential(node, distance);
-        WHIRLWIND_DEBUG_ASSERT(network.node_potential(node) <= zero<Distance>());
+        WHIRLWIND_DEBUG_ASSERT(distance <= max_distance);
+        network.increase_node_potential(node, max_distance - distance);
     }
 }
 
@@ -264,27 +380,56 @@ primal_dual(Network& network, std::size_t maxiter = 0)
 
     WHIRLWIND_ASSERT(network.is_balanced());
 
+    // The solver is created once and reset after each round, which takes time
+    // proportional to the number of nodes touched by the search.
+    using PDDijkstra = PrimalDualDijkstra<Dijkstra>;
+    auto dijkstra = PDDijkstra(network);
+    WHIRLWIND_DEBUG_ASSERT(std::addressof(dijkstra.graph()) ==
+                           std::addressof(network.residual_graph()));
+
+    // An upper bound on the reduced cost of any unsaturated arc, tracked for solvers
+    // that can't relax longer edges (e.g. `Dial`, whose number of buckets is determined
+    // by the max reduced cost when it's created).
+    using Distance = typename PDDijkstra::distance_type;
+    auto max_arc_length = zero<Distance>();
+    if constexpr (detail::BoundedEdgeLengthSolverType<PDDijkstra>) {
+        max_arc_length = dijkstra.max_edge_length();
+    }
+
     std::size_t iter = 1;
     while (true) {
         logger.info("Iteration {}", iter);
 
-        auto dijkstra = PrimalDualDijkstra<Dijkstra>(network);
-        WHIRLWIND_DEBUG_ASSERT(std::addressof(dijkstra.graph()) ==
-                               std::addressof(network.residual_graph()));
+        const auto max_distance = dijkstra_pd(dijkstra, network);
+
+        // Allocate temporary storage using the same container type as the solver.
+        augment_flow_pd<PDDijkstra::template container_type>(network, dijkstra);
 
-        dijkstra_pd(dijkstra, network);
-        augment_flow_pd(network, dijkstra);
+        // Update the potentials even after the final round, so that the solution's
+        // potentials satisfy the reduced cost optimality conditions (e.g. in order to
+        // warm-start a subsequent solve).
+        update_potential_pd(network, dijkstra, max_distance);
 
         if (!contains_any_excess_node(network)) {
             return;
         }
 
-        update_potential_pd(network, dijkstra);
-
         if (iter == maxiter) {
             break;
         }
 
+        dijkstra.reset();
+
+        // The solver is recreated (scanning every arc) only once the reduced costs may
+        // exceed the max edge length that it supports.
+        if constexpr (detail::BoundedEdgeLengthSolverType<PDDijkstra>) {
+            max_arc_length += max_distance;
+            if (max_arc_length > dijkstra.max_edge_length()) {
+                dijkstra = PDDijkstra(network);
+                max_arc_length = dijkstra.max_edge_length();
+            }
+        }
+
         ++iter;
     }
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <concepts>
 #include <cstddef>
+#include <iterator>
 #include <utility>
 
 #include <range/v3/view/filter.hpp>
@@ -8,6 +10,9 @@
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
 #include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/graph/flat_rectangular_grid_graph.hpp>
 #include <whirlwind/graph/graph_concepts.hpp>
 #include <whirlwind/graph/rectangular_grid_graph.hpp>
 #include <whirlwind/math/math.hpp>
@@ -160,6 +165,26 @@ public:
         return residual_graph().outgoing_edges(node);
     }
 
+    /**
+     * Invoke a function on each outgoing arc (and corresponding head node) of a node.
+     *
+     * Visits the same (arc,head) pairs as `outgoing_arcs()`, in the same order, without
+     * constructing an intermediate range. Preferred in performance-critical inner
+     * loops.
+     *
+     * @param[in] node
+     *     The input node. Must be a valid node in the network.
+     * @param[in] visitor
+     *     A function invocable with arguments `(const arc_type&, const node_type&)`.
+     */
+    template<class Visitor>
+    constexpr void
+    for_each_outgoing_arc(const node_type& node, Visitor visitor) const
+    {
+        WHIRLWIND_ASSERT(contains_node(node));
+        residual_graph().for_each_outgoing_edge(node, std::move(visitor));
+    }
+
 protected:
     constexpr BasicResidualGraphMixin(residual_graph_type residual_graph)
         : residual_graph_(std::move(residual_graph))
@@ -177,6 +202,7 @@ private:
     using super_type = detail::BasicResidualGraphMixin<Graph>;
 
 public:
+    using node_type = super_type::node_type;
     using arc_type = super_type::arc_type;
     using size_type = super_type::size_type;
     using residual_graph_type = super_type::residual_graph_type;
@@ -236,6 +262,29 @@ public:
         return residual_graph_arc_id_[edge_id];
     }
 
+    /**
+     * Given a forward arc in the network's residual graph, get the edge index of the
+     * corresponding edge in the original graph.
+     *
+     * @param[in] forward_arc
+     *     The input arc. Must be a valid forward arc in the network's residual graph.
+     *
+     * @returns
+     *     The edge index of the corresponding edge in the original graph.
+     */
+    [[nodiscard]] constexpr auto
+    get_edge_id(const arc_type& forward_arc) const -> size_type
+    {
+        WHIRLWIND_ASSERT(contains_arc(forward_arc));
+        WHIRLWIND_ASSERT(is_forward_arc(forward_arc));
+        const auto arc_id = get_arc_id(forward_arc);
+        if (std::empty(edge_id_)) {
+            return arc_id / 2;
+        }
+        WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(edge_id_));
+        return edge_id_[arc_id];
+    }
+
     /**
      * Given a forward or reverse arc in the network's residual graph, get the index of
      * its transpose arc.
@@ -260,11 +309,33 @@ public:
         return transpose_arc_id_[arc_id];
     }
 
+    /**
+     * Invoke a function on each incoming arc (and corresponding tail node) of a node.
+     *
+     * The incoming arcs of a node in the residual graph are the transposes of its
+     * outgoing arcs, so they're visited by iterating over the node's outgoing arcs
+     * without the need for a separate reverse adjacency index.
+     *
+     * @param[in] node
+     *     The input node. Must be a valid node in the network.
+     * @param[in] visitor
+     *     A function invocable with arguments `(const arc_type&, const node_type&)`.
+     */
+    template<class Visitor>
+    constexpr void
+    for_each_incoming_arc(const node_type& node, Visitor visitor) const
+    {
+        this->for_each_outgoing_arc(node, [&](const auto& arc, const auto& tail) {
+            const auto transpose_arc = static_cast<arc_type>(get_transpose_arc_id(arc));
+            visitor(transpose_arc, tail);
+        });
+    }
+
 protected:
     constexpr ResidualGraphMixin(residual_graph_type residual_graph,
                                  container_type<bool> is_forward_arc,
-                                 container_type<size_type> residual_graph_arc_id,
-                                 container_type<size_type> transpose_arc_id)
+                                 container_type<arc_type> residual_graph_arc_id,
+                                 container_type<arc_type> transpose_arc_id)
         : super_type(std::move(residual_graph)),
           is_forward_arc_(std::move(is_forward_arc)),
           residual_graph_arc_id_(std::move(residual_graph_arc_id)),
@@ -272,32 +343,167 @@ protected:
     {
         WHIRLWIND_ASSERT(2 * std::size(residual_graph_arc_id_) ==
                          std::size(transpose_arc_id_));
-        WHIRLWIND_ASSERT(std::size(is_forward_arc_) == residual_graph().num_edges());
-        WHIRLWIND_ASSERT(std::size(transpose_arc_id_) == residual_graph().num_edges());
+        WHIRLWIND_ASSERT(std::size(is_forward_arc_) == num_arcs());
+        WHIRLWIND_ASSERT(std::size(transpose_arc_id_) == num_arcs());
+
+        edge_id_ = make_edge_ids();
+    }
+
+    // Move the transpose arc indices out of the mixin, e.g. so that a derived mixin
+    // can store them along with other per-arc state rather than in a separate array.
+    // The derived mixin must then hide `get_transpose_arc_id()` and
+    // `for_each_incoming_arc()`, which may no longer be called.
+    [[nodiscard]] constexpr auto
+    release_transpose_arc_ids() noexcept -> container_type<arc_type>
+    {
+        return std::exchange(transpose_arc_id_, container_type<arc_type>());
     }
 
+    /**
+     * Create the residual graph of a CSR graph (or CSR graph view).
+     *
+     * The residual graph contains a forward arc and a reverse arc for each edge in the
+     * original graph. It's stored separately from the original graph, whose row and
+     * column index arrays are not referenced after construction.
+     *
+     * @param[in] original_graph
+     *     The original graph.
+     */
+    explicit constexpr ResidualGraphMixin(const Graph& original_graph)
+        requires std::constructible_from<residual_graph_type,
+                                         const EdgeList<node_type, Container>&,
+                                         size_type,
+                                         size_type,
+                                         EdgeOrder>
+        : ResidualGraphMixin(make_residual_edge_list(original_graph),
+                             original_graph.num_vertices())
+    {}
+
 private:
+    // Get the (tail,head) pairs of the arcs in the residual graph of `original_graph`.
+    // The forward and reverse arcs corresponding to the edge with index `i` in the
+    // original graph are at positions `2*i` and `2*i+1` in the list, respectively. The
+    // list stores the residual graph's own index type (e.g. 32-bit indices) rather
+    // than `size_type`.
+    [[nodiscard]] static constexpr auto
+    make_residual_edge_list(const Graph& original_graph)
+            -> EdgeList<node_type, Container>
+    {
+        using Edge = typename EdgeList<node_type, Container>::value_type;
+
+        const auto num_edges = size_type{original_graph.num_edges()};
+        auto edges = container_type<Edge>(2 * num_edges);
+
+        for (const auto& tail : original_graph.vertices()) {
+            const auto tail_id =
+                    static_cast<node_type>(original_graph.get_vertex_id(tail));
+            original_graph.for_each_outgoing_edge(
+                    tail, [&](const auto& edge, const auto& head) {
+                        const auto edge_id = original_graph.get_edge_id(edge);
+                        const auto head_id = static_cast<node_type>(
+                                original_graph.get_vertex_id(head));
+                        WHIRLWIND_DEBUG_ASSERT(edge_id < num_edges);
+                        edges[2 * edge_id] = {tail_id, head_id};
+                        edges[2 * edge_id + 1] = {head_id, tail_id};
+                    });
+        }
+
+        return EdgeList<node_type, Container>(std::move(edges));
+    }
+
+    // Get the index of the corresponding edge in the original graph of each arc. If
+    // the forward & reverse arcs of the edge with index `e` are arcs `2e` and `2e+1`,
+    // the edge index of each arc is simply half its arc index, so the returned
+    // container is empty.
+    [[nodiscard]] constexpr auto
+    make_edge_ids() const -> container_type<arc_type>
+    {
+        const auto num_edges = size_type{std::size(residual_graph_arc_id_)};
+
+        auto is_interleaved = true;
+        for (size_type edge_id = 0; edge_id < num_edges; ++edge_id) {
+            const auto forward_arc_id = size_type{residual_graph_arc_id_[edge_id]};
+            const auto reverse_arc_id = size_type{transpose_arc_id_[forward_arc_id]};
+            if (forward_arc_id != 2 * edge_id || reverse_arc_id != 2 * edge_id + 1) {
+                is_interleaved = false;
+                break;
+            }
+        }
+        if (is_interleaved) {
+            return {};
+        }
+
+        auto edge_id = container_type<arc_type>(2 * num_edges);
+        for (size_type i = 0; i < num_edges; ++i) {
+            const auto forward_arc_id = residual_graph_arc_id_[i];
+            const auto reverse_arc_id = transpose_arc_id_[forward_arc_id];
+            edge_id[forward_arc_id] = static_cast<arc_type>(i);
+            edge_id[reverse_arc_id] = static_cast<arc_type>(i);
+        }
+        return edge_id;
+    }
+
+    constexpr ResidualGraphMixin(const EdgeList<node_type, Container>& edge_list,
+                                 size_type num_nodes)
+        : super_type(residual_graph_type(edge_list, num_nodes, 0, EdgeOrder::stable)),
+          is_forward_arc_(num_arcs(), false),
+          residual_graph_arc_id_(num_arcs() / 2),
+          transpose_arc_id_(num_arcs())
+    {
+        // The outgoing arcs of each node are in the same order as in the edge list, so
+        // the arc index of each list entry is found by walking the list and advancing
+        // a cursor within the row of each arc's tail node.
+        const auto row_offsets = this->residual_graph().view().row_offsets();
+        auto next_arc_id = container_type<arc_type>(std::begin(row_offsets),
+                                                    std::end(row_offsets));
+
+        for (size_type edge_id = 0; edge_id < num_arcs() / 2; ++edge_id) {
+            using std::get;
+            const auto forward_tail = get<0>(edge_list[2 * edge_id]);
+            const auto reverse_tail = get<0>(edge_list[2 * edge_id + 1]);
+            const auto forward_arc_id = next_arc_id[forward_tail]++;
+            const auto reverse_arc_id = next_arc_id[reverse_tail]++;
+
+            is_forward_arc_[forward_arc_id] = true;
+            residual_graph_arc_id_[edge_id] = forward_arc_id;
+            transpose_arc_id_[forward_arc_id] = reverse_arc_id;
+            transpose_arc_id_[reverse_arc_id] = forward_arc_id;
+        }
+
+        edge_id_ = make_edge_ids();
+    }
+
     container_type<bool> is_forward_arc_;
-    container_type<size_type> residual_graph_arc_id_;
-    container_type<size_type> transpose_arc_id_;
+    container_type<arc_type> residual_graph_arc_id_;
+    container_type<arc_type> transpose_arc_id_;
+
+    // The index of the corresponding edge in the original graph of each arc. Empty if
+    // the edge index of each arc is half its arc index (see `make_edge_ids()`).
+    container_type<arc_type> edge_id_;
 };
 
-// Partial specialization for `RectangularGridGraph`.
-template<class Dim, template<class> class Container>
-class ResidualGraphMixin<RectangularGridGraph<1, Dim>, Container>
-    : public detail::BasicResidualGraphMixin<RectangularGridGraph<1, Dim>> {
+namespace detail {
+
+// The residual graph mixin of a grid graph (`RectangularGridGraph` or
+// `FlatRectangularGridGraph`) with P parallel edges between adjacent vertices. The
+// residual graph of the grid is another grid with 2P parallel edges between adjacent
+// nodes, in which the forward arc of the p-th parallel edge is the (2p)-th parallel
+// arc and its reverse arc is the (2p+1)-th. The forward arc of the edge with index `e`
+// is therefore arc `2e`, and the arcs emanating from a node in one direction (e.g.
+// up) & their transposes in the opposite direction (down) are exactly half the arcs
+// apart. The forward & transpose arcs are computed arithmetically rather than stored.
+template<GraphType Graph>
+class GridResidualGraphMixin : public BasicResidualGraphMixin<Graph> {
 private:
-    using super_type = detail::BasicResidualGraphMixin<RectangularGridGraph<1, Dim>>;
+    using super_type = BasicResidualGraphMixin<Graph>;
 
 public:
     using graph_type = super_type::graph_type;
     using residual_graph_type = super_type::residual_graph_type;
+    using node_type = super_type::node_type;
     using arc_type = super_type::arc_type;
     using size_type = super_type::size_type;
 
-    template<class T>
-    using container_type = Container<T>;
-
     using super_type::arcs;
     using super_type::contains_arc;
     using super_type::get_arc_id;
@@ -358,11 +564,69 @@ public:
         }
     }
 
+    /**
+     * Invoke a function on each incoming arc (and corresponding tail node) of a node.
+     *
+     * See `ResidualGraphMixin::for_each_incoming_arc()`.
+     */
+    template<class Visitor>
+    constexpr void
+    for_each_incoming_arc(const node_type& node, Visitor visitor) const
+    {
+        this->for_each_outgoing_arc(node, [&](const auto& arc, const auto& tail) {
+            const auto transpose_arc = static_cast<arc_type>(get_transpose_arc_id(arc));
+            visitor(transpose_arc, tail);
+        });
+    }
+
 protected:
-    constexpr ResidualGraphMixin(const graph_type& original_graph)
+    WHIRLWIND_STATIC_ASSERT(residual_graph_type::num_parallel_edges() ==
+                            2 * graph_type::num_parallel_edges());
+
+    constexpr GridResidualGraphMixin(const graph_type& original_graph)
         : super_type(residual_graph_type(original_graph.num_rows(),
                                          original_graph.num_cols()))
     {}
 };
 
+} // namespace detail
+
+// Partial specialization for `RectangularGridGraph`.
+template<std::size_t P,
+         class Dim,
+         class Index,
+         std::size_t Rows,
+         std::size_t Cols,
+         template<class> class Container>
+class ResidualGraphMixin<RectangularGridGraph<P, Dim, Index, Rows, Cols>, Container>
+    : public detail::GridResidualGraphMixin<
+              RectangularGridGraph<P, Dim, Index, Rows, Cols>> {
+private:
+    using super_type = detail::GridResidualGraphMixin<
+            RectangularGridGraph<P, Dim, Index, Rows, Cols>>;
+
+public:
+    template<class T>
+    using container_type = Container<T>;
+
+protected:
+    using super_type::super_type;
+};
+
+// Partial specialization for `FlatRectangularGridGraph`.
+template<std::size_t P, class Index, template<class> class Container>
+class ResidualGraphMixin<FlatRectangularGridGraph<P, Index>, Container>
+    : public detail::GridResidualGraphMixin<FlatRectangularGridGraph<P, Index>> {
+private:
+    using super_type =
+            detail::GridResidualGraphMixin<FlatRectangularGridGraph<P, Index>>;
+
+public:
+    template<class T>
+    using container_type = Container<T>;
+
+protected:
+    using super_type::super_type;
+};
+
 WHIRLWIND_NAMESPACE_END
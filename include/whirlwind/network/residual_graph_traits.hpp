@@ -3,7 +3,11 @@
 #include <cstddef>
 
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/bidirectional_csr_graph.hpp>
 #include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/csr_graph_view.hpp>
+#include <whirlwind/graph/flat_rectangular_grid_graph.hpp>
 #include <whirlwind/graph/rectangular_grid_graph.hpp>
 
 WHIRLWIND_NAMESPACE_BEGIN
@@ -11,14 +15,33 @@ WHIRLWIND_NAMESPACE_BEGIN
 template<class Graph>
 struct ResidualGraphTraits;
 
-template<template<class> class Container>
-struct ResidualGraphTraits<CSRGraph<Container>> {
-    using type = CSRGraph<Container>;
+template<template<class> class Container, class Index>
+struct ResidualGraphTraits<CSRGraph<Container, Index>> {
+    using type = CSRGraph<Container, Index>;
 };
 
-template<std::size_t P, class Dim>
-struct ResidualGraphTraits<RectangularGridGraph<P, Dim>> {
-    using type = RectangularGridGraph<2 * P, Dim>;
+// The residual graph doesn't need a CSC index: the incoming arcs of each node are the
+// transposes of its outgoing arcs.
+template<template<class> class Container, class Index>
+struct ResidualGraphTraits<BidirectionalCSRGraph<Container, Index>> {
+    using type = CSRGraph<Container, Index>;
+};
+
+// The residual graph contains a reverse arc for each edge, so it can't be a view of
+// the original graph's index arrays.
+template<class Index>
+struct ResidualGraphTraits<CSRGraphView<Index>> {
+    using type = CSRGraph<Vector, Index>;
+};
+
+template<std::size_t P, class Dim, class Index, std::size_t Rows, std::size_t Cols>
+struct ResidualGraphTraits<RectangularGridGraph<P, Dim, Index, Rows, Cols>> {
+    using type = RectangularGridGraph<2 * P, Dim, Index, Rows, Cols>;
+};
+
+template<std::size_t P, class Index>
+struct ResidualGraphTraits<FlatRectangularGridGraph<P, Index>> {
+    using type = FlatRectangularGridGraph<2 * P, Index>;
 };
 
 WHIRLWIND_NAMESPACE_END
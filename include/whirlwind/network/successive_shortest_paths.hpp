@@ -3,6 +3,7 @@
 #include <memory>
 #include <optional>
 #include <type_traits>
+#include <utility>
 
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
@@ -38,7 +39,12 @@ dijkstra_ssp(Dijkstra& dijkstra,
     WHIRLWIND_DEBUG_ASSERT(dijkstra.distance_to_vertex(source) == zero<Distance>());
 
     while (!dijkstra.done()) {
-        const auto [tail, distance] = dijkstra.pop_next_unvisited_vertex();
+        // Clang<16 doesn't support capturing structured bindings in lambdas, so unpack
+        // the (vertex,distance) pair by reference instead.
+        const auto top = dijkstra.pop_next_unvisited_vertex();
+        using std::get;
+        const auto& tail = get<0>(top);
+        const auto& distance = get<1>(top);
         WHIRLWIND_DEBUG_ASSERT(network.contains_node(tail));
         WHIRLWIND_DEBUG_ASSERT(distance >= zero<Distance>());
 
@@ -50,20 +56,17 @@ dijkstra_ssp(Dijkstra& dijkstra,
             return tail;
         }
 
-        for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
-            WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
-            WHIRLWIND_DEBUG_ASSERT(network.contains_node(head));
+        network.for_each_unsaturated_outgoing_arc(
+                tail, [&](const auto& arc, const auto& head) {
+                    WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
+                    WHIRLWIND_DEBUG_ASSERT(network.contains_node(head));
 
-            if (network.is_arc_saturated(arc)) {
-                continue;
-            }
-
-            const auto arc_length = network.arc_reduced_cost(arc, tail, head);
-            WHIRLWIND_ASSERT(arc_length >= zero<Distance>());
+                    const auto arc_length = network.arc_reduced_cost(arc, tail, head);
+                    WHIRLWIND_ASSERT(arc_length >= zero<Distance>());
 
-            dijkstra.relax_edge(arc, tail, head, distance + arc_length);
-            WHIRLWIND_DEBUG_ASSERT(dijkstra.has_reached_vertex(head));
-        }
+                    dijkstra.relax_edge(arc, tail, head, distance + arc_length);
+                    WHIRLWIND_DEBUG_ASSERT(dijkstra.has_reached_vertex(head));
+                });
     }
 
     return std::nullopt;
@@ -86,7 +89,7 @@ augment_flow_ssp(Network& network,
 
     WHIRLWIND_ASSERT(network.is_deficit_node(sink));
     network.increase_node_excess(sink, delta);
-    WHIRLWIND_ASSERT(!network.is_deficit_node(sink));
+    WHIRLWIND_ASSERT(!network.is_excess_node(sink));
 
     auto head = sink;
     for (const auto& [tail, arc] : dijkstra.predecessors(sink)) {
@@ -103,7 +106,7 @@ augment_flow_ssp(Network& network,
 
     WHIRLWIND_ASSERT(network.is_excess_node(head));
     network.decrease_node_excess(head, delta);
-    WHIRLWIND_ASSERT(!network.is_excess_node(head));
+    WHIRLWIND_ASSERT(!network.is_deficit_node(head));
 }
 
 template<class Network, class Dijkstra>
@@ -152,18 +155,23 @@ successive_shortest_paths(Network& network)
     using Iter = std::remove_const_t<decltype(num_iter)>;
     Iter iter = 1;
     for (const auto& source : network.excess_nodes()) {
-        if (iter % 100 == 0) {
-            logger.info("Iteration {:>8}/{}", iter, num_iter);
-        }
+        // Each iteration routes a single unit of flow from the source.
+        while (network.is_excess_node(source)) {
+            if (iter % 100 == 0) {
+                logger.info("Iteration {:>8}/{}", iter, num_iter);
+            }
 
-        const auto sink = dijkstra_ssp(dijkstra, network, source);
-        WHIRLWIND_ASSERT(sink);
+            const auto sink = dijkstra_ssp(dijkstra, network, source);
+            WHIRLWIND_ASSERT(sink);
 
-        augment_flow_ssp(network, dijkstra, *sink);
-        update_potential_ssp(network, dijkstra, *sink);
+            augment_flow_ssp(network, dijkstra, *sink);
+            update_potential_ssp(network, dijkstra, *sink);
 
-        ++iter;
+            ++iter;
+        }
     }
+
+    WHIRLWIND_ASSERT(network.total_excess() == 0);
 }
 
 WHIRLWIND_NAMESPACE_END
@@ -21,6 +21,7 @@ private:
     using super_type = ResidualGraphMixin;
 
 public:
+    using node_type = typename super_type::node_type;
     using arc_type = typename super_type::arc_type;
     using flow_type = Flow;
 
@@ -31,7 +32,7 @@ public:
     using super_type::get_arc_id;
     using super_type::get_transpose_arc_id;
     using super_type::is_forward_arc;
-    using super_type::num_forward_arcs;
+    using super_type::num_arcs;
 
     /**
      * Get the upper capacity of an arc in the network.
@@ -115,7 +116,32 @@ public:
         if (is_forward_arc(arc)) {
             return false;
         }
-        return arc_residual_capacity(arc) > zero<flow_type>();
+        return arc_residual_capacity(arc) == zero<flow_type>();
+    }
+
+    /**
+     * Invoke a function on each unsaturated outgoing arc (and corresponding head node)
+     * of a node.
+     *
+     * Visits the arcs emanating from the specified node in the network's residual
+     * graph whose residual capacity is nonzero, in the same order as
+     * `for_each_outgoing_arc()`. Used by shortest path searches to relax the
+     * outgoing arcs of each visited node.
+     *
+     * @param[in] node
+     *     The input node. Must be a valid node in the network.
+     * @param[in] visitor
+     *     A function invocable with arguments `(const arc_type&, const node_type&)`.
+     */
+    template<class Visitor>
+    constexpr void
+    for_each_unsaturated_outgoing_arc(const node_type& node, Visitor visitor) const
+    {
+        this->for_each_outgoing_arc(node, [&](const auto& arc, const auto& head) {
+            if (!is_arc_saturated(arc)) {
+                visitor(arc, head);
+            }
+        });
     }
 
     /**
@@ -152,12 +178,14 @@ protected:
     template<class... Args>
     constexpr UncapacitatedMixin(Args&&... args)
         : super_type(std::forward<Args>(args)...),
-          arc_flow_(num_forward_arcs(), zero<flow_type>())
+          arc_flow_(num_arcs(), zero<flow_type>())
     {
-        WHIRLWIND_DEBUG_ASSERT(std::size(arc_flow_) == num_forward_arcs());
+        WHIRLWIND_DEBUG_ASSERT(std::size(arc_flow_) == num_arcs());
     }
 
 private:
+    // The flow in each forward arc, indexed by arc index. Forward arc indices aren't
+    // contiguous in general, so entries corresponding to reverse arcs are unused.
     container_type<flow_type> arc_flow_;
 };
 
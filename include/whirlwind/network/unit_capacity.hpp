@@ -1,13 +1,13 @@
 #pragma once
 
+#include <bit>
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 
-#include <range/v3/range/conversion.hpp>
-#include <range/v3/view/transform.hpp>
-
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/bit_vector.hpp>
 #include <whirlwind/container/vector.hpp>
 #include <whirlwind/graph/graph_concepts.hpp>
 #include <whirlwind/math/numbers.hpp>
@@ -25,7 +25,9 @@ private:
     using super_type = ResidualGraphMixin;
 
 public:
+    using node_type = typename super_type::node_type;
     using arc_type = typename super_type::arc_type;
+    using size_type = typename super_type::size_type;
     using flow_type = Flow;
 
     WHIRLWIND_STATIC_ASSERT(std::is_integral_v<flow_type>);
@@ -73,8 +75,7 @@ public:
     {
         WHIRLWIND_ASSERT(contains_arc(arc));
         const auto arc_id = get_arc_id(arc);
-        WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(is_arc_saturated_));
-        return is_arc_saturated_[arc_id];
+        return is_arc_saturated_.test(arc_id);
     }
 
     /**
@@ -109,6 +110,31 @@ public:
         return is_arc_saturated(arc) ? one<flow_type>() : zero<flow_type>();
     }
 
+    /**
+     * Invoke a function on each unsaturated outgoing arc (and corresponding head node)
+     * of a node.
+     *
+     * Visits the arcs emanating from the specified node in the network's residual
+     * graph whose residual capacity is nonzero, in the same order as
+     * `for_each_outgoing_arc()`. Used by shortest path searches to relax the
+     * outgoing arcs of each visited node.
+     *
+     * @param[in] node
+     *     The input node. Must be a valid node in the network.
+     * @param[in] visitor
+     *     A function invocable with arguments `(const arc_type&, const node_type&)`.
+     */
+    template<class Visitor>
+    constexpr void
+    for_each_unsaturated_outgoing_arc(const node_type& node, Visitor visitor) const
+    {
+        this->for_each_outgoing_arc(node, [&](const auto& arc, const auto& head) {
+            if (!is_arc_saturated(arc)) {
+                visitor(arc, head);
+            }
+        });
+    }
+
     /**
      * Increase flow in an arc.
      *
@@ -129,28 +155,86 @@ public:
         WHIRLWIND_ASSERT(!is_arc_saturated(arc));
         WHIRLWIND_ASSERT(delta == one<flow_type>());
         const auto arc_id = get_arc_id(arc);
-        WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(is_arc_saturated_));
         const auto transpose_arc_id = get_transpose_arc_id(arc);
-        WHIRLWIND_DEBUG_ASSERT(transpose_arc_id < std::size(is_arc_saturated_));
-        is_arc_saturated_[arc_id] = true;
-        is_arc_saturated_[transpose_arc_id] = false;
+        is_arc_saturated_.set(arc_id);
+        is_arc_saturated_.reset(transpose_arc_id);
+    }
+
+    /**
+     * Get the number of saturated forward arcs.
+     *
+     * Forward arcs are saturated iff they carry (one unit of) flow, so this is the
+     * number of arcs in the network with nonzero flow. Computed by counting the set
+     * bits of 64 arcs at a time.
+     */
+    [[nodiscard]] constexpr auto
+    num_saturated_forward_arcs() const noexcept -> size_type
+    {
+        const auto saturated = is_arc_saturated_.words();
+        const auto forward = forward_arc_mask_.words();
+        WHIRLWIND_DEBUG_ASSERT(std::size(saturated) == std::size(forward));
+
+        size_type n = 0;
+        for (size_type i = 0; i < std::size(saturated); ++i) {
+            n += static_cast<size_type>(std::popcount(saturated[i] & forward[i]));
+        }
+        return n;
+    }
+
+    /**
+     * Invoke a function on each saturated forward arc (i.e. each arc with nonzero
+     * flow), in order of increasing arc index.
+     *
+     * Words of 64 arcs that contain no saturated forward arc are skipped without
+     * inspecting the individual arcs, so this is much faster than filtering
+     * `forward_arcs()` when few arcs carry flow.
+     *
+     * @param[in] visitor
+     *     A function invocable with argument `(const arc_type&)`.
+     */
+    template<class Visitor>
+    constexpr void
+    for_each_saturated_forward_arc(Visitor visitor) const
+    {
+        const auto saturated = is_arc_saturated_.words();
+        const auto forward = forward_arc_mask_.words();
+        WHIRLWIND_DEBUG_ASSERT(std::size(saturated) == std::size(forward));
+
+        auto visit_arc = [&](size_type arc_id) {
+            const auto arc = static_cast<arc_type>(arc_id);
+            WHIRLWIND_DEBUG_ASSERT(contains_arc(arc));
+            visitor(arc);
+        };
+        for (size_type i = 0; i < std::size(saturated); ++i) {
+            BitVector<Container>::for_each_set_bit_in_word(saturated[i] & forward[i], i,
+                                                           visit_arc);
+        }
     }
 
 protected:
     template<class... Args>
     constexpr UnitCapacityMixin(Args&&... args)
-        : super_type(std::forward<Args>(args)...), is_arc_saturated_([&]() {
-              return arcs() | ranges::views::transform([&](const auto& arc) {
-                         return !this->is_forward_arc(arc);
-                     }) |
-                     ranges::to<container_type<bool>>();
-          }())
+        : super_type(std::forward<Args>(args)...),
+          forward_arc_mask_(num_arcs()),
+          is_arc_saturated_(num_arcs())
     {
-        WHIRLWIND_DEBUG_ASSERT(std::size(is_arc_saturated_) == num_arcs());
+        // Initially, each forward arc is empty & each reverse arc is saturated.
+        for (const auto& arc : arcs()) {
+            const auto arc_id = get_arc_id(arc);
+            const auto is_forward = this->is_forward_arc(arc);
+            forward_arc_mask_.assign(arc_id, is_forward);
+            is_arc_saturated_.assign(arc_id, !is_forward);
+        }
+        WHIRLWIND_DEBUG_ASSERT(forward_arc_mask_.size() == num_arcs());
+        WHIRLWIND_DEBUG_ASSERT(is_arc_saturated_.size() == num_arcs());
     }
 
 private:
-    container_type<bool> is_arc_saturated_;
+    // The saturation state of each arc and a mask of the forward arcs, indexed by arc
+    // index and packed into words so that the saturated forward arcs can be counted &
+    // enumerated 64 arcs at a time.
+    BitVector<Container> forward_arc_mask_;
+    BitVector<Container> is_arc_saturated_;
 };
 
 WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include <range/v3/range/conversion.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/bit_vector.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+namespace detail {
+
+// Decrease node potentials until the reduced cost of each arc with infinite residual
+// capacity is nonnegative. Such arcs can't be saturated, so a violation is fixed by
+// decreasing the potential of the arc's tail node, which may in turn cause violations
+// on the arcs entering the tail node. Violating nodes are processed in rounds, as in
+// the Bellman-Ford algorithm. This terminates because arcs with infinite residual
+// capacity are forward arcs, whose costs are nonnegative, so no cycle of them has
+// negative cost.
+template<template<class> class Container, class Network>
+constexpr void
+fix_uncapacitated_arc_reduced_costs(Network& network)
+{
+    using Node = typename Network::node_type;
+    using Arc = typename Network::arc_type;
+    using Cost = typename Network::cost_type;
+    using Flow = typename Network::flow_type;
+
+    auto has_infinite_capacity = [&](const Arc& arc) {
+        return network.arc_residual_capacity(arc) == infinity<Flow>();
+    };
+
+    // The minimum reduced cost of any outgoing arc of a node with infinite residual
+    // capacity, or zero if it's nonnegative.
+    auto min_reduced_cost = [&](const Node& tail) {
+        auto min_cost = zero<Cost>();
+        network.for_each_outgoing_arc(tail, [&](const Arc& arc, const Node& head) {
+            if (has_infinite_capacity(arc)) {
+                const auto cost = network.arc_reduced_cost(arc, tail, head);
+                min_cost = std::min(min_cost, cost);
+            }
+        });
+        return min_cost;
+    };
+
+    auto nodes = network.nodes() | ranges::to<Container<Node>>();
+    auto next_nodes = Container<Node>();
+    auto is_next_node = BitVector<Container>(network.num_nodes());
+
+    while (!std::empty(nodes)) {
+        for (const auto& node : nodes) {
+            const auto cost = min_reduced_cost(node);
+            if (cost >= zero<Cost>()) {
+                continue;
+            }
+            network.increase_node_potential(node, cost);
+
+            // Each arc entering `node` is the transpose of an arc leaving it.
+            network.for_each_outgoing_arc(node, [&](const Arc& arc, const Node& head) {
+                const auto transpose_arc =
+                        static_cast<Arc>(network.get_transpose_arc_id(arc));
+                if (!has_infinite_capacity(transpose_arc)) {
+                    return;
+                }
+                const auto head_id = network.get_node_id(head);
+                if (is_next_node.test(head_id)) {
+                    return;
+                }
+                const auto reduced_cost =
+                        network.arc_reduced_cost(transpose_arc, head, node);
+                if (reduced_cost < zero<Cost>()) {
+                    next_nodes.push_back(head);
+                    is_next_node.set(head_id);
+                }
+            });
+        }
+
+        for (const auto& node : next_nodes) {
+            is_next_node.reset(network.get_node_id(node));
+        }
+        nodes.clear();
+        std::swap(nodes, next_nodes);
+    }
+}
+
+} // namespace detail
+
+/**
+ * Restore the reduced cost optimality conditions of a network after a warm start.
+ *
+ * Successive shortest path-type solvers require that the reduced cost of each
+ * unsaturated arc is nonnegative. A network whose node potentials and arc flows were
+ * imported from the solution of a similar network (see `Network::set_node_potentials()`
+ * and `Network::set_forward_arc_flows()`) generally satisfies this everywhere except
+ * near changes in the arc costs or flows. This function restores the condition while
+ * modifying the imported state as little as possible:
+ *
+ * - The potential of the tail node of each arc with infinite residual capacity and
+ *   negative reduced cost is decreased until its reduced cost is zero.
+ * - Then, each remaining unsaturated arc with negative reduced cost is saturated,
+ *   moving the corresponding excess from its tail node to its head node.
+ *
+ * Afterwards, the network may be solved (e.g. by `successive_shortest_paths()` or
+ * `primal_dual()`), which re-balances the remaining excess. The number of augmentations
+ * performed by the solver then depends on the changes in the node surpluses and arc
+ * costs rather than on the size of the problem.
+ *
+ * The repair itself is not incremental: it takes time linear in the size of the
+ * network, since every arc is inspected for a negative reduced cost, as is the import
+ * of the arc flows. The first round of potential updates likewise inspects every
+ * node's outgoing arcs, though subsequent rounds visit only the nodes whose potentials
+ * were affected. This is typically small compared to a cold solve, which performs a
+ * shortest path search per unit of excess.
+ *
+ * @tparam Container
+ *     A `std::vector`-like type template used to store temporary lists of nodes.
+ *
+ * @param[in,out] network
+ *     The network.
+ */
+template<template<class> class Container = Vector, class Network>
+constexpr void
+restore_reduced_cost_optimality(Network& network)
+{
+    using Node = typename Network::node_type;
+    using Arc = typename Network::arc_type;
+    using Cost = typename Network::cost_type;
+    using Flow = typename Network::flow_type;
+
+    detail::fix_uncapacitated_arc_reduced_costs<Container>(network);
+
+    for (const auto& tail : network.nodes()) {
+        network.for_each_outgoing_arc(tail, [&](const Arc& arc, const Node& head) {
+            const auto capacity = network.arc_residual_capacity(arc);
+            if (capacity == zero<Flow>()) {
+                return;
+            }
+            if (network.arc_reduced_cost(arc, tail, head) < zero<Cost>()) {
+                WHIRLWIND_ASSERT(capacity != infinity<Flow>());
+                network.push_arc_flow(arc, tail, head, capacity);
+            }
+        });
+    }
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -16,6 +16,7 @@ template<template<class> class Container = Vector,
          class Accumulator = double,
          class ArrayLike2D,
          class Dim,
+         class Index,
          class Cost,
          class Flow,
          // clang-format off
@@ -25,8 +26,11 @@ template<template<class> class Container = Vector,
 [[nodiscard]] constexpr auto
 integrate_unwrapped_gradients(
         const ArrayLike2D& wrapped_phase,
-        const Network<RectangularGridGraph<1, Dim>, Cost, Flow, UContainer, Mixin>&
-                network)
+        const Network<RectangularGridGraph<1, Dim, Index>,
+                      Cost,
+                      Flow,
+                      UContainer,
+                      Mixin>& network)
 {
     // The input wrapped phase array must be a real-valued 2-D array.
     using Real = typename ArrayLike2D::value_type;
@@ -0,0 +1,128 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/common/parallel.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("default_num_threads", "[parallel]")
+{
+    CATCH_CHECK(ww::default_num_threads() >= 1U);
+}
+
+CATCH_TEST_CASE("run_in_parallel", "[parallel]")
+{
+    const auto num_threads = std::size_t{4};
+    auto visited = std::vector<std::atomic<int>>(num_threads);
+    ww::run_in_parallel(num_threads, [&](std::size_t thread_id) {
+        visited[thread_id].fetch_add(1, std::memory_order_relaxed);
+    });
+
+    for (const auto& count : visited) {
+        CATCH_CHECK(count.load() == 1);
+    }
+}
+
+CATCH_TEST_CASE("ThreadPool", "[parallel]")
+{
+    CATCH_SECTION("run")
+    {
+        // The same worker threads are reused by each call.
+        const auto num_threads = std::size_t{4};
+        auto pool = ww::ThreadPool(num_threads);
+        CATCH_CHECK(pool.num_threads() == num_threads);
+
+        auto visited = std::vector<std::atomic<int>>(num_threads);
+        auto thread_ids = std::vector<std::thread::id>(num_threads);
+        for (int i = 0; i < 100; ++i) {
+            pool.run([&](std::size_t thread_id) {
+                visited[thread_id].fetch_add(1, std::memory_order_relaxed);
+                if (i == 0) {
+                    thread_ids[thread_id] = std::this_thread::get_id();
+                }
+            });
+        }
+        for (const auto& count : visited) {
+            CATCH_CHECK(count.load() == 100);
+        }
+        CATCH_CHECK(thread_ids[0] == std::this_thread::get_id());
+
+        // Every invocation has completed once `run()` returns.
+        auto sum = std::atomic<std::size_t>(0);
+        pool.run([&](std::size_t thread_id) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(thread_id));
+            sum.fetch_add(thread_id, std::memory_order_relaxed);
+        });
+        CATCH_CHECK(sum.load() == 6U);
+    }
+
+    CATCH_SECTION("single thread")
+    {
+        auto pool = ww::ThreadPool(1U);
+        auto count = 0;
+        pool.run([&](std::size_t thread_id) { count += int(thread_id) + 1; });
+        CATCH_CHECK(count == 1);
+    }
+}
+
+CATCH_TEST_CASE("WorkStealingScheduler", "[parallel]")
+{
+    const auto num_threads = std::size_t{3};
+    const auto chunk_size = std::size_t{8};
+    auto scheduler = ww::WorkStealingScheduler(num_threads, chunk_size);
+
+    CATCH_SECTION("WorkStealingScheduler")
+    {
+        CATCH_CHECK(scheduler.num_slices() == num_threads);
+        CATCH_CHECK(scheduler.chunk_size() == chunk_size);
+        for (std::size_t thread_id = 0; thread_id < num_threads; ++thread_id) {
+            CATCH_CHECK_FALSE(scheduler.next(thread_id).has_value());
+        }
+    }
+
+    CATCH_SECTION("next")
+    {
+        // Unevenly sized slices, including an empty one.
+        const auto sizes = std::vector<std::size_t>{100, 0, 17};
+        for (std::size_t slice = 0; slice < num_threads; ++slice) {
+            scheduler.reset_slice(slice, sizes[slice]);
+        }
+
+        // Each thread claims chunks until all work is exhausted. Catch2 assertions
+        // aren't thread-safe, so malformed chunks are recorded and checked afterwards.
+        auto num_bad_chunks = std::atomic<int>(0);
+        auto claimed = std::vector<std::vector<std::atomic<int>>>();
+        for (const auto size : sizes) {
+            claimed.emplace_back(size);
+        }
+        ww::run_in_parallel(num_threads, [&](std::size_t thread_id) {
+            while (const auto chunk = scheduler.next(thread_id)) {
+                if ((chunk->begin >= chunk->end) ||
+                    (chunk->end - chunk->begin > chunk_size)) {
+                    num_bad_chunks.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                for (auto i = chunk->begin; i < chunk->end; ++i) {
+                    claimed[chunk->slice][i].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+        CATCH_CHECK(num_bad_chunks.load() == 0);
+
+        // Every work item must have been claimed exactly once.
+        for (const auto& slice : claimed) {
+            for (const auto& count : slice) {
+                CATCH_CHECK(count.load() == 1);
+            }
+        }
+    }
+}
+
+} // namespace
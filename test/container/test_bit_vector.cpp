@@ -0,0 +1,95 @@
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <whirlwind/container/bit_vector.hpp>
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace ww = whirlwind;
+
+// Get the indices of the set bits of a `BitVector`, in increasing order.
+template<class BitVector>
+auto
+set_bits(const BitVector& bits) -> std::vector<std::size_t>
+{
+    auto out = std::vector<std::size_t>();
+    bits.for_each_set_bit([&](std::size_t pos) { out.push_back(pos); });
+    return out;
+}
+
+CATCH_TEST_CASE("BitVector", "[container]")
+{
+    // Spans more than one word, with a partially used last word.
+    const auto size = std::size_t{130};
+
+    CATCH_SECTION("BitVector")
+    {
+        const auto bits = ww::BitVector(size);
+        CATCH_CHECK(bits.size() == size);
+        CATCH_CHECK(std::size(bits.words()) == 3U);
+        CATCH_CHECK(bits.count() == 0U);
+        for (std::size_t i = 0; i < size; ++i) {
+            CATCH_CHECK(!bits.test(i));
+        }
+    }
+
+    CATCH_SECTION("BitVector (set)")
+    {
+        const auto bits = ww::BitVector(size, true);
+        CATCH_CHECK(bits.count() == size);
+        for (std::size_t i = 0; i < size; ++i) {
+            CATCH_CHECK(bits.test(i));
+        }
+
+        // The unused bits of the last word are zero.
+        CATCH_CHECK(bits.words().back() == 0b11U);
+    }
+
+    CATCH_SECTION("set/reset/assign")
+    {
+        auto bits = ww::BitVector(size);
+
+        bits.set(0U);
+        bits.set(63U);
+        bits.set(64U);
+        bits.set(129U);
+        CATCH_CHECK(bits.test(0U));
+        CATCH_CHECK(bits.test(63U));
+        CATCH_CHECK(bits.test(64U));
+        CATCH_CHECK(bits.test(129U));
+        CATCH_CHECK(!bits.test(1U));
+        CATCH_CHECK(bits.count() == 4U);
+
+        bits.reset(63U);
+        CATCH_CHECK(!bits.test(63U));
+        CATCH_CHECK(bits.test(64U));
+        CATCH_CHECK(bits.count() == 3U);
+
+        bits.assign(5U, true);
+        bits.assign(0U, false);
+        bits.assign(64U, true);
+        CATCH_CHECK(bits.test(5U));
+        CATCH_CHECK(!bits.test(0U));
+        CATCH_CHECK(bits.test(64U));
+        CATCH_CHECK(bits.count() == 3U);
+    }
+
+    CATCH_SECTION("for_each_set_bit")
+    {
+        auto bits = ww::BitVector(size);
+        CATCH_CHECK(set_bits(bits).empty());
+
+        const auto expected = std::vector<std::size_t>{1U, 2U, 63U, 100U, 129U};
+        for (const auto& pos : expected) {
+            bits.set(pos);
+        }
+        CATCH_CHECK_THAT(set_bits(bits), CM::RangeEquals(expected));
+    }
+}
+
+} // namespace
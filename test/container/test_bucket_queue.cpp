@@ -0,0 +1,141 @@
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_container_properties.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <whirlwind/container/bucket_queue.hpp>
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace ww = whirlwind;
+
+// Pop all elements from the specified bucket and return them in order.
+template<class BucketQueue>
+auto
+drain_bucket(BucketQueue& queue, std::size_t bucket_id) -> std::vector<int>
+{
+    auto out = std::vector<int>();
+    while (!queue.bucket_empty(bucket_id)) {
+        out.push_back(queue.front(bucket_id));
+        queue.pop(bucket_id);
+    }
+    return out;
+}
+
+CATCH_TEST_CASE("BucketQueue", "[container]")
+{
+    using BucketQueue = ww::BucketQueue<int>;
+    const auto num_buckets = 3U;
+    auto queue = BucketQueue(num_buckets);
+
+    CATCH_SECTION("BucketQueue")
+    {
+        CATCH_CHECK(queue.num_buckets() == num_buckets);
+        CATCH_CHECK(queue.empty());
+        CATCH_CHECK(queue.size() == 0U);
+        for (std::size_t i = 0; i < num_buckets; ++i) {
+            CATCH_CHECK(queue.bucket_empty(i));
+            CATCH_CHECK(queue.bucket_size(i) == 0U);
+        }
+    }
+
+    CATCH_SECTION("push/pop")
+    {
+        queue.push(0U, 1);
+        queue.push(2U, 10);
+        queue.push(0U, 2);
+        queue.push(0U, 3);
+        queue.push(2U, 20);
+
+        CATCH_CHECK(queue.size() == 5U);
+        CATCH_CHECK(queue.bucket_size(0U) == 3U);
+        CATCH_CHECK(queue.bucket_empty(1U));
+        CATCH_CHECK(queue.bucket_size(2U) == 2U);
+        CATCH_CHECK(queue.front(0U) == 1);
+        CATCH_CHECK(queue.front(2U) == 10);
+
+        // Each bucket is first-in, first-out.
+        CATCH_CHECK_THAT(drain_bucket(queue, 0U), CM::RangeEquals({1, 2, 3}));
+        CATCH_CHECK_THAT(drain_bucket(queue, 2U), CM::RangeEquals({10, 20}));
+        CATCH_CHECK(queue.empty());
+    }
+
+    CATCH_SECTION("push/pop (interleaved)")
+    {
+        // Nodes released by `pop()` are reused by subsequent calls to `push()`.
+        queue.push(1U, 1);
+        queue.push(1U, 2);
+        queue.pop(1U);
+        queue.push(0U, 3);
+        queue.push(1U, 4);
+        queue.pop(0U);
+        queue.push(0U, 5);
+
+        CATCH_CHECK(queue.size() == 3U);
+        CATCH_CHECK_THAT(drain_bucket(queue, 0U), CM::RangeEquals({5}));
+        CATCH_CHECK_THAT(drain_bucket(queue, 1U), CM::RangeEquals({2, 4}));
+    }
+
+    CATCH_SECTION("clear_bucket")
+    {
+        queue.push(0U, 1);
+        queue.push(0U, 2);
+        queue.push(1U, 3);
+        queue.clear_bucket(0U);
+
+        CATCH_CHECK(queue.bucket_empty(0U));
+        CATCH_CHECK(queue.size() == 1U);
+
+        queue.push(0U, 4);
+        queue.push(0U, 5);
+        queue.push(0U, 6);
+        CATCH_CHECK_THAT(drain_bucket(queue, 0U), CM::RangeEquals({4, 5, 6}));
+        CATCH_CHECK_THAT(drain_bucket(queue, 1U), CM::RangeEquals({3}));
+    }
+
+    CATCH_SECTION("clear")
+    {
+        queue.push(0U, 1);
+        queue.push(2U, 2);
+        queue.clear();
+
+        CATCH_CHECK(queue.num_buckets() == num_buckets);
+        CATCH_CHECK(queue.empty());
+        for (std::size_t i = 0; i < num_buckets; ++i) {
+            CATCH_CHECK(queue.bucket_empty(i));
+        }
+
+        queue.push(1U, 3);
+        CATCH_CHECK_THAT(drain_bucket(queue, 1U), CM::RangeEquals({3}));
+    }
+
+    CATCH_SECTION("operator[]")
+    {
+        auto bucket = queue[1U];
+        CATCH_CHECK(bucket.id() == 1U);
+        CATCH_CHECK_THAT(bucket, CM::IsEmpty());
+
+        bucket.push(1);
+        bucket.push(2);
+        CATCH_CHECK(std::size(bucket) == 2U);
+        CATCH_CHECK(bucket.front() == 1);
+        CATCH_CHECK(queue.bucket_size(1U) == 2U);
+
+        const auto& const_queue = queue;
+        const auto const_bucket = const_queue[1U];
+        CATCH_CHECK(std::size(const_bucket) == 2U);
+        CATCH_CHECK(const_bucket.front() == 1);
+
+        bucket.pop();
+        CATCH_CHECK(bucket.front() == 2);
+        bucket.clear();
+        CATCH_CHECK_THAT(bucket, CM::IsEmpty());
+        CATCH_CHECK(queue.empty());
+    }
+}
+
+} // namespace
@@ -0,0 +1,236 @@
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_container_properties.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <whirlwind/container/heap.hpp>
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("IndexedDAryHeap", "[container]")
+{
+    using Heap = ww::IndexedDAryHeap<char, int>;
+    auto heap = Heap(5U);
+
+    CATCH_SECTION("IndexedDAryHeap")
+    {
+        CATCH_CHECK(heap.empty());
+        CATCH_CHECK(heap.size() == 0U);
+        CATCH_CHECK(Heap::arity() == 4U);
+        for (std::size_t i = 0; i < 5U; ++i) {
+            CATCH_CHECK_FALSE(heap.contains(i));
+        }
+    }
+
+    CATCH_SECTION("{value,key}_type")
+    {
+        CATCH_STATIC_REQUIRE((std::is_same_v<Heap::value_type, std::pair<char, int>>));
+        CATCH_STATIC_REQUIRE((std::is_same_v<Heap::key_type, int>));
+    }
+
+    CATCH_SECTION("push")
+    {
+        heap.push(3U, 'd', 30);
+        heap.push(0U, 'a', 10);
+        heap.push(1U, 'b', 20);
+
+        CATCH_CHECK(heap.size() == 3U);
+        CATCH_CHECK(heap.contains(0U));
+        CATCH_CHECK(heap.contains(1U));
+        CATCH_CHECK_FALSE(heap.contains(2U));
+        CATCH_CHECK(heap.contains(3U));
+        CATCH_CHECK(heap.key(3U) == 30);
+
+        const auto [value, key] = heap.top();
+        CATCH_CHECK(value == 'a');
+        CATCH_CHECK(key == 10);
+    }
+
+    CATCH_SECTION("push (out of range)")
+    {
+        heap.push(99U, 'z', 1);
+        CATCH_CHECK(heap.contains(99U));
+        CATCH_CHECK(heap.top().first == 'z');
+    }
+
+    CATCH_SECTION("decrease_key")
+    {
+        heap.push(0U, 'a', 10);
+        heap.push(1U, 'b', 20);
+        heap.push(2U, 'c', 30);
+
+        heap.decrease_key(2U, 5);
+        CATCH_CHECK(heap.size() == 3U);
+        CATCH_CHECK(heap.key(2U) == 5);
+        CATCH_CHECK(heap.top().first == 'c');
+    }
+
+    CATCH_SECTION("pop")
+    {
+        heap.push(0U, 'a', 10);
+        heap.push(1U, 'b', 20);
+        heap.pop();
+
+        CATCH_CHECK(heap.size() == 1U);
+        CATCH_CHECK_FALSE(heap.contains(0U));
+        CATCH_CHECK(heap.contains(1U));
+        CATCH_CHECK(heap.top().first == 'b');
+
+        heap.pop();
+        CATCH_CHECK(heap.empty());
+        CATCH_CHECK_FALSE(heap.contains(1U));
+
+        // An index may be re-inserted after it has been removed.
+        heap.push(0U, 'a', 0);
+        CATCH_CHECK(heap.contains(0U));
+    }
+
+    CATCH_SECTION("clear")
+    {
+        heap.push(0U, 'a', 10);
+        heap.push(4U, 'e', 20);
+        heap.clear();
+
+        CATCH_CHECK(heap.empty());
+        CATCH_CHECK_FALSE(heap.contains(0U));
+        CATCH_CHECK_FALSE(heap.contains(4U));
+    }
+}
+
+CATCH_TEMPLATE_TEST_CASE("IndexedDAryHeap (sorted)",
+                         "[container]",
+                         (std::integral_constant<std::size_t, 2>),
+                         (std::integral_constant<std::size_t, 3>),
+                         (std::integral_constant<std::size_t, 8>))
+{
+    constexpr auto arity = TestType::value;
+    using Heap = ww::IndexedDAryHeap<std::size_t, int, ww::Vector, arity>;
+
+    const auto keys = std::vector<int>{7, 3, 9, 1, 8, 2, 6, 0, 5, 4, 11, 10};
+    auto heap = Heap(std::size(keys));
+    for (std::size_t i = 0; i < std::size(keys); ++i) {
+        heap.push(i, i, 100 + keys[i]);
+    }
+
+    // Decrease every other key to its final value.
+    for (std::size_t i = 0; i < std::size(keys); i += 2) {
+        heap.decrease_key(i, keys[i]);
+    }
+    for (std::size_t i = 1; i < std::size(keys); i += 2) {
+        heap.decrease_key(i, keys[i]);
+    }
+
+    auto popped = std::vector<int>();
+    while (!heap.empty()) {
+        popped.push_back(heap.top().second);
+        heap.pop();
+    }
+
+    const auto expected = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    CATCH_CHECK_THAT(popped, CM::RangeEquals(expected));
+}
+
+CATCH_TEST_CASE("RadixHeap", "[container]")
+{
+    using Heap = ww::RadixHeap<char, int>;
+    auto heap = Heap();
+
+    CATCH_SECTION("RadixHeap")
+    {
+        CATCH_CHECK(heap.empty());
+        CATCH_CHECK(heap.size() == 0U);
+        CATCH_CHECK(heap.lower_bound() == 0);
+        CATCH_CHECK(Heap::num_buckets() == 33U);
+    }
+
+    CATCH_SECTION("{value,key}_type")
+    {
+        CATCH_STATIC_REQUIRE((std::is_same_v<Heap::value_type, std::pair<char, int>>));
+        CATCH_STATIC_REQUIRE((std::is_same_v<Heap::key_type, int>));
+    }
+
+    CATCH_SECTION("push")
+    {
+        heap.push({'d', 30});
+        heap.emplace('a', 10);
+        heap.emplace('b', 20);
+        CATCH_CHECK(heap.size() == 3U);
+
+        const auto [value, key] = heap.top();
+        CATCH_CHECK(value == 'a');
+        CATCH_CHECK(key == 10);
+        CATCH_CHECK(heap.lower_bound() == 10);
+    }
+
+    CATCH_SECTION("pop")
+    {
+        heap.emplace('b', 20);
+        heap.emplace('a', 10);
+        heap.pop();
+        CATCH_CHECK(heap.size() == 1U);
+
+        // Keys >= the lower bound may be inserted after popping.
+        heap.emplace('c', 15);
+        CATCH_CHECK(heap.top().first == 'c');
+        heap.pop();
+        CATCH_CHECK(heap.top().first == 'b');
+        heap.pop();
+        CATCH_CHECK(heap.empty());
+    }
+
+    CATCH_SECTION("clear")
+    {
+        heap.emplace('a', 10);
+        heap.emplace('b', 20);
+        CATCH_CHECK(heap.top().first == 'a');
+        heap.clear();
+
+        CATCH_CHECK(heap.empty());
+        CATCH_CHECK(heap.lower_bound() == 0);
+
+        // After clearing, keys smaller than the previous lower bound may be inserted.
+        heap.emplace('c', 5);
+        CATCH_CHECK(heap.top().first == 'c');
+    }
+}
+
+CATCH_TEST_CASE("RadixHeap (sorted)", "[container]")
+{
+    using Heap = ww::RadixHeap<std::size_t, unsigned>;
+    auto heap = Heap();
+
+    // Simulate a Dijkstra-like workload: each popped key `k` inserts new keys >= `k`.
+    heap.emplace(0U, 0U);
+    auto popped = std::vector<unsigned>();
+    while (!heap.empty()) {
+        const auto [value, key] = heap.top();
+        heap.pop();
+        popped.push_back(key);
+        if (value < 64U) {
+            heap.emplace(2U * value + 1U, key + static_cast<unsigned>(value % 7U));
+            heap.emplace(2U * value + 2U, key + 1000U + static_cast<unsigned>(value));
+        }
+    }
+
+    CATCH_CHECK(std::size(popped) == 129U);
+    CATCH_CHECK(std::is_sorted(popped.begin(), popped.end()));
+}
+
+CATCH_TEST_CASE("AddressableHeapType", "[container]")
+{
+    CATCH_STATIC_REQUIRE(ww::AddressableHeapType<ww::IndexedDAryHeap<int, int>>);
+    CATCH_STATIC_REQUIRE_FALSE(ww::AddressableHeapType<ww::BinaryHeap<int, int>>);
+    CATCH_STATIC_REQUIRE_FALSE(ww::AddressableHeapType<ww::RadixHeap<int, int>>);
+}
+
+} // namespace
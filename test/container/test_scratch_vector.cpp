@@ -0,0 +1,221 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <whirlwind/container/scratch_vector.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+namespace {
+
+// The total number of calls to the global `operator new`, counted in order to check
+// that memory is allocated from a `ScratchArena` rather than from the heap.
+std::atomic<std::size_t> num_heap_allocations = 0;
+
+} // namespace
+
+// Replace the global allocation functions in order to count heap allocations. The
+// array forms and sized deallocation functions call these by default.
+auto
+operator new(std::size_t size) -> void*
+{
+    num_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc((size == 0) ? 1 : size)) { // NOLINT
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p); // NOLINT
+}
+
+void
+operator delete(void* p, std::size_t /* size */) noexcept
+{
+    std::free(p); // NOLINT
+}
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("ScratchArena", "[container]")
+{
+    auto arena = ww::ScratchArena(1024U);
+
+    CATCH_SECTION("ScratchArena")
+    {
+        CATCH_CHECK(arena.capacity() == 1024U);
+        CATCH_CHECK(arena.size() == 0U);
+        CATCH_CHECK(arena.empty());
+    }
+
+    CATCH_SECTION("allocate/deallocate")
+    {
+        auto* p = arena.allocate(10U, alignof(int));
+        CATCH_CHECK(arena.owns(p));
+        CATCH_CHECK(arena.size() >= 10U);
+        CATCH_CHECK(!arena.empty());
+
+        auto* q = arena.allocate(20U, alignof(double));
+        CATCH_CHECK(arena.owns(q));
+        CATCH_CHECK(reinterpret_cast<std::uintptr_t>(q) % alignof(double) == 0U);
+        CATCH_CHECK(static_cast<std::byte*>(q) >= static_cast<std::byte*>(p) + 10);
+
+        arena.deallocate(q, 20U);
+        arena.deallocate(p, 10U);
+        CATCH_CHECK(arena.empty());
+    }
+
+    CATCH_SECTION("out-of-order deallocation")
+    {
+        auto* p = arena.allocate(10U, alignof(int));
+        auto* q = arena.allocate(20U, alignof(int));
+        const auto size = arena.size();
+
+        // Deallocating a block below the top of the stack doesn't reclaim its memory
+        // until the blocks above it are deallocated as well.
+        arena.deallocate(p, 10U);
+        CATCH_CHECK(arena.size() == size);
+
+        arena.deallocate(q, 20U);
+        CATCH_CHECK(arena.empty());
+    }
+
+    CATCH_SECTION("capacity exceeded")
+    {
+        CATCH_CHECK_THROWS_AS(arena.allocate(2048U, alignof(int)), std::bad_alloc);
+        CATCH_CHECK(arena.empty());
+
+        auto* p = arena.allocate(1000U, alignof(int));
+        CATCH_CHECK_THROWS_AS(arena.allocate(100U, alignof(int)), std::bad_alloc);
+        arena.deallocate(p, 1000U);
+        CATCH_CHECK(arena.empty());
+    }
+}
+
+CATCH_TEST_CASE("ScratchVector", "[container]")
+{
+    auto arena = ww::ScratchArena(4096U);
+    const auto scope = ww::ScratchArenaScope(arena);
+
+    CATCH_SECTION("ScratchAllocator")
+    {
+        const auto allocator = ww::ScratchAllocator<int>();
+        CATCH_CHECK(allocator.arena() == &arena);
+        CATCH_CHECK(allocator == ww::ScratchAllocator<double>(arena));
+
+        auto other_arena = ww::ScratchArena(16U);
+        CATCH_CHECK(allocator != ww::ScratchAllocator<int>(other_arena));
+    }
+
+    CATCH_SECTION("ScratchArenaScope")
+    {
+        auto other_arena = ww::ScratchArena(16U);
+        {
+            const auto other_scope = ww::ScratchArenaScope(other_arena);
+            CATCH_CHECK(ww::ScratchAllocator<int>().arena() == &other_arena);
+        }
+        CATCH_CHECK(ww::ScratchAllocator<int>().arena() == &arena);
+    }
+
+    CATCH_SECTION("push_back")
+    {
+        {
+            auto vector = ww::ScratchVector<int>();
+            for (int i = 0; i < 100; ++i) {
+                vector.push_back(i);
+            }
+            CATCH_CHECK(arena.owns(vector.data()));
+
+            auto expected = std::vector<int>(100U);
+            std::iota(expected.begin(), expected.end(), 0);
+            CATCH_CHECK_THAT(vector, CM::RangeEquals(expected));
+        }
+        CATCH_CHECK(arena.empty());
+    }
+
+    CATCH_SECTION("nested")
+    {
+        {
+            auto outer = ww::ScratchVector<ww::ScratchVector<int>>(3U);
+            outer[0].assign(10U, 1);
+            outer[1].assign(20U, 2);
+            outer[2].assign(30U, 3);
+            CATCH_CHECK(arena.owns(outer[2].data()));
+            CATCH_CHECK(outer[1].size() == 20U);
+        }
+        CATCH_CHECK(arena.empty());
+    }
+}
+
+CATCH_TEST_CASE("ScratchVector (heap allocations)", "[container]")
+{
+    auto arena = ww::ScratchArena(1U << 20U);
+
+    CATCH_SECTION("push_back")
+    {
+        // Test assertions may allocate, so results are only checked afterwards.
+        auto size = std::size_t{0};
+        const auto before = num_heap_allocations.load();
+        {
+            const auto scope = ww::ScratchArenaScope(arena);
+            auto outer = ww::ScratchVector<ww::ScratchVector<int>>();
+            for (int i = 0; i < 100; ++i) {
+                outer.emplace_back(static_cast<std::size_t>(i), i);
+            }
+            size = outer[99].size();
+        }
+        CATCH_CHECK(num_heap_allocations.load() == before);
+        CATCH_CHECK(size == 99U);
+        CATCH_CHECK(arena.empty());
+    }
+
+    CATCH_SECTION("primal_dual")
+    {
+        // Solving a network over a fixed-size grid doesn't allocate from the heap if
+        // the network & solver store all of their state in scratch containers.
+        using Graph = ww::FixedRectangularGridGraph<16, 12>;
+        using Mixin = ww::UnitCapacityMixin<Graph, int, ww::ScratchVector>;
+        using Network = ww::Network<Graph, int, int, ww::ScratchVector, Mixin>;
+        using ResidualGraph = Network::residual_graph_type;
+        using Dijkstra = ww::Dijkstra<int, ResidualGraph, ww::ScratchVector>;
+
+        const auto graph = Graph();
+        auto surplus = std::vector<int>(graph.num_vertices(), 0);
+        surplus[0] = 1;
+        surplus[5] = 1;
+        surplus[100] = -1;
+        surplus[191] = -1;
+        const auto cost = std::vector<int>(graph.num_edges(), 1);
+
+        auto is_balanced = false;
+        const auto before = num_heap_allocations.load();
+        {
+            const auto scope = ww::ScratchArenaScope(arena);
+            auto network = Network(graph, surplus, cost);
+            ww::primal_dual<Dijkstra>(network);
+            is_balanced = network.is_balanced();
+        }
+        CATCH_CHECK(num_heap_allocations.load() == before);
+        CATCH_CHECK(is_balanced);
+        CATCH_CHECK(arena.empty());
+    }
+}
+
+} // namespace
@@ -0,0 +1,132 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/bidirectional_csr_graph.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+
+#include "../testing/matchers/graph_matchers.hpp"
+#include "../testing/string_conversions.hpp" // IWYU pragma: keep
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("BidirectionalCSRGraph (empty)", "[graph]")
+{
+    const auto graph = ww::BidirectionalCSRGraph();
+
+    CATCH_CHECK(graph.num_vertices() == 0U);
+    CATCH_CHECK(graph.num_edges() == 0U);
+    CATCH_CHECK_THAT(graph, !ww::testing::ContainsVertex(0U));
+    CATCH_CHECK_THAT(graph, !ww::testing::ContainsEdge(0U));
+}
+
+CATCH_TEST_CASE("BidirectionalCSRGraph", "[graph]")
+{
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 1U);
+    edgelist.add_edge(0U, 2U);
+    edgelist.add_edge(0U, 3U);
+    edgelist.add_edge(2U, 1U);
+    edgelist.add_edge(3U, 0U);
+
+    const auto graph = ww::BidirectionalCSRGraph(edgelist);
+
+    using Vertex = decltype(graph)::vertex_type;
+    using Edge = decltype(graph)::edge_type;
+    using Pair = std::pair<Edge, Vertex>;
+
+    const auto vertices = {0U, 1U, 2U, 3U};
+
+    CATCH_SECTION("num_{vertices,edges}")
+    {
+        CATCH_CHECK(graph.num_vertices() == 4U);
+        CATCH_CHECK(graph.num_edges() == 5U);
+    }
+
+    CATCH_SECTION("outgoing_edges")
+    {
+        const auto outgoing_edges = {Pair(0U, 1U), Pair(1U, 2U), Pair(2U, 3U)};
+        CATCH_CHECK_THAT(graph.outgoing_edges(0U), CM::RangeEquals(outgoing_edges));
+    }
+
+    CATCH_SECTION("indegree")
+    {
+        CATCH_CHECK(graph.indegree(0U) == 1U);
+        CATCH_CHECK(graph.indegree(1U) == 2U);
+        CATCH_CHECK(graph.indegree(2U) == 1U);
+        CATCH_CHECK(graph.indegree(3U) == 1U);
+    }
+
+    CATCH_SECTION("incoming_edges")
+    {
+        const auto incoming_edges_0 = {Pair(4U, 3U)};
+        CATCH_CHECK_THAT(graph.incoming_edges(0U), CM::RangeEquals(incoming_edges_0));
+
+        const auto incoming_edges_1 = {Pair(0U, 0U), Pair(3U, 2U)};
+        CATCH_CHECK_THAT(graph.incoming_edges(1U), CM::RangeEquals(incoming_edges_1));
+
+        const auto incoming_edges_2 = {Pair(1U, 0U)};
+        CATCH_CHECK_THAT(graph.incoming_edges(2U), CM::RangeEquals(incoming_edges_2));
+
+        const auto incoming_edges_3 = {Pair(2U, 0U)};
+        CATCH_CHECK_THAT(graph.incoming_edges(3U), CM::RangeEquals(incoming_edges_3));
+    }
+
+    CATCH_SECTION("for_each_incoming_edge")
+    {
+        for (const auto& vertex : vertices) {
+            auto visited = std::vector<Pair>();
+            auto visit = [&](const auto& edge, const auto& tail) {
+                visited.emplace_back(edge, tail);
+            };
+            graph.for_each_incoming_edge(vertex, visit);
+            CATCH_CHECK_THAT(visited, CM::RangeEquals(graph.incoming_edges(vertex)));
+        }
+    }
+}
+
+CATCH_TEST_CASE("BidirectionalCSRGraph (transpose)", "[graph]")
+{
+    // A random multigraph with parallel edges and self-loops.
+    const auto num_vertices = std::size_t{50};
+    const auto num_edges = std::size_t{400};
+
+    auto rng = std::mt19937(1234U);
+    auto vertex_dist = std::uniform_int_distribution<std::uint32_t>(0U, 49U);
+    auto edgelist = ww::EdgeList<std::uint32_t>();
+    for (std::size_t i = 0; i < num_edges; ++i) {
+        edgelist.add_edge(vertex_dist(rng), vertex_dist(rng));
+    }
+
+    using Graph = ww::BidirectionalCSRGraph<ww::Vector, std::uint32_t>;
+    const auto graph = Graph(edgelist, num_vertices);
+
+    using Pair = std::pair<std::uint32_t, std::uint32_t>;
+
+    // Find the incoming edges of each vertex by searching the outgoing edges of all
+    // vertices, in order of edge ID.
+    auto expected = std::vector<std::vector<Pair>>(num_vertices);
+    for (const auto& tail : graph.vertices()) {
+        graph.for_each_outgoing_edge(tail, [&](const auto& edge, const auto& head) {
+            expected[head].emplace_back(edge, tail);
+        });
+    }
+
+    for (const auto& vertex : graph.vertices()) {
+        CATCH_CHECK(graph.indegree(vertex) == expected[vertex].size());
+        CATCH_CHECK_THAT(graph.incoming_edges(vertex),
+                         CM::RangeEquals(expected[vertex]));
+    }
+}
+
+} // namespace
@@ -1,11 +1,14 @@
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_range_equals.hpp>
 
+#include <whirlwind/container/vector.hpp>
 #include <whirlwind/graph/csr_graph.hpp>
 #include <whirlwind/graph/edge_list.hpp>
 
@@ -110,6 +113,18 @@ CATCH_TEST_CASE("CSRGraph", "[graph]")
         const auto outgoing_edges = {Pair(0U, 1U), Pair(1U, 2U), Pair(2U, 3U)};
         CATCH_CHECK_THAT(graph.outgoing_edges(0U), CM::RangeEquals(outgoing_edges));
     }
+
+    CATCH_SECTION("for_each_outgoing_edge")
+    {
+        using Pair = std::pair<Edge, Vertex>;
+        for (const auto& vertex : vertices) {
+            auto visited = std::vector<Pair>();
+            graph.for_each_outgoing_edge(vertex, [&](const auto& edge, const auto& head) {
+                visited.emplace_back(edge, head);
+            });
+            CATCH_CHECK_THAT(visited, CM::RangeEquals(graph.outgoing_edges(vertex)));
+        }
+    }
 }
 
 CATCH_TEST_CASE("CSRGraph (nonconsecutive vertices)", "[graph]")
@@ -268,4 +283,123 @@ CATCH_TEST_CASE("CSRGraph (self loops)", "[graph]")
     }
 }
 
+CATCH_TEST_CASE("CSRGraph (num_vertices)", "[graph]")
+{
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(2U, 0U);
+    edgelist.add_edge(0U, 3U);
+    edgelist.add_edge(2U, 1U);
+    edgelist.add_edge(0U, 1U);
+    edgelist.add_edge(0U, 2U);
+
+    using Graph = ww::CSRGraph<>;
+    using Edge = Graph::edge_type;
+    using Vertex = Graph::vertex_type;
+    using Pair = std::pair<Edge, Vertex>;
+
+    CATCH_SECTION("num_{vertices,edges}")
+    {
+        const auto graph = Graph(edgelist, 6U);
+        CATCH_CHECK(graph.num_vertices() == 6U);
+        CATCH_CHECK(graph.num_edges() == 5U);
+        CATCH_CHECK(graph.outdegree(4U) == 0U);
+        CATCH_CHECK(graph.outdegree(5U) == 0U);
+    }
+
+    CATCH_SECTION("sorted")
+    {
+        const auto graph = Graph(edgelist, 4U, 1U, ww::EdgeOrder::sorted);
+
+        const auto outgoing_edges0 = {Pair(0U, 1U), Pair(1U, 2U), Pair(2U, 3U)};
+        CATCH_CHECK_THAT(graph.outgoing_edges(0U), CM::RangeEquals(outgoing_edges0));
+
+        const auto outgoing_edges2 = {Pair(3U, 0U), Pair(4U, 1U)};
+        CATCH_CHECK_THAT(graph.outgoing_edges(2U), CM::RangeEquals(outgoing_edges2));
+    }
+
+    CATCH_SECTION("stable")
+    {
+        const auto graph = Graph(edgelist, 4U, 1U, ww::EdgeOrder::stable);
+
+        const auto outgoing_edges0 = {Pair(0U, 3U), Pair(1U, 1U), Pair(2U, 2U)};
+        CATCH_CHECK_THAT(graph.outgoing_edges(0U), CM::RangeEquals(outgoing_edges0));
+
+        const auto outgoing_edges2 = {Pair(3U, 0U), Pair(4U, 1U)};
+        CATCH_CHECK_THAT(graph.outgoing_edges(2U), CM::RangeEquals(outgoing_edges2));
+    }
+}
+
+CATCH_TEST_CASE("CSRGraph (parallel construction)", "[graph]")
+{
+    // Large enough that construction is split among multiple threads.
+    const auto num_vertices = std::size_t{1000};
+    const auto num_edges = std::size_t{300'000};
+
+    auto edgelist = ww::EdgeList();
+    for (std::size_t i = 0; i < num_edges; ++i) {
+        const auto tail = (i * 7919U) % num_vertices;
+        const auto head = (i * 104729U + 13U) % num_vertices;
+        edgelist.add_edge(tail, head);
+    }
+
+    using Graph = ww::CSRGraph<>;
+
+    for (const auto order : {ww::EdgeOrder::sorted, ww::EdgeOrder::stable}) {
+        const auto expected = Graph(edgelist, num_vertices, 1U, order);
+        const auto graph = Graph(edgelist, num_vertices, 4U, order);
+
+        CATCH_CHECK(graph.num_vertices() == num_vertices);
+        CATCH_CHECK(graph.num_edges() == num_edges);
+        for (const auto& vertex : expected.vertices()) {
+            CATCH_CHECK_THAT(graph.outgoing_edges(vertex),
+                             CM::RangeEquals(expected.outgoing_edges(vertex)));
+        }
+    }
+
+    // The edge list constructor sorts the outgoing edges of each vertex by head.
+    const auto graph = Graph(edgelist);
+    const auto expected = Graph(edgelist, num_vertices, 4U, ww::EdgeOrder::sorted);
+    CATCH_CHECK(graph.num_vertices() == num_vertices);
+    for (const auto& vertex : expected.vertices()) {
+        CATCH_CHECK_THAT(graph.outgoing_edges(vertex),
+                         CM::RangeEquals(expected.outgoing_edges(vertex)));
+    }
+}
+
+CATCH_TEST_CASE("CSRGraph (32-bit indices)", "[graph]")
+{
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 3U);
+    edgelist.add_edge(2U, 1U);
+    edgelist.add_edge(0U, 2U);
+    edgelist.add_edge(3U, 0U);
+    edgelist.add_edge(0U, 1U);
+
+    using Graph = ww::CSRGraph<ww::Vector, std::uint32_t>;
+    const auto graph = Graph(edgelist);
+
+    CATCH_SECTION("{vertex,edge,size}_type")
+    {
+        CATCH_STATIC_REQUIRE((std::is_same_v<Graph::vertex_type, std::uint32_t>));
+        CATCH_STATIC_REQUIRE((std::is_same_v<Graph::edge_type, std::uint32_t>));
+        CATCH_STATIC_REQUIRE((std::is_same_v<Graph::size_type, std::size_t>));
+    }
+
+    CATCH_SECTION("num_{vertices,edges}")
+    {
+        CATCH_CHECK(graph.num_vertices() == 4U);
+        CATCH_CHECK(graph.num_edges() == 5U);
+    }
+
+    CATCH_SECTION("outgoing_edges")
+    {
+        using Pair = std::pair<std::uint32_t, std::uint32_t>;
+        const auto outgoing_edges0 = {Pair(0U, 1U), Pair(1U, 2U), Pair(2U, 3U)};
+        CATCH_CHECK_THAT(graph.outgoing_edges(0U), CM::RangeEquals(outgoing_edges0));
+
+        const auto outgoing_edges2 = {Pair(3U, 1U)};
+        CATCH_CHECK_THAT(graph.outgoing_edges(2U), CM::RangeEquals(outgoing_edges2));
+    }
+}
+
 } // namespace
@@ -0,0 +1,168 @@
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/csr_graph_view.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+
+#include "../testing/matchers/graph_matchers.hpp"
+#include "../testing/string_conversions.hpp" // IWYU pragma: keep
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("CSRGraphView (empty)", "[graph]")
+{
+    const auto graph = ww::CSRGraphView();
+
+    CATCH_SECTION("num_{vertices,edges}")
+    {
+        CATCH_CHECK(graph.num_vertices() == 0U);
+        CATCH_CHECK(graph.num_edges() == 0U);
+    }
+
+    CATCH_SECTION("contains_{vertex,edge}")
+    {
+        CATCH_CHECK_THAT(graph, !ww::testing::ContainsVertex(0U));
+        CATCH_CHECK_THAT(graph, !ww::testing::ContainsEdge(0U));
+    }
+}
+
+CATCH_TEST_CASE("CSRGraphView", "[graph]")
+{
+    // Externally owned row & column index arrays.
+    const auto row_offsets = std::vector<std::size_t>{0U, 3U, 3U, 4U, 5U};
+    const auto col_indices = std::vector<std::size_t>{1U, 2U, 3U, 1U, 0U};
+
+    const auto graph = ww::CSRGraphView(row_offsets, col_indices);
+
+    using Vertex = decltype(graph)::vertex_type;
+    using Edge = decltype(graph)::edge_type;
+    using Size = decltype(graph)::size_type;
+
+    const auto vertices = {0U, 1U, 2U, 3U};
+    const auto edges = {0U, 1U, 2U, 3U, 4U};
+
+    CATCH_SECTION("{vertex,edge,size}_type")
+    {
+        CATCH_STATIC_REQUIRE((std::is_same_v<Vertex, std::size_t>));
+        CATCH_STATIC_REQUIRE((std::is_same_v<Edge, std::size_t>));
+        CATCH_STATIC_REQUIRE((std::is_same_v<Size, std::size_t>));
+    }
+
+    CATCH_SECTION("{row_offsets,col_indices}")
+    {
+        CATCH_CHECK(graph.row_offsets().data() == row_offsets.data());
+        CATCH_CHECK(graph.col_indices().data() == col_indices.data());
+    }
+
+    CATCH_SECTION("num_{vertices,edges}")
+    {
+        CATCH_CHECK(graph.num_vertices() == 4U);
+        CATCH_CHECK(graph.num_edges() == 5U);
+    }
+
+    CATCH_SECTION("{vertices,edges}")
+    {
+        CATCH_CHECK_THAT(graph.vertices(), CM::RangeEquals(vertices));
+        CATCH_CHECK_THAT(graph.edges(), CM::RangeEquals(edges));
+    }
+
+    CATCH_SECTION("contains_{vertex,edge}")
+    {
+        using ww::testing::ContainsVertex;
+        CATCH_CHECK_THAT(graph, ContainsVertex(3U));
+        CATCH_CHECK_THAT(graph, !ContainsVertex(4U));
+
+        using ww::testing::ContainsEdge;
+        CATCH_CHECK_THAT(graph, ContainsEdge(4U));
+        CATCH_CHECK_THAT(graph, !ContainsEdge(5U));
+    }
+
+    CATCH_SECTION("outdegree")
+    {
+        CATCH_CHECK(graph.outdegree(0U) == 3U);
+        CATCH_CHECK(graph.outdegree(1U) == 0U);
+        CATCH_CHECK(graph.outdegree(2U) == 1U);
+        CATCH_CHECK(graph.outdegree(3U) == 1U);
+    }
+
+    CATCH_SECTION("outgoing_edges")
+    {
+        using Pair = std::pair<Edge, Vertex>;
+        const auto outgoing_edges = {Pair(0U, 1U), Pair(1U, 2U), Pair(2U, 3U)};
+        CATCH_CHECK_THAT(graph.outgoing_edges(0U), CM::RangeEquals(outgoing_edges));
+        CATCH_CHECK(std::empty(graph.outgoing_edges(1U)));
+    }
+
+    CATCH_SECTION("for_each_outgoing_edge")
+    {
+        using Pair = std::pair<Edge, Vertex>;
+        for (const auto& vertex : vertices) {
+            auto visited = std::vector<Pair>();
+            graph.for_each_outgoing_edge(vertex, [&](const auto& edge, const auto& head) {
+                visited.emplace_back(edge, head);
+            });
+            CATCH_CHECK_THAT(visited, CM::RangeEquals(graph.outgoing_edges(vertex)));
+        }
+    }
+}
+
+CATCH_TEST_CASE("CSRGraph.view", "[graph]")
+{
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 1U);
+    edgelist.add_edge(0U, 2U);
+    edgelist.add_edge(2U, 1U);
+    edgelist.add_edge(3U, 0U);
+
+    const auto graph = ww::CSRGraph(edgelist);
+    const auto view = graph.view();
+
+    CATCH_CHECK(view.num_vertices() == graph.num_vertices());
+    CATCH_CHECK(view.num_edges() == graph.num_edges());
+    for (const auto& vertex : graph.vertices()) {
+        CATCH_CHECK_THAT(view.outgoing_edges(vertex),
+                         CM::RangeEquals(graph.outgoing_edges(vertex)));
+    }
+}
+
+CATCH_TEST_CASE("Dijkstra (CSRGraphView)", "[graph]")
+{
+    const auto row_offsets = std::vector<std::size_t>{0U, 2U, 3U, 4U, 4U};
+    const auto col_indices = std::vector<std::size_t>{1U, 2U, 3U, 3U};
+    const auto edge_lengths = std::vector<int>{1, 5, 1, 1};
+
+    using Graph = ww::CSRGraphView<>;
+    const auto graph = Graph(row_offsets, col_indices);
+
+    auto dijkstra = ww::Dijkstra<int, Graph>(graph);
+    dijkstra.add_source(0U);
+    while (!dijkstra.done()) {
+        const auto [tail, distance] = dijkstra.pop_next_unvisited_vertex();
+        dijkstra.visit_vertex(tail, distance);
+        for (const auto& [edge, head] : graph.outgoing_edges(tail)) {
+            const auto head_distance = distance + edge_lengths[edge];
+            if (!dijkstra.has_visited_vertex(head) &&
+                head_distance < dijkstra.distance_to_vertex(head)) {
+                dijkstra.relax_edge(edge, tail, head, head_distance);
+            }
+        }
+    }
+
+    CATCH_CHECK(dijkstra.distance_to_vertex(1U) == 1);
+    CATCH_CHECK(dijkstra.distance_to_vertex(2U) == 5);
+    CATCH_CHECK(dijkstra.distance_to_vertex(3U) == 2);
+    CATCH_CHECK(dijkstra.predecessor_vertex(3U) == 1U);
+}
+
+} // namespace
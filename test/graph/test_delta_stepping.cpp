@@ -0,0 +1,270 @@
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_quantifiers.hpp>
+#include <range/v3/view/transform.hpp>
+#include <range/v3/view/zip.hpp>
+
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/delta_stepping.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+
+#include "../testing/matchers/forest_matchers.hpp"
+#include "../testing/matchers/range_matchers.hpp"
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("DeltaStepping", "[graph]")
+{
+    using Distance = int;
+    using Graph = ww::CSRGraph<>;
+
+    constexpr auto max_distance = std::numeric_limits<Distance>::max();
+
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 1U);
+    edgelist.add_edge(1U, 2U);
+    edgelist.add_edge(2U, 3U);
+
+    const auto graph = Graph(edgelist);
+    const auto delta = 10;
+    const auto max_edge_length = 100;
+    const auto num_threads = 2U;
+
+    auto delta_stepping = ww::DeltaStepping<Distance, Graph>(
+            graph, delta, max_edge_length, num_threads);
+
+    using Distance_ = decltype(delta_stepping)::distance_type;
+    using Graph_ = decltype(delta_stepping)::graph_type;
+    using Vertex = decltype(delta_stepping)::vertex_type;
+    using Edge = decltype(delta_stepping)::edge_type;
+    using Size = decltype(delta_stepping)::size_type;
+
+    CATCH_SECTION("DeltaStepping")
+    {
+        CATCH_CHECK(std::addressof(delta_stepping.graph()) == std::addressof(graph));
+        CATCH_CHECK(delta_stepping.bucket_width() == delta);
+        CATCH_CHECK(delta_stepping.num_threads() == num_threads);
+        CATCH_CHECK(delta_stepping.num_buckets() == 12U);
+        CATCH_CHECK(delta_stepping.current_bucket_id() == 0U);
+
+        CATCH_CHECK(delta_stepping.done());
+
+        using ww::testing::WasReachedBy;
+        CATCH_CHECK_THAT(graph.vertices(),
+                         CM::NoneMatch(WasReachedBy(delta_stepping)));
+
+        const auto distances =
+                graph.vertices() | ranges::views::transform([&](const auto& vertex) {
+                    return delta_stepping.distance_to_vertex(vertex);
+                });
+        CATCH_CHECK_THAT(distances, ww::testing::AllEqualTo(max_distance));
+    }
+
+    CATCH_SECTION("{distance,graph,vertex,edge,size}_type")
+    {
+        CATCH_STATIC_REQUIRE((std::is_same_v<Distance_, Distance>));
+        CATCH_STATIC_REQUIRE((std::is_same_v<Graph_, Graph>));
+        CATCH_STATIC_REQUIRE((std::is_same_v<Vertex, Graph::vertex_type>));
+        CATCH_STATIC_REQUIRE((std::is_same_v<Edge, Graph::edge_type>));
+        CATCH_STATIC_REQUIRE((std::is_same_v<Size, std::size_t>));
+    }
+
+    CATCH_SECTION("get_bucket_id")
+    {
+        CATCH_CHECK(delta_stepping.get_bucket_id(0) == 0U);
+        CATCH_CHECK(delta_stepping.get_bucket_id(9) == 0U);
+        CATCH_CHECK(delta_stepping.get_bucket_id(10) == 1U);
+        CATCH_CHECK(delta_stepping.get_bucket_id(111) == 11U);
+    }
+
+    CATCH_SECTION("pop_next_unvisited_vertex")
+    {
+        const auto source = 0U;
+        delta_stepping.add_source(source);
+        CATCH_CHECK_FALSE(delta_stepping.done());
+
+        const auto [vertex, distance] = delta_stepping.pop_next_unvisited_vertex();
+        CATCH_CHECK(vertex == source);
+        CATCH_CHECK(distance == 0);
+    }
+
+    CATCH_SECTION("relax_edge")
+    {
+        const auto source = 0U;
+        delta_stepping.add_source(source);
+
+        const auto [tail, distance] = delta_stepping.pop_next_unvisited_vertex();
+        delta_stepping.visit_vertex(tail, distance);
+
+        const auto edge = 0U;
+        const auto head = 1U;
+        const auto length = 25;
+        delta_stepping.relax_edge(edge, tail, head, distance + length);
+
+        CATCH_CHECK_THAT(head, ww::testing::WasReachedBy(delta_stepping));
+        CATCH_CHECK_THAT(head, !ww::testing::WasVisitedBy(delta_stepping));
+        CATCH_CHECK(delta_stepping.distance_to_vertex(head) == distance + length);
+        CATCH_CHECK(delta_stepping.predecessor_vertex(head) == tail);
+
+        // The search advances to the bucket that contains the head vertex.
+        CATCH_CHECK_FALSE(delta_stepping.done());
+        CATCH_CHECK(delta_stepping.current_bucket_id() == 2U);
+    }
+
+    CATCH_SECTION("reset")
+    {
+        const auto source = 0U;
+        delta_stepping.add_source(source);
+
+        const auto edges = {0U, 1U, 2U};
+        const auto heads = {1U, 2U, 3U};
+        const auto lengths = {1, 10, 100};
+
+        auto tail = source;
+        auto total_distance = 0;
+        for (auto&& [edge, head, length] : ranges::views::zip(edges, heads, lengths)) {
+            delta_stepping.visit_vertex(tail, total_distance);
+            total_distance += length;
+            delta_stepping.relax_edge(edge, tail, head, total_distance);
+            tail = head;
+        }
+
+        delta_stepping.reset();
+
+        CATCH_CHECK(delta_stepping.current_bucket_id() == 0U);
+        CATCH_CHECK(delta_stepping.done());
+
+        using ww::testing::WasReachedBy;
+        CATCH_CHECK_THAT(graph.vertices(),
+                         CM::NoneMatch(WasReachedBy(delta_stepping)));
+    }
+}
+
+CATCH_TEST_CASE("DeltaStepping (sorted)", "[graph]")
+{
+    using Distance = int;
+    using Graph = ww::CSRGraph<>;
+
+    const auto tail = 0U;
+    const auto edges = {0U, 1U, 2U, 3U};
+    const auto heads = {1U, 2U, 3U, 4U};
+    const auto lengths = {100, 1, 1000, 10};
+
+    auto edgelist = ww::EdgeList();
+    for (const auto& head : heads) {
+        edgelist.add_edge(tail, head);
+    }
+
+    const auto graph = Graph(edgelist);
+
+    // The max edge length is deliberately underestimated, so that some vertices are
+    // pushed beyond the end of the ring buffer.
+    for (const auto max_edge_length : {1000, 1}) {
+        auto delta_stepping = ww::DeltaStepping<Distance, Graph>(graph, 10,
+                                                                 max_edge_length, 1U);
+
+        delta_stepping.add_source(tail);
+        delta_stepping.pop_next_unvisited_vertex();
+        delta_stepping.visit_vertex(tail, 0);
+        for (auto&& [edge, head, length] : ranges::views::zip(edges, heads, lengths)) {
+            delta_stepping.relax_edge(edge, tail, head, length);
+        }
+
+        const auto vertices = {2U, 4U, 1U, 3U};
+        const auto distances = {1, 10, 100, 1000};
+        for (auto&& [v, d] : ranges::views::zip(vertices, distances)) {
+            CATCH_CHECK_FALSE(delta_stepping.done());
+            CATCH_CHECK(delta_stepping.current_bucket_id() ==
+                        delta_stepping.get_bucket_id(d));
+            const auto [vertex, distance] = delta_stepping.pop_next_unvisited_vertex();
+            CATCH_CHECK(vertex == v);
+            CATCH_CHECK(distance == d);
+            delta_stepping.visit_vertex(vertex, distance);
+        }
+        CATCH_CHECK(delta_stepping.done());
+    }
+}
+
+CATCH_TEST_CASE("DeltaStepping.run", "[graph]")
+{
+    using Distance = int;
+    using Graph = ww::RectangularGridGraph<>;
+
+    const auto graph = Graph(16U, 12U);
+    const auto sources = std::vector<Graph::vertex_type>{{0U, 0U}, {9U, 7U}};
+
+    // Include many zero-length edges, so that there are many ties.
+    auto get_edge_length = [&](const auto& edge) {
+        const auto edge_id = graph.get_edge_id(edge);
+        return static_cast<Distance>((edge_id * 7U) % 5U);
+    };
+
+    // Get reference distances using Dijkstra's algorithm.
+    auto dijkstra = ww::Dijkstra<Distance, Graph>(graph);
+    for (const auto& source : sources) {
+        dijkstra.add_source(source);
+    }
+    while (!dijkstra.done()) {
+        const auto top = dijkstra.pop_next_unvisited_vertex();
+        using std::get;
+        const auto& tail = get<0>(top);
+        const auto& distance = get<1>(top);
+        dijkstra.visit_vertex(tail, distance);
+        graph.for_each_outgoing_edge(tail, [&](const auto& edge, const auto& head) {
+            dijkstra.relax_edge(edge, tail, head, distance + get_edge_length(edge));
+        });
+    }
+
+    // Run the search twice to check that `reset()` restores the initial state.
+    auto check_run = [&](auto& delta_stepping) {
+        for (int i = 0; i < 2; ++i) {
+            delta_stepping.run(sources,
+                               [&](const auto& edge, const auto&, const auto&) {
+                                   return get_edge_length(edge);
+                               });
+
+            using ww::testing::WasVisitedBy;
+            CATCH_CHECK_THAT(graph.vertices(),
+                             CM::AllMatch(WasVisitedBy(delta_stepping)));
+
+            for (const auto& vertex : graph.vertices()) {
+                const auto distance = delta_stepping.distance_to_vertex(vertex);
+                CATCH_CHECK(distance == dijkstra.distance_to_vertex(vertex));
+
+                if (delta_stepping.is_root_vertex(vertex)) {
+                    CATCH_CHECK(distance == 0);
+                } else {
+                    const auto [tail, edge] = delta_stepping.predecessor(vertex);
+                    const auto tail_distance = delta_stepping.distance_to_vertex(tail);
+                    CATCH_CHECK(tail_distance + get_edge_length(edge) == distance);
+                }
+            }
+
+            delta_stepping.reset();
+            using ww::testing::WasReachedBy;
+            CATCH_CHECK_THAT(graph.vertices(),
+                             CM::NoneMatch(WasReachedBy(delta_stepping)));
+        }
+    };
+
+    for (const auto delta : {1, 3, 100}) {
+        for (const auto num_threads : {1U, 2U, 4U}) {
+            auto delta_stepping =
+                    ww::DeltaStepping<Distance, Graph>(graph, delta, 4, num_threads);
+            check_run(delta_stepping);
+        }
+    }
+}
+
+} // namespace
@@ -52,6 +52,7 @@ CATCH_TEST_CASE("Dial", "[graph]")
     {
         CATCH_CHECK(std::addressof(dial.graph()) == std::addressof(graph));
         CATCH_CHECK(dial.num_buckets() == num_buckets);
+        CATCH_CHECK(dial.max_edge_length() == 100);
 
         CATCH_CHECK(std::size(dial.buckets()) == num_buckets);
         CATCH_CHECK_THAT(dial.buckets(), CM::AllMatch(CM::IsEmpty()));
@@ -101,7 +102,7 @@ CATCH_TEST_CASE("Dial", "[graph]")
         for (auto&& [vertex, distance] : ranges::views::zip(vertices, distances)) {
             const auto bucket_id = dial.get_bucket_id(distance);
             CATCH_CHECK(bucket_id == static_cast<Size>(distance) % num_buckets);
-            auto& bucket = dial.get_bucket(bucket_id);
+            auto bucket = dial.get_bucket(bucket_id);
             CATCH_CHECK(bucket.front() == vertex);
             bucket.pop();
         }
@@ -192,7 +193,7 @@ CATCH_TEST_CASE("Dial", "[graph]")
         CATCH_CHECK(dial.distance_to_vertex(head) == distance + length);
 
         const auto bucket_id = dial.get_bucket_id(distance + length);
-        const auto& bucket = dial.get_bucket(bucket_id);
+        const auto bucket = dial.get_bucket(bucket_id);
         CATCH_CHECK(std::size(bucket) == 1U);
         CATCH_CHECK(bucket.front() == head);
     }
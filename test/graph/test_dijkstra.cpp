@@ -12,6 +12,8 @@
 #include <range/v3/view/transform.hpp>
 #include <range/v3/view/zip.hpp>
 
+#include <whirlwind/container/heap.hpp>
+#include <whirlwind/container/vector.hpp>
 #include <whirlwind/graph/csr_graph.hpp>
 #include <whirlwind/graph/dijkstra.hpp>
 #include <whirlwind/graph/edge_list.hpp>
@@ -282,4 +284,98 @@ CATCH_TEST_CASE("Dijkstra.done (visited)", "[graph]")
     CATCH_CHECK(dijkstra.done());
 }
 
+CATCH_TEST_CASE("Dijkstra (IndexedDAryHeap)", "[graph]")
+{
+    using Distance = int;
+    using Graph = ww::CSRGraph<>;
+    using Heap = ww::IndexedDAryHeap<Graph::vertex_type, Distance>;
+
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 1U);
+    edgelist.add_edge(0U, 2U);
+    edgelist.add_edge(2U, 1U);
+
+    const auto graph = Graph(edgelist);
+
+    auto dijkstra = ww::Dijkstra<Distance, Graph, ww::Vector, Heap>(graph);
+    CATCH_CHECK(dijkstra.done());
+
+    const auto source = 0U;
+    dijkstra.add_source(source);
+    CATCH_CHECK_FALSE(dijkstra.done());
+
+    const auto [vertex0, distance0] = dijkstra.pop_next_unvisited_vertex();
+    CATCH_CHECK(vertex0 == source);
+    dijkstra.visit_vertex(vertex0, distance0);
+    dijkstra.relax_edge(0U, vertex0, 1U, 10);
+    dijkstra.relax_edge(1U, vertex0, 2U, 1);
+    CATCH_CHECK(std::size(dijkstra.heap()) == 2U);
+
+    const auto [vertex1, distance1] = dijkstra.pop_next_unvisited_vertex();
+    CATCH_CHECK(vertex1 == 2U);
+    CATCH_CHECK(distance1 == 1);
+    dijkstra.visit_vertex(vertex1, distance1);
+
+    // Relaxing the edge (2,1) updates the existing heap entry of vertex 1 in place.
+    dijkstra.relax_edge(2U, vertex1, 1U, 2);
+    CATCH_CHECK(std::size(dijkstra.heap()) == 1U);
+    CATCH_CHECK(dijkstra.distance_to_vertex(1U) == 2);
+    CATCH_CHECK(dijkstra.predecessor_vertex(1U) == 2U);
+
+    const auto [vertex2, distance2] = dijkstra.pop_next_unvisited_vertex();
+    CATCH_CHECK(vertex2 == 1U);
+    CATCH_CHECK(distance2 == 2);
+    dijkstra.visit_vertex(vertex2, distance2);
+
+    CATCH_CHECK_THAT(dijkstra.heap(), CM::IsEmpty());
+    CATCH_CHECK(dijkstra.done());
+
+    dijkstra.reset();
+    CATCH_CHECK_THAT(dijkstra.heap(), CM::IsEmpty());
+    using ww::testing::WasReachedBy;
+    CATCH_CHECK_THAT(graph.vertices(), CM::NoneMatch(WasReachedBy(dijkstra)));
+}
+
+CATCH_TEST_CASE("Dijkstra (RadixHeap)", "[graph]")
+{
+    using Distance = int;
+    using Graph = ww::CSRGraph<>;
+    using Heap = ww::RadixHeap<Graph::vertex_type, Distance>;
+
+    const auto tail = 0U;
+    const auto edges = {0U, 1U, 2U, 3U};
+    const auto heads = {1U, 2U, 3U, 4U};
+    const auto lengths = {100, 1, 1000, 10};
+
+    auto edgelist = ww::EdgeList();
+    for (const auto& head : heads) {
+        edgelist.add_edge(tail, head);
+    }
+
+    const auto graph = Graph(edgelist);
+
+    auto dijkstra = ww::Dijkstra<Distance, Graph, ww::Vector, Heap>(graph);
+
+    dijkstra.add_source(tail);
+    dijkstra.pop_next_unvisited_vertex();
+    dijkstra.visit_vertex(tail, 0);
+    for (auto&& [edge, head, length] : ranges::views::zip(edges, heads, lengths)) {
+        dijkstra.relax_edge(edge, tail, head, length);
+    }
+
+    const auto vertices = {2U, 4U, 1U, 3U};
+    const auto distances = {1, 10, 100, 1000};
+    for (auto&& [v, d] : ranges::views::zip(vertices, distances)) {
+        CATCH_CHECK_FALSE(dijkstra.done());
+        const auto [vertex, distance] = dijkstra.pop_next_unvisited_vertex();
+        CATCH_CHECK(vertex == v);
+        CATCH_CHECK(distance == d);
+        dijkstra.visit_vertex(vertex, distance);
+    }
+    CATCH_CHECK(dijkstra.done());
+
+    dijkstra.reset();
+    CATCH_CHECK_THAT(dijkstra.heap(), CM::IsEmpty());
+}
+
 } // namespace
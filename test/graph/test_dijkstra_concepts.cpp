@@ -1,7 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/container/heap.hpp>
+#include <whirlwind/container/vector.hpp>
 #include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/delta_stepping.hpp>
 #include <whirlwind/graph/dial.hpp>
 #include <whirlwind/graph/dijkstra.hpp>
 #include <whirlwind/graph/dijkstra_concepts.hpp>
@@ -21,6 +24,33 @@ CATCH_TEST_CASE("DijkstraSolverType", "[graph]")
     using Graph = ww::CSRGraph<>;
     require_satisfies_dijkstra_solver_type<ww::Dijkstra<Distance, Graph>>();
     require_satisfies_dijkstra_solver_type<ww::Dial<Distance, Graph>>();
+    require_satisfies_dijkstra_solver_type<ww::DeltaStepping<Distance, Graph>>();
+
+    using Heap = ww::IndexedDAryHeap<Graph::vertex_type, Distance>;
+    require_satisfies_dijkstra_solver_type<
+            ww::Dijkstra<Distance, Graph, ww::Vector, Heap>>();
+
+    using RadixHeap = ww::RadixHeap<Graph::vertex_type, Distance>;
+    require_satisfies_dijkstra_solver_type<
+            ww::Dijkstra<Distance, Graph, ww::Vector, RadixHeap>>();
+}
+
+template<ww::ParallelDijkstraSolverType DijkstraSolver>
+WHIRLWIND_CONSTEVAL void
+require_satisfies_parallel_dijkstra_solver_type() noexcept
+{}
+
+CATCH_TEST_CASE("ParallelDijkstraSolverType", "[graph]")
+{
+    using Distance = int;
+    using Graph = ww::CSRGraph<>;
+    require_satisfies_parallel_dijkstra_solver_type<
+            ww::DeltaStepping<Distance, Graph>>();
+
+    CATCH_STATIC_REQUIRE_FALSE(
+            ww::ParallelDijkstraSolverType<ww::Dijkstra<Distance, Graph>>);
+    CATCH_STATIC_REQUIRE_FALSE(
+            ww::ParallelDijkstraSolverType<ww::Dial<Distance, Graph>>);
 }
 
 } // namespace
@@ -0,0 +1,137 @@
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <whirlwind/graph/flat_rectangular_grid_graph.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+
+#include "../testing/matchers/graph_matchers.hpp"
+#include "../testing/string_conversions.hpp" // IWYU pragma: keep
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("FlatRectangularGridGraph (empty)", "[graph]")
+{
+    const auto graph = ww::FlatRectangularGridGraph();
+
+    CATCH_CHECK(graph.num_rows() == 0U);
+    CATCH_CHECK(graph.num_cols() == 0U);
+    CATCH_CHECK(graph.num_vertices() == 0U);
+    CATCH_CHECK(graph.num_edges() == 0U);
+    CATCH_CHECK_THAT(graph, !ww::testing::ContainsVertex(0U));
+    CATCH_CHECK_THAT(graph, !ww::testing::ContainsEdge(0U));
+}
+
+CATCH_TEST_CASE("FlatRectangularGridGraph", "[graph]")
+{
+    using Graph = ww::FlatRectangularGridGraph<1, std::uint32_t>;
+    const auto graph = Graph(3U, 4U);
+
+    using Vertex = Graph::vertex_type;
+    using Edge = Graph::edge_type;
+
+    CATCH_SECTION("{vertex,edge,size}_type")
+    {
+        CATCH_STATIC_REQUIRE((std::is_same_v<Vertex, std::uint32_t>));
+        CATCH_STATIC_REQUIRE((std::is_same_v<Edge, std::uint32_t>));
+        CATCH_STATIC_REQUIRE((std::is_same_v<Graph::size_type, std::size_t>));
+    }
+
+    CATCH_SECTION("num_{vertices,edges}")
+    {
+        CATCH_CHECK(graph.num_vertices() == 12U);
+        CATCH_CHECK(graph.num_edges() == 34U);
+    }
+
+    CATCH_SECTION("get_{vertex,row,col}")
+    {
+        CATCH_CHECK(graph.get_vertex(0U, 0U) == 0U);
+        CATCH_CHECK(graph.get_vertex(1U, 2U) == 6U);
+        CATCH_CHECK(graph.get_vertex(2U, 3U) == 11U);
+        CATCH_CHECK(graph.get_row(6U) == 1U);
+        CATCH_CHECK(graph.get_col(6U) == 2U);
+    }
+
+    CATCH_SECTION("contains_{vertex,edge}")
+    {
+        using ww::testing::ContainsVertex;
+        CATCH_CHECK_THAT(graph, ContainsVertex(11U));
+        CATCH_CHECK_THAT(graph, !ContainsVertex(12U));
+
+        using ww::testing::ContainsEdge;
+        CATCH_CHECK_THAT(graph, ContainsEdge(33U));
+        CATCH_CHECK_THAT(graph, !ContainsEdge(34U));
+    }
+
+    CATCH_SECTION("outdegree")
+    {
+        CATCH_CHECK(graph.outdegree(0U) == 2U);
+        CATCH_CHECK(graph.outdegree(1U) == 3U);
+        CATCH_CHECK(graph.outdegree(5U) == 4U);
+        CATCH_CHECK(graph.outdegree(11U) == 2U);
+    }
+
+    CATCH_SECTION("for_each_outgoing_edge")
+    {
+        using Pair = std::pair<Edge, Vertex>;
+        for (const auto& vertex : graph.vertices()) {
+            auto expected = std::vector<Pair>();
+            for (const auto& [edge, head] : graph.outgoing_edges(vertex)) {
+                expected.emplace_back(edge, head);
+            }
+
+            auto visited = std::vector<Pair>();
+            auto visit = [&](const auto& edge, const auto& head) {
+                visited.emplace_back(edge, head);
+            };
+            graph.for_each_outgoing_edge(vertex, visit);
+            CATCH_CHECK_THAT(visited, CM::RangeEquals(expected));
+        }
+    }
+}
+
+CATCH_TEST_CASE("FlatRectangularGridGraph (RectangularGridGraph)", "[graph]")
+{
+    // The flat grid graph has the same topology and edge numbering as the grid graph
+    // with (row,col) vertices.
+    const auto num_rows = std::size_t{4};
+    const auto num_cols = std::size_t{5};
+    const auto graph = ww::FlatRectangularGridGraph<2>(num_rows, num_cols);
+    const auto expected = ww::RectangularGridGraph<2>(num_rows, num_cols);
+
+    CATCH_CHECK(graph.num_vertices() == expected.num_vertices());
+    CATCH_CHECK(graph.num_edges() == expected.num_edges());
+
+    using Pair = std::pair<std::size_t, std::size_t>;
+    for (const auto& vertex : expected.vertices()) {
+        const auto [i, j] = vertex;
+        const auto flat_vertex = graph.get_vertex(i, j);
+        CATCH_CHECK(graph.get_vertex_id(flat_vertex) == expected.get_vertex_id(vertex));
+        CATCH_CHECK(graph.outdegree(flat_vertex) == expected.outdegree(vertex));
+
+        auto edges = std::vector<Pair>();
+        auto visit = [&](const auto& edge, const auto& head) {
+            edges.emplace_back(edge, head);
+        };
+        graph.for_each_outgoing_edge(flat_vertex, visit);
+
+        auto expected_edges = std::vector<Pair>();
+        auto visit_expected = [&](const auto& edge, const auto& head) {
+            expected_edges.emplace_back(edge, expected.get_vertex_id(head));
+        };
+        expected.for_each_outgoing_edge(vertex, visit_expected);
+
+        CATCH_CHECK_THAT(edges, CM::RangeEquals(expected_edges));
+    }
+}
+
+} // namespace
@@ -129,6 +129,45 @@ CATCH_TEST_CASE("Forest (non-const)", "[graph]")
         CATCH_CHECK_THAT(2U, IsRootVertexIn(forest));
         CATCH_CHECK_THAT(3U, IsRootVertexIn(forest));
     }
+
+    CATCH_SECTION("reset (repeated)")
+    {
+        using ww::testing::IsRootVertexIn;
+
+        // Reassign a vertex's predecessor multiple times, including making it a root
+        // vertex in between.
+        forest.set_predecessor(2U, 1U, 0U);
+        forest.make_root_vertex(2U);
+        forest.set_predecessor(2U, 1U, 0U);
+        forest.set_predecessor(3U, 2U, 1U);
+        forest.reset();
+        CATCH_CHECK_THAT(graph.vertices(), CM::AllMatch(IsRootVertexIn(forest)));
+
+        forest.set_predecessor(3U, 2U, 1U);
+        CATCH_CHECK_THAT(3U, !IsRootVertexIn(forest));
+        forest.reset();
+        CATCH_CHECK_THAT(graph.vertices(), CM::AllMatch(IsRootVertexIn(forest)));
+    }
+
+    CATCH_SECTION("reset (self-predecessor)")
+    {
+        using ww::testing::IsRootVertexIn;
+
+        // A vertex may be its own predecessor with an edge other than the fill value.
+        // It's still a root vertex, but its entry must be restored by `reset()`.
+        forest.set_predecessor(2U, 2U, 1U);
+        CATCH_CHECK_THAT(2U, IsRootVertexIn(forest));
+        forest.set_predecessor(2U, 1U, 0U);
+        forest.set_predecessor(2U, 2U, 1U);
+        forest.reset();
+        CATCH_CHECK_THAT(graph.vertices(), CM::AllMatch(IsRootVertexIn(forest)));
+
+        // Afterwards, the vertex is again treated as unmodified.
+        forest.set_predecessor(2U, 1U, 0U);
+        CATCH_CHECK_THAT(2U, !IsRootVertexIn(forest));
+        forest.reset();
+        CATCH_CHECK_THAT(2U, IsRootVertexIn(forest));
+    }
 }
 
 } // namespace
@@ -1,7 +1,13 @@
+#include <cstdint>
+
 #include <catch2/catch_test_macros.hpp>
 
 #include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/bidirectional_csr_graph.hpp>
 #include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/csr_graph_view.hpp>
+#include <whirlwind/graph/flat_rectangular_grid_graph.hpp>
 #include <whirlwind/graph/graph_concepts.hpp>
 #include <whirlwind/graph/rectangular_grid_graph.hpp>
 
@@ -17,7 +23,30 @@ require_satisfies_graph_type() noexcept
 CATCH_TEST_CASE("GraphType", "[graph]")
 {
     require_satisfies_graph_type<ww::CSRGraph<>>();
+    require_satisfies_graph_type<ww::CSRGraph<ww::Vector, std::uint32_t>>();
+    require_satisfies_graph_type<ww::CSRGraphView<>>();
+    require_satisfies_graph_type<ww::CSRGraphView<std::uint32_t>>();
     require_satisfies_graph_type<ww::RectangularGridGraph<>>();
+    require_satisfies_graph_type<
+            ww::RectangularGridGraph<1, std::uint32_t, std::uint32_t>>();
+    require_satisfies_graph_type<ww::FixedRectangularGridGraph<256, 256>>();
+    require_satisfies_graph_type<ww::FlatRectangularGridGraph<>>();
+    require_satisfies_graph_type<ww::FlatRectangularGridGraph<2, std::uint32_t>>();
+}
+
+template<ww::BidirectionalGraphType Graph>
+WHIRLWIND_CONSTEVAL void
+require_satisfies_bidirectional_graph_type() noexcept
+{}
+
+CATCH_TEST_CASE("BidirectionalGraphType", "[graph]")
+{
+    require_satisfies_bidirectional_graph_type<ww::BidirectionalCSRGraph<>>();
+    require_satisfies_bidirectional_graph_type<
+            ww::BidirectionalCSRGraph<ww::Vector, std::uint32_t>>();
+
+    CATCH_STATIC_REQUIRE(!ww::BidirectionalGraphType<ww::CSRGraph<>>);
+    CATCH_STATIC_REQUIRE(!ww::BidirectionalGraphType<ww::CSRGraphView<>>);
 }
 
 } // namespace
@@ -0,0 +1,95 @@
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+
+#include "../testing/matchers/graph_matchers.hpp"
+#include "../testing/string_conversions.hpp" // IWYU pragma: keep
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("RectangularGridGraph (fixed size)", "[graph]")
+{
+    using Graph = ww::FixedRectangularGridGraph<3, 4, 2, std::size_t, std::uint32_t>;
+    const auto graph = Graph();
+
+    using Vertex = Graph::vertex_type;
+    using Edge = Graph::edge_type;
+
+    CATCH_SECTION("has_fixed_size")
+    {
+        CATCH_STATIC_REQUIRE(Graph::has_fixed_size());
+        CATCH_STATIC_REQUIRE(!ww::RectangularGridGraph<>::has_fixed_size());
+
+        // The dimensions & edge offsets of a fixed-size graph aren't stored.
+        CATCH_STATIC_REQUIRE(std::is_empty_v<Graph>);
+
+        // Only the number of rows is fixed.
+        using PartiallyFixedGraph = ww::RectangularGridGraph<1, std::size_t, Edge, 3>;
+        CATCH_STATIC_REQUIRE(!PartiallyFixedGraph::has_fixed_size());
+        CATCH_CHECK(PartiallyFixedGraph(3U, 5U).num_cols() == 5U);
+    }
+
+    CATCH_SECTION("num_{rows,cols,vertices,edges}")
+    {
+        CATCH_STATIC_REQUIRE(Graph().num_rows() == 3U);
+        CATCH_STATIC_REQUIRE(Graph().num_cols() == 4U);
+        CATCH_STATIC_REQUIRE(Graph().num_vertices() == 12U);
+        CATCH_STATIC_REQUIRE(Graph().num_edges() == 68U);
+    }
+
+    CATCH_SECTION("{vertex,edge} ids")
+    {
+        CATCH_CHECK(graph.get_vertex_id(Vertex(1U, 2U)) == 6U);
+        CATCH_CHECK_THAT(graph, ww::testing::ContainsVertex(Vertex(2U, 3U)));
+        CATCH_CHECK_THAT(graph, !ww::testing::ContainsVertex(Vertex(3U, 0U)));
+        CATCH_CHECK_THAT(graph, ww::testing::ContainsEdge(Edge{67}));
+        CATCH_CHECK_THAT(graph, !ww::testing::ContainsEdge(Edge{68}));
+    }
+
+    CATCH_SECTION("(num_rows, num_cols)")
+    {
+        const auto other = Graph(3U, 4U);
+        CATCH_CHECK(other.num_vertices() == graph.num_vertices());
+        CATCH_CHECK(other.num_edges() == graph.num_edges());
+    }
+
+    CATCH_SECTION("outgoing_edges")
+    {
+        // The graph has the same topology and edge numbering as the equivalent grid
+        // graph whose dimensions are specified at runtime.
+        using DynamicGraph = ww::RectangularGridGraph<2, std::size_t, std::uint32_t>;
+        const auto expected = DynamicGraph(3U, 4U);
+
+        using Pair = std::pair<Edge, Vertex>;
+        for (const auto& vertex : expected.vertices()) {
+            CATCH_CHECK(graph.outdegree(vertex) == expected.outdegree(vertex));
+
+            auto edges = std::vector<Pair>();
+            for (const auto& [edge, head] : graph.outgoing_edges(vertex)) {
+                edges.emplace_back(edge, head);
+            }
+
+            auto expected_edges = std::vector<Pair>();
+            auto visit = [&](const auto& edge, const auto& head) {
+                expected_edges.emplace_back(edge, head);
+            };
+            expected.for_each_outgoing_edge(vertex, visit);
+
+            CATCH_CHECK_THAT(edges, CM::RangeEquals(expected_edges));
+        }
+    }
+}
+
+} // namespace
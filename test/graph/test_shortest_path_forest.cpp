@@ -159,6 +159,37 @@ CATCH_TEST_CASE("ShortestPathForest (non-const)", "[graph]")
                     return shortest_paths.distance_to_vertex(vertex);
                 });
         CATCH_CHECK_THAT(distances, ww::testing::AllEqualTo(max_distance));
+        CATCH_CHECK(std::ranges::distance(shortest_paths.reached_vertices()) == 0U);
+        CATCH_CHECK(std::ranges::distance(shortest_paths.visited_vertices()) == 0U);
+    }
+
+    CATCH_SECTION("reset (partial)")
+    {
+        // Modify a subset of vertices, including one whose distance is assigned without
+        // labeling it.
+        shortest_paths.label_vertex_reached(2U);
+        shortest_paths.label_vertex_visited(2U);
+        shortest_paths.set_distance_to_vertex(2U, 0);
+        shortest_paths.label_vertex_reached(0U);
+        shortest_paths.set_distance_to_vertex(0U, 5);
+        shortest_paths.set_distance_to_vertex(1U, 10);
+
+        // Reached & visited vertices are yielded in the order they were modified.
+        CATCH_CHECK_THAT(shortest_paths.reached_vertices(), CM::RangeEquals({2U, 0U}));
+        CATCH_CHECK_THAT(shortest_paths.visited_vertices(), CM::RangeEquals({2U}));
+
+        shortest_paths.reset();
+
+        using ww::testing::WasReachedBy;
+        CATCH_CHECK_THAT(graph.vertices(), CM::NoneMatch(WasReachedBy(shortest_paths)));
+        CATCH_CHECK(shortest_paths.distance_to_vertex(0U) == max_distance);
+        CATCH_CHECK(shortest_paths.distance_to_vertex(1U) == max_distance);
+        CATCH_CHECK(shortest_paths.distance_to_vertex(2U) == max_distance);
+
+        // The forest may be reused after resetting.
+        shortest_paths.label_vertex_reached(1U);
+        CATCH_CHECK_THAT(shortest_paths.reached_vertices(), CM::RangeEquals({1U}));
+        CATCH_CHECK(std::ranges::distance(shortest_paths.visited_vertices()) == 0U);
     }
 }
 
@@ -0,0 +1,219 @@
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/flat_rectangular_grid_graph.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/astar_successive_shortest_paths.hpp>
+#include <whirlwind/network/grid_distance_heuristic.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/random_network.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+// Generate a random network with arc costs uniformly distributed in [1, `max_cost`].
+// The minimum arc cost is nonzero, so the grid distance heuristic is nontrivial.
+template<class Network>
+[[nodiscard]] auto
+make_astar_network(const typename Network::graph_type& graph,
+                   std::size_t num_residues,
+                   typename Network::cost_type max_cost,
+                   unsigned int seed) -> Network
+{
+    using Cost = typename Network::cost_type;
+    using Flow = typename Network::flow_type;
+
+    auto rng = std::mt19937(seed);
+    const auto num_nodes = graph.num_vertices();
+    const auto surplus =
+            ww::testing::make_random_surplus<Flow>(num_nodes, num_residues, rng);
+    auto cost_dist = std::uniform_int_distribution<Cost>(Cost{1}, max_cost);
+    auto cost = std::vector<Cost>(graph.num_edges());
+    for (auto& c : cost) {
+        c = cost_dist(rng);
+    }
+    return Network(graph, surplus, cost);
+}
+
+// Check that the heuristic is nonzero away from the deficit nodes, consistent, and
+// admissible (no greater than the distance from each node to the nearest deficit node
+// w.r.t the reduced arc costs).
+template<class Network, class Heuristic>
+void
+check_grid_distance_heuristic(const Network& network, Heuristic& heuristic)
+{
+    using Cost = typename Network::cost_type;
+    using Dijkstra = ww::Dijkstra<Cost, typename Network::residual_graph_type>;
+
+    CATCH_REQUIRE(heuristic.min_arc_cost() > Cost{0});
+
+    auto dijkstra = Dijkstra(network);
+    for (const auto& node : network.nodes()) {
+        const auto value = heuristic(node);
+        if (network.is_deficit_node(node)) {
+            CATCH_CHECK(value == Cost{0});
+        } else {
+            CATCH_CHECK(value > Cost{0});
+        }
+
+        const auto sink = ww::dijkstra_ssp(dijkstra, network, node);
+        CATCH_REQUIRE(sink);
+        CATCH_CHECK(value <= dijkstra.distance_to_vertex(*sink));
+
+        network.for_each_unsaturated_outgoing_arc(
+                node, [&](const auto& arc, const auto& head) {
+                    const auto reduced_cost = network.arc_reduced_cost(arc, node, head);
+                    CATCH_CHECK(reduced_cost + heuristic(head) >= value);
+                });
+    }
+}
+
+template<class Network>
+void
+check_astar_successive_shortest_paths(const typename Network::graph_type& graph,
+                                      std::size_t num_residues,
+                                      typename Network::cost_type max_cost,
+                                      unsigned int seed)
+{
+    using Cost = typename Network::cost_type;
+    using Dijkstra = ww::Dijkstra<Cost, typename Network::residual_graph_type>;
+
+    auto expected = make_astar_network<Network>(graph, num_residues, max_cost, seed);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+    CATCH_REQUIRE(ww::testing::is_solved(expected));
+
+    auto network = make_astar_network<Network>(graph, num_residues, max_cost, seed);
+    auto heuristic = ww::GridDistanceHeuristic<Network>(network);
+    check_grid_distance_heuristic(network, heuristic);
+
+    // Compare the number of nodes visited by a search from each excess node in the
+    // initial network state. Since the heuristic is consistent, A* visits no more nodes
+    // than Dijkstra's algorithm in each search, and should visit far fewer in total.
+    {
+        auto dijkstra = Dijkstra(network);
+        const auto count_visited = [&]() {
+            std::size_t n = 0;
+            for ([[maybe_unused]] const auto& node : dijkstra.visited_vertices()) {
+                ++n;
+            }
+            return n;
+        };
+
+        std::size_t total_visited = 0;
+        std::size_t total_astar_visited = 0;
+        for (const auto& source : network.excess_nodes()) {
+            CATCH_REQUIRE(ww::dijkstra_ssp(dijkstra, network, source));
+            const auto num_visited = count_visited();
+
+            CATCH_REQUIRE(ww::astar_ssp(dijkstra, network, source, heuristic));
+            const auto num_astar_visited = count_visited();
+
+            CATCH_CHECK(num_astar_visited <= num_visited);
+            total_visited += num_visited;
+            total_astar_visited += num_astar_visited;
+        }
+        CATCH_CHECK(total_astar_visited < total_visited);
+    }
+
+    ww::astar_successive_shortest_paths<Dijkstra>(network, heuristic);
+
+    CATCH_CHECK(ww::testing::is_solved(network));
+    CATCH_CHECK(network.total_cost() == expected.total_cost());
+}
+
+CATCH_TEST_CASE("astar_successive_shortest_paths", "[network]")
+{
+    using Cost = int;
+    using Flow = int;
+
+    CATCH_SECTION("RectangularGridGraph")
+    {
+        using Graph = ww::RectangularGridGraph<1>;
+        using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+        using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+
+        const auto graph = Graph(23U, 29U);
+        for (const auto seed : {1U, 2U, 3U, 4U}) {
+            CATCH_CAPTURE(seed);
+            const auto num_residues = std::size_t{5} * seed;
+
+            check_astar_successive_shortest_paths<Network>(graph, num_residues,
+                                                           Cost{20}, seed);
+        }
+    }
+
+    CATCH_SECTION("FlatRectangularGridGraph")
+    {
+        using Graph = ww::FlatRectangularGridGraph<1>;
+        using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+        using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+
+        const auto graph = Graph(19U, 17U);
+        for (const auto seed : {5U, 6U, 7U}) {
+            CATCH_CAPTURE(seed);
+            check_astar_successive_shortest_paths<Network>(graph, std::size_t{12},
+                                                           Cost{20}, seed);
+        }
+    }
+
+    CATCH_SECTION("uncapacitated")
+    {
+        using Graph = ww::RectangularGridGraph<1>;
+        using Network = ww::Network<Graph, Cost, Flow>;
+
+        const auto graph = Graph(14U, 16U);
+        for (const auto seed : {11U, 12U, 13U}) {
+            CATCH_CAPTURE(seed);
+            check_astar_successive_shortest_paths<Network>(graph, std::size_t{10},
+                                                           Cost{20}, seed);
+        }
+    }
+}
+
+CATCH_TEST_CASE("GridDistanceHeuristic (large costs)", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<1>;
+    using Cost = int;
+    using Flow = int;
+    using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+    using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+
+    // Every arc has a cost of 2^28, so the Manhattan distance times the minimum arc
+    // cost overflows `int` for nodes more than 7 arcs away from the deficit node.
+    const auto graph = Graph(1U, 12U);
+    const auto arc_cost = Cost{1} << 28;
+    auto surplus = std::vector<Flow>(graph.num_vertices(), 0);
+    surplus.front() = 1;
+    surplus.back() = -1;
+    const auto cost = std::vector<Cost>(graph.num_edges(), arc_cost);
+    const auto network = Network(graph, surplus, cost);
+
+    auto heuristic = ww::GridDistanceHeuristic<Network>(network);
+    CATCH_REQUIRE(heuristic.min_arc_cost() == arc_cost);
+
+    const auto max_value = std::numeric_limits<Cost>::max() / 2;
+    for (const auto& node : network.nodes()) {
+        using std::get;
+        const auto distance = static_cast<Cost>(11 - get<1>(node));
+        CATCH_CAPTURE(distance);
+        const auto value = heuristic(node);
+        if (distance <= max_value / arc_cost) {
+            CATCH_CHECK(value == distance * arc_cost);
+        } else {
+            CATCH_CHECK(value == max_value);
+        }
+    }
+}
+
+} // namespace
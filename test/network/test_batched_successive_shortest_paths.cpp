@@ -0,0 +1,81 @@
+#include <cstddef>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/batched_successive_shortest_paths.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/random_network.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("batched_successive_shortest_paths", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<1>;
+    using Cost = int;
+    using Flow = int;
+    using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+    using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+    using Dijkstra = ww::Dijkstra<Cost, Network::residual_graph_type>;
+
+    const auto graph = Graph(24U, 31U);
+    const auto max_cost = Cost{20};
+
+    for (const auto seed : {1U, 2U, 3U, 4U, 5U}) {
+        for (const auto max_paths_per_batch : {0U, 1U, 7U}) {
+            CATCH_CAPTURE(seed, max_paths_per_batch);
+            const auto num_residues = std::size_t{10} * seed;
+
+            auto expected = ww::testing::make_random_network<Network>(
+                    graph, num_residues, max_cost, seed);
+            ww::successive_shortest_paths<Dijkstra>(expected);
+            CATCH_REQUIRE(ww::testing::is_solved(expected));
+
+            auto network = ww::testing::make_random_network<Network>(
+                    graph, num_residues, max_cost, seed);
+            ww::batched_successive_shortest_paths<Dijkstra>(network,
+                                                            max_paths_per_batch);
+
+            CATCH_CHECK(ww::testing::is_solved(network));
+            CATCH_CHECK(network.total_cost() == expected.total_cost());
+        }
+    }
+}
+
+CATCH_TEST_CASE("batched_successive_shortest_paths (uncapacitated)", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<1>;
+    using Cost = int;
+    using Flow = int;
+    using Network = ww::Network<Graph, Cost, Flow>;
+    using Dijkstra = ww::Dijkstra<Cost, Network::residual_graph_type>;
+
+    const auto graph = Graph(17U, 20U);
+    const auto num_residues = std::size_t{30};
+    const auto max_cost = Cost{50};
+
+    for (const auto seed : {11U, 12U, 13U}) {
+        CATCH_CAPTURE(seed);
+
+        auto expected = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                                  max_cost, seed);
+        ww::successive_shortest_paths<Dijkstra>(expected);
+        CATCH_REQUIRE(ww::testing::is_solved(expected));
+
+        auto network = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                                 max_cost, seed);
+        ww::batched_successive_shortest_paths<Dijkstra>(network);
+
+        CATCH_CHECK(ww::testing::is_solved(network));
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+}
+
+} // namespace
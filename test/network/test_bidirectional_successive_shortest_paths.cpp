@@ -0,0 +1,136 @@
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/csr_graph_view.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/bidirectional_successive_shortest_paths.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/random_network.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("bidirectional_successive_shortest_paths", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<1>;
+    using Cost = int;
+    using Flow = int;
+    using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+    using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+    using Dijkstra = ww::Dijkstra<Cost, Network::residual_graph_type>;
+
+    const auto graph = Graph(21U, 26U);
+    const auto max_cost = Cost{20};
+
+    for (const auto seed : {1U, 2U, 3U, 4U, 5U}) {
+        CATCH_CAPTURE(seed);
+        const auto num_residues = std::size_t{6} * seed;
+
+        auto expected = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                                  max_cost, seed);
+        ww::successive_shortest_paths<Dijkstra>(expected);
+        CATCH_REQUIRE(ww::testing::is_solved(expected));
+
+        auto network = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                                 max_cost, seed);
+        ww::bidirectional_successive_shortest_paths<Dijkstra>(network);
+
+        CATCH_CHECK(ww::testing::is_solved(network));
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+}
+
+CATCH_TEST_CASE("bidirectional_successive_shortest_paths (uncapacitated)", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<1>;
+    using Cost = int;
+    using Flow = int;
+    using Network = ww::Network<Graph, Cost, Flow>;
+    using Dijkstra = ww::Dijkstra<Cost, Network::residual_graph_type>;
+
+    const auto graph = Graph(15U, 18U);
+    for (const auto seed : {11U, 12U, 13U}) {
+        CATCH_CAPTURE(seed);
+        const auto num_residues = std::size_t{12};
+
+        auto expected = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                                  Cost{20}, seed);
+        ww::successive_shortest_paths<Dijkstra>(expected);
+        CATCH_REQUIRE(ww::testing::is_solved(expected));
+
+        auto network = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                                 Cost{20}, seed);
+        ww::bidirectional_successive_shortest_paths<Dijkstra>(network);
+
+        CATCH_CHECK(ww::testing::is_solved(network));
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+}
+
+CATCH_TEST_CASE("bidirectional_successive_shortest_paths (residual paths)", "[network]")
+{
+    using Graph = ww::CSRGraphView<>;
+    using Cost = int;
+    using Flow = int;
+    using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+    using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+    using Dijkstra = ww::Dijkstra<Cost, Network::residual_graph_type>;
+
+    // Sources s[0], ..., s[k-1] each have an edge to sink t[i] with cost 1 and an edge
+    // to sink t[i+1] with cost 3. The last source z has a single edge to t[0] with cost
+    // 0. Sources are processed in order of node index, so each s[i] first sends its
+    // flow to t[i]. The only remaining sink, t[k], is then reachable from z only via
+    // the reverse arcs created by each of the k previous augmentations.
+    const auto k = std::size_t{6};
+    const auto source = [](std::size_t i) { return i; };
+    const auto sink = [&](std::size_t i) { return k + i; };
+    const auto z = 2 * k + 1;
+    const auto num_nodes = 2 * k + 2;
+
+    auto row_offsets = std::vector<std::size_t>{0U};
+    auto col_indices = std::vector<std::size_t>();
+    auto cost = std::vector<Cost>();
+    for (std::size_t node = 0; node < num_nodes; ++node) {
+        if (node < k) {
+            col_indices.push_back(sink(node));
+            cost.push_back(1);
+            col_indices.push_back(sink(node + 1));
+            cost.push_back(3);
+        } else if (node == z) {
+            col_indices.push_back(sink(0));
+            cost.push_back(0);
+        }
+        row_offsets.push_back(col_indices.size());
+    }
+    const auto graph = Graph(row_offsets, col_indices);
+
+    auto surplus = std::vector<Flow>(num_nodes, 0);
+    for (std::size_t i = 0; i < k; ++i) {
+        surplus[source(i)] = 1;
+    }
+    for (std::size_t i = 0; i <= k; ++i) {
+        surplus[sink(i)] = -1;
+    }
+    surplus[z] = 1;
+
+    auto expected = Network(graph, surplus, cost);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+    CATCH_REQUIRE(ww::testing::is_solved(expected));
+    CATCH_REQUIRE(expected.total_cost() == static_cast<Cost>(3 * k));
+
+    auto network = Network(graph, surplus, cost);
+    ww::bidirectional_successive_shortest_paths<Dijkstra>(network);
+
+    CATCH_CHECK(ww::testing::is_solved(network));
+    CATCH_CHECK(network.total_cost() == expected.total_cost());
+}
+
+} // namespace
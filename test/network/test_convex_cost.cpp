@@ -0,0 +1,318 @@
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/flat_rectangular_grid_graph.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/convex_cost.hpp>
+#include <whirlwind/network/cost_scaling.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/network_simplex.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/random_network.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+// Check that `for_each_unsaturated_outgoing_arc()` visits exactly one arc to each
+// neighbor that has any unsaturated parallel arcs, and that its cost is the minimum
+// cost of those arcs.
+template<class Network>
+void
+check_cheapest_unsaturated_arcs(const Network& network)
+{
+    using Cost = typename Network::cost_type;
+    using Node = typename Network::node_type;
+
+    for (const auto& tail : network.nodes()) {
+        // The minimum cost of the unsaturated parallel arcs to each neighbor, in the
+        // order the neighbors are visited.
+        auto heads = std::vector<Node>();
+        auto min_costs = std::vector<Cost>();
+        network.for_each_outgoing_arc(tail, [&](const auto& arc, const auto& head) {
+            if (network.is_arc_saturated(arc)) {
+                return;
+            }
+            const auto cost = network.arc_cost(arc);
+            if (heads.empty() || (heads.back() != head)) {
+                heads.push_back(head);
+                min_costs.push_back(cost);
+            } else if (cost < min_costs.back()) {
+                min_costs.back() = cost;
+            }
+        });
+
+        std::size_t i = 0;
+        network.for_each_unsaturated_outgoing_arc(
+                tail, [&](const auto& arc, const auto& head) {
+                    CATCH_REQUIRE(i < heads.size());
+                    CATCH_CHECK(head == heads[i]);
+                    CATCH_CHECK(!network.is_arc_saturated(arc));
+                    CATCH_CHECK(network.arc_cost(arc) == min_costs[i]);
+                    ++i;
+                });
+        CATCH_CHECK(i == heads.size());
+    }
+}
+
+// Get the total cost of a flow in a network with convex arc costs by summing the cost
+// function of each link, evaluated at the total flow along its parallel edges.
+template<class Network, class CostFunction>
+[[nodiscard]] auto
+convex_flow_cost(const Network& network,
+                 std::size_t num_segments,
+                 CostFunction cost_function) -> typename Network::cost_type
+{
+    using Cost = typename Network::cost_type;
+
+    const auto flow = network.forward_arc_flows();
+    const auto num_links = std::size(flow) / num_segments;
+    auto cost = Cost{0};
+    for (std::size_t link = 0; link < num_links; ++link) {
+        auto link_flow = std::size_t{0};
+        for (std::size_t k = 0; k < num_segments; ++k) {
+            link_flow += static_cast<std::size_t>(flow[link * num_segments + k]);
+        }
+        cost += cost_function(link, link_flow);
+    }
+    return cost;
+}
+
+CATCH_TEST_CASE("ConvexCostMixin (cheapest unsaturated arc)", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<2>;
+    using Cost = int;
+    using Flow = int;
+    using Mixin = ww::ConvexCostMixin<Graph, Flow, ww::Vector>;
+    using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+    using Node = Network::node_type;
+    using Arc = Network::arc_type;
+
+    // A single pair of adjacent nodes. The incremental costs of the two parallel edges
+    // of each link are 2 & 4.
+    const auto graph = Graph(1U, 2U);
+    const auto table = ww::ConvexCostTable<Cost>(
+            graph.num_edges() / 2, 2U, [](std::size_t, std::size_t flow) {
+                const auto k = static_cast<Cost>(flow);
+                return k * k + k;
+            });
+    auto network = Network(graph, std::vector<Flow>{0, 0}, table);
+
+    const auto u = Node{0U, 0U};
+    const auto v = Node{0U, 1U};
+
+    // Get the k-th parallel arc from `tail` to `head`.
+    const auto get_arc = [&](const Node& tail, const Node& head, std::size_t k) {
+        auto result = std::optional<Arc>();
+        std::size_t i = 0;
+        network.for_each_outgoing_arc(tail, [&](const auto& arc, const auto& other) {
+            if (other == head) {
+                if (i == k) {
+                    result = arc;
+                }
+                ++i;
+            }
+        });
+        CATCH_REQUIRE(result);
+        return *result;
+    };
+
+    // Get the arc visited by `for_each_unsaturated_outgoing_arc()` from `tail` to
+    // `head`, if any.
+    const auto get_cheapest_arc = [&](const Node& tail, const Node& head) {
+        auto result = std::optional<Arc>();
+        network.for_each_unsaturated_outgoing_arc(
+                tail, [&](const auto& arc, const auto& other) {
+                    if (other == head) {
+                        result = arc;
+                    }
+                });
+        return result;
+    };
+
+    // The parallel arcs from `u` to `v` alternate between the forward arcs of the
+    // edges from `u` to `v` and the reverse arcs of the edges from `v` to `u`.
+    const auto uv0 = get_arc(u, v, 0);
+    const auto uv1 = get_arc(u, v, 2);
+    const auto vu0_reverse = get_arc(v, u, 1);
+    const auto vu1_reverse = get_arc(v, u, 3);
+    CATCH_REQUIRE(network.is_forward_arc(uv0));
+    CATCH_REQUIRE(network.is_forward_arc(uv1));
+    CATCH_REQUIRE(network.arc_cost(uv0) == 2);
+    CATCH_REQUIRE(network.arc_cost(uv1) == 4);
+    CATCH_REQUIRE(network.arc_cost(vu0_reverse) == -2);
+    CATCH_REQUIRE(network.arc_cost(vu1_reverse) == -4);
+
+    CATCH_SECTION("no flow")
+    {
+        check_cheapest_unsaturated_arcs(network);
+        CATCH_CHECK(get_cheapest_arc(u, v) == uv0);
+    }
+
+    CATCH_SECTION("add & cancel flow")
+    {
+        // Send one unit from `u` to `v`, which saturates the cheaper forward arc.
+        network.push_arc_flow(uv0, u, v, 1);
+        check_cheapest_unsaturated_arcs(network);
+        CATCH_CHECK(get_cheapest_arc(u, v) == uv1);
+        CATCH_CHECK(get_cheapest_arc(v, u) == vu0_reverse);
+
+        // Send a second unit, which saturates both forward arcs. The cheapest arc
+        // from `v` back to `u` is now the reverse of the more expensive one.
+        network.push_arc_flow(uv1, u, v, 1);
+        check_cheapest_unsaturated_arcs(network);
+        CATCH_CHECK(network.is_arc_saturated(uv0));
+        CATCH_CHECK(network.is_arc_saturated(uv1));
+        CATCH_CHECK(get_cheapest_arc(v, u) == vu1_reverse);
+
+        // Cancel one unit by sending it back along the cheapest reverse arc.
+        network.push_arc_flow(vu1_reverse, v, u, 1);
+        check_cheapest_unsaturated_arcs(network);
+        CATCH_CHECK(get_cheapest_arc(u, v) == uv1);
+        CATCH_CHECK(get_cheapest_arc(v, u) == vu0_reverse);
+
+        // Cancel the other unit. The cheapest arc from `v` to `u` is now the forward
+        // arc of the first edge from `v` to `u`.
+        network.push_arc_flow(vu0_reverse, v, u, 1);
+        check_cheapest_unsaturated_arcs(network);
+        CATCH_CHECK(get_cheapest_arc(u, v) == uv0);
+        const auto vu0 = get_arc(v, u, 0);
+        CATCH_CHECK(network.is_forward_arc(vu0));
+        CATCH_CHECK(get_cheapest_arc(v, u) == vu0);
+    }
+}
+
+template<class Graph>
+void
+check_convex_cost_solvers(const Graph& graph, unsigned int seed)
+{
+    using Cost = int;
+    using Flow = int;
+    using Mixin = ww::ConvexCostMixin<Graph, Flow, ww::Vector>;
+    using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+    using Dijkstra = ww::Dijkstra<Cost, typename Network::residual_graph_type>;
+
+    // The brute-force expansion of each link into parallel unit-capacity edges, each
+    // of which is considered separately by the solver.
+    using ExpandedMixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+    using ExpandedNetwork = ww::Network<Graph, Cost, Flow, ww::Vector, ExpandedMixin>;
+    using ExpandedDijkstra =
+            ww::Dijkstra<Cost, typename ExpandedNetwork::residual_graph_type>;
+
+    constexpr auto num_segments = Graph::num_parallel_edges();
+    const auto num_links = graph.num_edges() / num_segments;
+
+    // Random convex cost functions f(k) = a*k + b*k^2.
+    auto rng = std::mt19937(seed);
+    auto a_dist = std::uniform_int_distribution<Cost>(0, 20);
+    auto b_dist = std::uniform_int_distribution<Cost>(0, 6);
+    auto a = std::vector<Cost>(num_links);
+    auto b = std::vector<Cost>(num_links);
+    for (std::size_t link = 0; link < num_links; ++link) {
+        a[link] = a_dist(rng);
+        b[link] = b_dist(rng);
+    }
+    const auto cost_function = [&](std::size_t link, std::size_t flow) {
+        const auto k = static_cast<Cost>(flow);
+        return a[link] * k + b[link] * k * k;
+    };
+    const auto table =
+            ww::ConvexCostTable<Cost>(num_links, num_segments, cost_function);
+
+    // Many residues on a small grid, so that several units of flow share each link.
+    const auto num_nodes = graph.num_vertices();
+    const auto surplus =
+            ww::testing::make_random_surplus<Flow>(num_nodes, num_nodes / 3, rng);
+
+    auto expected = ExpandedNetwork(graph, surplus, table);
+    ww::successive_shortest_paths<ExpandedDijkstra>(expected);
+    CATCH_REQUIRE(ww::testing::is_solved(expected));
+    const auto expected_cost = expected.total_cost();
+    CATCH_CHECK(convex_flow_cost(expected, num_segments, cost_function) ==
+                expected_cost);
+
+    auto ssp_network = Network(graph, surplus, table);
+    ww::successive_shortest_paths<Dijkstra>(ssp_network);
+    CATCH_CHECK(ww::testing::is_solved(ssp_network));
+    CATCH_CHECK(ssp_network.total_cost() == expected_cost);
+    CATCH_CHECK(convex_flow_cost(ssp_network, num_segments, cost_function) ==
+                expected_cost);
+    check_cheapest_unsaturated_arcs(ssp_network);
+
+    auto pd_network = Network(graph, surplus, table);
+    ww::primal_dual<Dijkstra>(pd_network);
+    CATCH_CHECK(ww::testing::is_solved(pd_network));
+    CATCH_CHECK(pd_network.total_cost() == expected_cost);
+    CATCH_CHECK(convex_flow_cost(pd_network, num_segments, cost_function) ==
+                expected_cost);
+
+    // These solvers push flow along any residual arc, so the saturated parallel edges
+    // of each link needn't be a prefix of them.
+    auto cs_network = Network(graph, surplus, table);
+    ww::cost_scaling(cs_network);
+    CATCH_CHECK(ww::testing::is_solved(cs_network));
+    CATCH_CHECK(cs_network.total_cost() == expected_cost);
+    check_cheapest_unsaturated_arcs(cs_network);
+
+    auto ns_network = Network(graph, surplus, table);
+    ww::network_simplex(ns_network);
+    CATCH_CHECK(ww::testing::is_solved(ns_network));
+    CATCH_CHECK(ns_network.total_cost() == expected_cost);
+    check_cheapest_unsaturated_arcs(ns_network);
+}
+
+CATCH_TEST_CASE("ConvexCostMixin (arbitrary flows)", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<3>;
+    using Cost = int;
+    using Flow = int;
+    using Mixin = ww::ConvexCostMixin<Graph, Flow, ww::Vector>;
+    using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+
+    const auto graph = Graph(6U, 7U);
+    const auto num_links = graph.num_edges() / 3;
+    const auto table = ww::ConvexCostTable<Cost>(
+            num_links, 3U, [](std::size_t link, std::size_t flow) {
+                const auto k = static_cast<Cost>(flow);
+                return static_cast<Cost>(link % 5) * k + k * k;
+            });
+    const auto surplus = std::vector<Flow>(graph.num_vertices(), 0);
+
+    // Assign flow to a random subset of the parallel edges of each link, regardless
+    // of their costs. (Node excesses aren't updated, since no flow is augmented.)
+    for (const auto seed : {1U, 2U, 3U}) {
+        CATCH_CAPTURE(seed);
+        auto rng = std::mt19937(seed);
+        auto has_flow = std::bernoulli_distribution(0.5);
+
+        auto network = Network(graph, surplus, table);
+        for (const auto& tail : network.nodes()) {
+            network.for_each_outgoing_arc(tail, [&](const auto& arc, const auto&) {
+                if (network.is_forward_arc(arc) && has_flow(rng)) {
+                    network.increase_arc_flow(arc, 1);
+                }
+            });
+        }
+        check_cheapest_unsaturated_arcs(network);
+    }
+}
+
+CATCH_TEST_CASE("ConvexCostMixin (optimality)", "[network]")
+{
+    for (const auto seed : {1U, 2U, 3U}) {
+        CATCH_CAPTURE(seed);
+        check_convex_cost_solvers(ww::RectangularGridGraph<2>(8U, 9U), seed);
+        check_convex_cost_solvers(ww::FlatRectangularGridGraph<3>(7U, 6U), seed);
+    }
+}
+
+} // namespace
@@ -0,0 +1,136 @@
+#include <cstddef>
+#include <random>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/cost_scaling.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/random_network.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Graph = ww::RectangularGridGraph<1>;
+using Cost = int;
+using Flow = int;
+
+// Check that the reduced cost of each unsaturated arc is nonnegative.
+template<class Network>
+auto
+has_optimal_potentials(const Network& network) -> bool
+{
+    auto is_optimal = true;
+    for (const auto& tail : network.nodes()) {
+        network.for_each_outgoing_arc(tail, [&](const auto& arc, const auto& head) {
+            if (!network.is_arc_saturated(arc) &&
+                (network.arc_reduced_cost(arc, tail, head) < 0)) {
+                is_optimal = false;
+            }
+        });
+    }
+    return is_optimal;
+}
+
+template<class Network>
+auto
+expected_total_cost(const Graph& graph,
+                    std::size_t num_residues,
+                    Cost max_cost,
+                    unsigned seed) -> Cost
+{
+    using Dijkstra = ww::Dijkstra<Cost, typename Network::residual_graph_type>;
+    auto network = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                             max_cost, seed);
+    ww::successive_shortest_paths<Dijkstra>(network);
+    CATCH_REQUIRE(ww::testing::is_solved(network));
+    return network.total_cost();
+}
+
+CATCH_TEST_CASE("cost_scaling", "[network]")
+{
+    using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+    using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+
+    const auto graph = Graph(19U, 23U);
+    const auto max_cost = Cost{30};
+
+    for (const auto seed : {1U, 2U, 3U, 4U}) {
+        for (const auto scale_factor : {2, 8}) {
+            CATCH_CAPTURE(seed, scale_factor);
+            const auto num_residues = std::size_t{12} * seed;
+            const auto expected =
+                    expected_total_cost<Network>(graph, num_residues, max_cost, seed);
+
+            auto network = ww::testing::make_random_network<Network>(
+                    graph, num_residues, max_cost, seed);
+            ww::cost_scaling(network, scale_factor);
+
+            CATCH_CHECK(ww::testing::is_solved(network));
+            CATCH_CHECK(network.total_cost() == expected);
+            CATCH_CHECK(has_optimal_potentials(network));
+        }
+    }
+}
+
+CATCH_TEST_CASE("cost_scaling (nonzero initial potentials)", "[network]")
+{
+    using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+    using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+
+    const auto graph = Graph(16U, 21U);
+    const auto num_residues = std::size_t{25};
+    const auto max_cost = Cost{30};
+
+    for (const auto seed : {5U, 6U, 7U}) {
+        CATCH_CAPTURE(seed);
+
+        auto network = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                                 max_cost, seed);
+
+        // The initial prices are seeded from the node potentials, which needn't be
+        // feasible.
+        auto rng = std::mt19937(seed);
+        auto potential = std::uniform_int_distribution<Cost>(-100, 100);
+        for (const auto& node : network.nodes()) {
+            network.increase_node_potential(node, potential(rng));
+        }
+
+        ww::cost_scaling(network);
+
+        CATCH_CHECK(ww::testing::is_solved(network));
+        CATCH_CHECK(network.total_cost() ==
+                    expected_total_cost<Network>(graph, num_residues, max_cost, seed));
+        CATCH_CHECK(has_optimal_potentials(network));
+    }
+}
+
+CATCH_TEST_CASE("cost_scaling (uncapacitated)", "[network]")
+{
+    using Network = ww::Network<Graph, Cost, Flow>;
+
+    const auto graph = Graph(14U, 18U);
+    const auto num_residues = std::size_t{30};
+    const auto max_cost = Cost{50};
+
+    for (const auto seed : {8U, 9U, 10U}) {
+        CATCH_CAPTURE(seed);
+
+        auto network = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                                 max_cost, seed);
+        ww::cost_scaling(network);
+
+        CATCH_CHECK(ww::testing::is_solved(network));
+        CATCH_CHECK(network.total_cost() ==
+                    expected_total_cost<Network>(graph, num_residues, max_cost, seed));
+        CATCH_CHECK(has_optimal_potentials(network));
+    }
+}
+
+} // namespace
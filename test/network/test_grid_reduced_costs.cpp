@@ -0,0 +1,125 @@
+#include <cstddef>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/flat_rectangular_grid_graph.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/grid_reduced_costs.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/packed_unit_capacity.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+// Check that `grid_row_reduced_costs()` agrees with `arc_reduced_cost()` for each arc,
+// and that each arc belongs to exactly one row of arcs.
+template<class Network>
+void
+check_grid_row_reduced_costs(const typename Network::graph_type& graph)
+{
+    using Cost = typename Network::cost_type;
+    using Flow = typename Network::flow_type;
+
+    auto rng = std::mt19937(7U);
+    auto cost_dist = std::uniform_int_distribution<Cost>(0, 100);
+    auto cost = std::vector<Cost>(graph.num_edges());
+    for (auto& c : cost) {
+        c = cost_dist(rng);
+    }
+    const auto surplus = std::vector<Flow>(graph.num_vertices(), 0);
+    auto network = Network(graph, surplus, cost);
+
+    // Use arbitrary potentials, including a nonzero global potential offset.
+    for (const auto& node : network.nodes()) {
+        network.increase_node_potential(node, cost_dist(rng));
+    }
+    network.decrease_all_node_potentials(Cost{17});
+
+    auto expected = std::vector<Cost>(network.num_arcs());
+    for (const auto& tail : network.nodes()) {
+        network.for_each_outgoing_arc(tail, [&](const auto& arc, const auto& head) {
+            const auto arc_id = network.get_arc_id(arc);
+            expected[arc_id] = network.arc_reduced_cost(arc, tail, head);
+        });
+    }
+
+    const auto directions = {ww::GridDirection::up, ww::GridDirection::left,
+                             ww::GridDirection::down, ww::GridDirection::right};
+
+    auto num_visits = std::vector<int>(network.num_arcs(), 0);
+    auto reduced_costs = std::vector<Cost>();
+    for (std::size_t row = 0; row < graph.num_rows(); ++row) {
+        for (const auto direction : directions) {
+            CATCH_CAPTURE(row, static_cast<int>(direction));
+            reduced_costs.resize(ww::grid_row_num_arcs(network, row, direction));
+            const auto first = ww::grid_row_reduced_costs(network, row, direction,
+                                                          std::span(reduced_costs));
+            for (std::size_t k = 0; k < std::size(reduced_costs); ++k) {
+                CATCH_CHECK(reduced_costs[k] == expected[first + k]);
+                ++num_visits[first + k];
+            }
+        }
+    }
+
+    for (const auto n : num_visits) {
+        CATCH_CHECK(n == 1);
+    }
+}
+
+template<class Graph>
+using UnitCapacityNetwork =
+        ww::Network<Graph, int, int, ww::Vector, ww::UnitCapacityMixin<Graph, int>>;
+
+template<class Graph>
+using PackedNetwork = ww::Network<Graph,
+                                  int,
+                                  int,
+                                  ww::Vector,
+                                  ww::PackedUnitCapacityMixin<Graph, int, int>>;
+
+CATCH_TEST_CASE("grid_row_reduced_costs", "[network]")
+{
+    CATCH_SECTION("RectangularGridGraph")
+    {
+        using Graph = ww::RectangularGridGraph<1>;
+        check_grid_row_reduced_costs<UnitCapacityNetwork<Graph>>(Graph(7U, 5U));
+        check_grid_row_reduced_costs<UnitCapacityNetwork<Graph>>(Graph(4U, 1U));
+    }
+
+    CATCH_SECTION("RectangularGridGraph (parallel edges)")
+    {
+        using Graph = ww::RectangularGridGraph<3>;
+        check_grid_row_reduced_costs<UnitCapacityNetwork<Graph>>(Graph(4U, 6U));
+    }
+
+    CATCH_SECTION("FlatRectangularGridGraph")
+    {
+        using Graph = ww::FlatRectangularGridGraph<1>;
+        check_grid_row_reduced_costs<UnitCapacityNetwork<Graph>>(Graph(5U, 7U));
+    }
+
+    CATCH_SECTION("FlatRectangularGridGraph (parallel edges)")
+    {
+        using Graph = ww::FlatRectangularGridGraph<2>;
+        check_grid_row_reduced_costs<UnitCapacityNetwork<Graph>>(Graph(1U, 4U));
+        check_grid_row_reduced_costs<UnitCapacityNetwork<Graph>>(Graph(1U, 1U));
+        check_grid_row_reduced_costs<UnitCapacityNetwork<Graph>>(Graph(6U, 3U));
+    }
+
+    CATCH_SECTION("PackedUnitCapacityMixin")
+    {
+        // The mixin stores the arc costs itself, so each arc is visited individually.
+        using Graph1 = ww::RectangularGridGraph<2>;
+        using Graph2 = ww::FlatRectangularGridGraph<1>;
+        check_grid_row_reduced_costs<PackedNetwork<Graph1>>(Graph1(5U, 6U));
+        check_grid_row_reduced_costs<PackedNetwork<Graph2>>(Graph2(6U, 5U));
+    }
+}
+
+} // namespace
@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/flat_rectangular_grid_graph.hpp>
+#include <whirlwind/network/network.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+// Copy the nodes of a range into a vector.
+template<class Range>
+auto
+to_vector(Range&& range)
+{
+    using Node = std::remove_cvref_t<decltype(*std::begin(range))>;
+    auto out = std::vector<Node>();
+    for (const auto& node : range) {
+        out.push_back(node);
+    }
+    return out;
+}
+
+CATCH_TEST_CASE("ResidueList", "[network]")
+{
+    using ResidueList = ww::detail::ResidueList<std::size_t, ww::Vector>;
+
+    const auto num_nodes = std::size_t{200};
+    auto is_residue = std::vector<bool>(num_nodes, false);
+    auto list = ResidueList(num_nodes);
+
+    const auto check_residue = [&](std::size_t node) { return bool(is_residue[node]); };
+    const auto get_node_id = [](std::size_t node) { return node; };
+    const auto insert = [&](std::size_t node) {
+        is_residue[node] = true;
+        list.insert(node, node, check_residue, get_node_id);
+    };
+
+    CATCH_SECTION("insert")
+    {
+        insert(3);
+        insert(1);
+        insert(3);
+        CATCH_CHECK(list.nodes() == std::vector<std::size_t>{3, 1});
+    }
+
+    CATCH_SECTION("re-insert a stale node")
+    {
+        // A stale entry is left in place, so a node that becomes a residue again isn't
+        // listed twice.
+        insert(5);
+        insert(7);
+        is_residue[5] = false;
+        insert(5);
+        CATCH_CHECK(list.nodes() == std::vector<std::size_t>{5, 7});
+    }
+
+    CATCH_SECTION("purge")
+    {
+        // Fill the list up to its initial capacity of 64 nodes, then make every other
+        // node stale.
+        for (std::size_t node = 0; node < 64; ++node) {
+            insert(node);
+        }
+        CATCH_REQUIRE(std::size(list.nodes()) == 64U);
+        for (std::size_t node = 0; node < 64; node += 2) {
+            is_residue[node] = false;
+        }
+
+        // Inserting another node purges the stale entries, preserving the order of
+        // the remaining ones.
+        insert(100);
+        auto expected = std::vector<std::size_t>();
+        for (std::size_t node = 1; node < 64; node += 2) {
+            expected.push_back(node);
+        }
+        expected.push_back(100);
+        CATCH_CHECK(list.nodes() == expected);
+
+        // Purged nodes are no longer listed, so they may be inserted again.
+        insert(0);
+        expected.push_back(0);
+        CATCH_CHECK(list.nodes() == expected);
+
+        // The list isn't purged again until it doubles in size since the last purge,
+        // so stale entries are retained until then.
+        is_residue[1] = false;
+        auto node = std::size_t{101};
+        while (std::size(expected) < 64) {
+            insert(node);
+            expected.push_back(node);
+            ++node;
+        }
+        CATCH_CHECK(list.nodes() == expected);
+
+        insert(node);
+        expected.erase(expected.begin());
+        expected.push_back(node);
+        CATCH_CHECK(list.nodes() == expected);
+    }
+
+    CATCH_SECTION("purge (all stale)")
+    {
+        for (std::size_t node = 0; node < 64; ++node) {
+            insert(node);
+            is_residue[node] = false;
+        }
+        insert(150);
+        CATCH_CHECK(list.nodes() == std::vector<std::size_t>{150});
+    }
+}
+
+CATCH_TEST_CASE("Network (excess & deficit nodes)", "[network]")
+{
+    // Nodes of a `FlatRectangularGridGraph` are node indices.
+    using Graph = ww::FlatRectangularGridGraph<1>;
+    using Network = ww::Network<Graph, int, int>;
+    using Node = Network::node_type;
+
+    const auto graph = Graph(12U, 13U);
+    const auto cost = std::vector<int>(graph.num_edges(), 1);
+    auto surplus = std::vector<int>(graph.num_vertices(), 0);
+    surplus[4] = 2;
+    surplus[9] = -1;
+    surplus[17] = 1;
+    surplus[30] = -2;
+    auto network = Network(graph, surplus, cost);
+
+    // Get the excess or deficit nodes by checking every node in the network, in order
+    // of increasing node index.
+    const auto brute_force_excess_nodes = [&]() {
+        auto out = std::vector<Node>();
+        for (const auto& node : network.nodes()) {
+            if (network.is_excess_node(node)) {
+                out.push_back(node);
+            }
+        }
+        return out;
+    };
+    const auto brute_force_deficit_nodes = [&]() {
+        auto out = std::vector<Node>();
+        for (const auto& node : network.nodes()) {
+            if (network.is_deficit_node(node)) {
+                out.push_back(node);
+            }
+        }
+        return out;
+    };
+
+    // Check that the tracked excess & deficit nodes match a scan of all nodes (up to
+    // order) and that no node is visited twice.
+    const auto check_residues = [&]() {
+        auto excess_nodes = to_vector(network.excess_nodes());
+        std::ranges::sort(excess_nodes);
+        CATCH_CHECK(excess_nodes == brute_force_excess_nodes());
+
+        auto deficit_nodes = to_vector(network.deficit_nodes());
+        std::ranges::sort(deficit_nodes);
+        CATCH_CHECK(deficit_nodes == brute_force_deficit_nodes());
+
+        auto total_excess = 0;
+        auto total_deficit = 0;
+        for (const auto& node : network.nodes()) {
+            const auto excess = network.node_excess(node);
+            total_excess += std::max(excess, 0);
+            total_deficit += std::min(excess, 0);
+        }
+        CATCH_CHECK(network.total_excess() == total_excess);
+        CATCH_CHECK(network.total_deficit() == total_deficit);
+    };
+
+    const auto get_node = [](std::size_t node_id) { return Node(node_id); };
+
+    CATCH_SECTION("initial state")
+    {
+        // The initial residues are listed in order of increasing node index.
+        CATCH_CHECK(to_vector(network.excess_nodes()) == brute_force_excess_nodes());
+        CATCH_CHECK(to_vector(network.deficit_nodes()) == brute_force_deficit_nodes());
+        CATCH_CHECK(network.total_excess() == 3);
+        CATCH_CHECK(network.total_deficit() == -3);
+        check_residues();
+    }
+
+    CATCH_SECTION("re-insert")
+    {
+        // Exhaust a node's excess, then restore it.
+        const auto node = get_node(17);
+        network.decrease_node_excess(node, 1);
+        check_residues();
+        network.increase_node_excess(node, 1);
+        check_residues();
+        CATCH_CHECK(to_vector(network.excess_nodes()) ==
+                    std::vector<Node>{get_node(4), get_node(17)});
+
+        // A node may switch between excess & deficit.
+        network.decrease_node_excess(node, 2);
+        check_residues();
+        network.increase_node_excess(node, 2);
+        check_residues();
+    }
+
+    CATCH_SECTION("reduce excess while iterating")
+    {
+        // Reducing the excess of any node, including those not yet visited, doesn't
+        // invalidate the view.
+        auto visited = std::vector<Node>();
+        for (const auto& node : network.excess_nodes()) {
+            visited.push_back(node);
+            network.decrease_node_excess(node, network.node_excess(node));
+            if (node == get_node(4)) {
+                network.decrease_node_excess(get_node(17), 1);
+            }
+        }
+        CATCH_CHECK(visited == std::vector<Node>{get_node(4)});
+        CATCH_CHECK(network.total_excess() == 0);
+        check_residues();
+    }
+
+    CATCH_SECTION("increase deficit while iterating")
+    {
+        auto visited = std::vector<Node>();
+        for (const auto& node : network.deficit_nodes()) {
+            visited.push_back(node);
+            network.increase_node_excess(node, -network.node_excess(node));
+        }
+        CATCH_CHECK(visited == std::vector<Node>{get_node(9), get_node(30)});
+        CATCH_CHECK(network.total_deficit() == 0);
+        check_residues();
+    }
+
+    CATCH_SECTION("random updates")
+    {
+        // Enough updates to purge the lists several times.
+        auto rng = std::mt19937(1U);
+        auto node_dist = std::uniform_int_distribution<std::size_t>(
+                0, graph.num_vertices() - 1);
+        auto delta_dist = std::uniform_int_distribution<int>(1, 2);
+        for (int i = 0; i < 2000; ++i) {
+            const auto node = get_node(node_dist(rng));
+            const auto delta = delta_dist(rng);
+            if (i % 2 == 0) {
+                network.increase_node_excess(node, delta);
+            } else {
+                network.decrease_node_excess(node, delta);
+            }
+            if (i % 50 == 0) {
+                check_residues();
+            }
+        }
+        check_residues();
+    }
+}
+
+} // namespace
@@ -0,0 +1,182 @@
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/network_simplex.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/random_network.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+// Check that the reduced cost of each unsaturated arc is nonnegative.
+template<class Network>
+auto
+has_optimal_potentials(const Network& network) -> bool
+{
+    auto is_optimal = true;
+    for (const auto& tail : network.nodes()) {
+        network.for_each_outgoing_arc(tail, [&](const auto& arc, const auto& head) {
+            if (!network.is_arc_saturated(arc) &&
+                (network.arc_reduced_cost(arc, tail, head) < 0)) {
+                is_optimal = false;
+            }
+        });
+    }
+    return is_optimal;
+}
+
+template<class Network>
+void
+check_network_simplex(const typename Network::graph_type& graph,
+                      std::size_t num_residues,
+                      typename Network::cost_type max_cost,
+                      unsigned seed)
+{
+    using Cost = typename Network::cost_type;
+    using Dijkstra = ww::Dijkstra<Cost, typename Network::residual_graph_type>;
+
+    auto expected = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                              max_cost, seed);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+    CATCH_REQUIRE(ww::testing::is_solved(expected));
+
+    auto network = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                             max_cost, seed);
+    ww::network_simplex(network);
+
+    CATCH_CHECK(ww::testing::is_solved(network));
+    CATCH_CHECK(network.total_cost() == expected.total_cost());
+    CATCH_CHECK(has_optimal_potentials(network));
+}
+
+// Push flow along random arcs of a random network (so that the initial flow is
+// feasible w.r.t. the arc capacities but not optimal, and the node excesses are no
+// longer unit residues), then check that network simplex finds a flow with the same
+// total cost as a cold solve of the network.
+template<class Network>
+void
+check_network_simplex_existing_flow(const typename Network::graph_type& graph,
+                                    std::size_t num_residues,
+                                    typename Network::cost_type max_cost,
+                                    unsigned seed)
+{
+    using Cost = typename Network::cost_type;
+    using Flow = typename Network::flow_type;
+    using Dijkstra = ww::Dijkstra<Cost, typename Network::residual_graph_type>;
+
+    auto expected = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                              max_cost, seed);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+    CATCH_REQUIRE(ww::testing::is_solved(expected));
+
+    auto network = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                             max_cost, seed);
+    auto rng = std::mt19937(seed);
+    auto coin = std::bernoulli_distribution(0.25);
+    for (const auto& tail : network.nodes()) {
+        network.for_each_outgoing_arc(tail, [&](const auto& arc, const auto& head) {
+            if (network.is_forward_arc(arc) && !network.is_arc_saturated(arc) &&
+                coin(rng)) {
+                network.increase_arc_flow(arc, Flow{1});
+                network.decrease_node_excess(tail, Flow{1});
+                network.increase_node_excess(head, Flow{1});
+            }
+        });
+    }
+    CATCH_REQUIRE(network.total_cost() > Cost{0});
+
+    ww::network_simplex(network);
+
+    CATCH_CHECK(ww::testing::is_solved(network));
+    CATCH_CHECK(network.total_cost() == expected.total_cost());
+    CATCH_CHECK(has_optimal_potentials(network));
+}
+
+CATCH_TEST_CASE("network_simplex", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<1>;
+    using Cost = int;
+    using Flow = int;
+
+    CATCH_SECTION("unit capacity")
+    {
+        using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+        using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+
+        const auto graph = Graph(21U, 26U);
+        for (const auto seed : {1U, 2U, 3U, 4U}) {
+            CATCH_CAPTURE(seed);
+            const auto num_residues = std::size_t{15} * seed;
+            check_network_simplex<Network>(graph, num_residues, Cost{40}, seed);
+        }
+    }
+
+    CATCH_SECTION("uncapacitated")
+    {
+        using Network = ww::Network<Graph, Cost, Flow>;
+
+        const auto graph = Graph(15U, 17U);
+        for (const auto seed : {5U, 6U, 7U}) {
+            CATCH_CAPTURE(seed);
+            check_network_simplex<Network>(graph, std::size_t{30}, Cost{50}, seed);
+        }
+    }
+
+    CATCH_SECTION("existing flow (unit capacity)")
+    {
+        using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+        using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+
+        const auto graph = Graph(13U, 16U);
+        for (const auto seed : {8U, 9U, 10U}) {
+            CATCH_CAPTURE(seed);
+            check_network_simplex_existing_flow<Network>(graph, std::size_t{20},
+                                                         Cost{30}, seed);
+        }
+    }
+
+    CATCH_SECTION("existing flow (uncapacitated)")
+    {
+        using Network = ww::Network<Graph, Cost, Flow>;
+
+        const auto graph = Graph(14U, 11U);
+        for (const auto seed : {11U, 12U, 13U}) {
+            CATCH_CAPTURE(seed);
+            check_network_simplex_existing_flow<Network>(graph, std::size_t{20},
+                                                         Cost{30}, seed);
+        }
+    }
+
+}
+
+CATCH_TEST_CASE("network_simplex (potential overflow)", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<1>;
+    using Cost = int;
+    using Flow = int;
+    using Network = ww::Network<Graph, Cost, Flow>;
+
+    // The optimal potentials span the cost of a path through every node, which
+    // can't be represented by the cost type.
+    const auto graph = Graph(1U, 300U);
+    auto surplus = std::vector<Flow>(graph.num_vertices(), 0);
+    surplus.front() = 1;
+    surplus.back() = -1;
+    const auto cost = std::vector<Cost>(graph.num_edges(), Cost{10'000'000});
+    auto network = Network(graph, surplus, cost);
+
+    CATCH_CHECK_THROWS_AS(ww::network_simplex(network), std::overflow_error);
+}
+
+} // namespace
@@ -0,0 +1,140 @@
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/graph/flat_rectangular_grid_graph.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/packed_unit_capacity.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/random_network.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+// Check that a network using `PackedUnitCapacityMixin` has the same arcs as, and is
+// solved identically to, the equivalent network using the default layout.
+template<class Graph>
+void
+check_packed_unit_capacity(const Graph& graph, std::size_t num_residues)
+{
+    using Cost = int;
+    using Flow = int;
+    using PackedMixin = ww::PackedUnitCapacityMixin<Graph, Cost, Flow, ww::Vector>;
+    using PackedNetwork = ww::Network<Graph, Cost, Flow, ww::Vector, PackedMixin>;
+    using PackedDijkstra =
+            ww::Dijkstra<Cost, typename PackedNetwork::residual_graph_type>;
+    using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+    using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+    using Dijkstra = ww::Dijkstra<Cost, typename Network::residual_graph_type>;
+
+    for (const auto seed : {1U, 2U, 3U}) {
+        CATCH_CAPTURE(seed);
+        auto expected = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                                  Cost{50}, seed);
+        auto network = ww::testing::make_random_network<PackedNetwork>(
+                graph, num_residues, Cost{50}, seed);
+
+        for (const auto& arc : network.arcs()) {
+            CATCH_CHECK(network.arc_cost(arc) == expected.arc_cost(arc));
+            CATCH_CHECK(network.get_transpose_arc_id(arc) ==
+                        expected.get_transpose_arc_id(arc));
+            const auto is_saturated = expected.is_arc_saturated(arc);
+            CATCH_CHECK(network.is_arc_saturated(arc) == is_saturated);
+        }
+
+        // The base mixin's transpose arc indices are released, so incoming arcs must
+        // be found via the arc records.
+        using Arc = typename PackedNetwork::arc_type;
+        using Node = typename PackedNetwork::node_type;
+        for (const auto& node : network.nodes()) {
+            auto incoming_arcs = std::vector<std::pair<Arc, Node>>();
+            network.for_each_incoming_arc(node, [&](const auto& arc, const auto& tail) {
+                incoming_arcs.emplace_back(arc, tail);
+            });
+            auto expected_incoming_arcs = std::vector<std::pair<Arc, Node>>();
+            expected.for_each_incoming_arc(
+                    node, [&](const auto& arc, const auto& tail) {
+                        expected_incoming_arcs.emplace_back(arc, tail);
+                    });
+            CATCH_CHECK(incoming_arcs == expected_incoming_arcs);
+        }
+
+        ww::successive_shortest_paths<Dijkstra>(expected);
+        CATCH_REQUIRE(ww::testing::is_solved(expected));
+
+        ww::successive_shortest_paths<PackedDijkstra>(network);
+        CATCH_CHECK(ww::testing::is_solved(network));
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+        CATCH_CHECK(network.forward_arc_flows() == expected.forward_arc_flows());
+    }
+}
+
+CATCH_TEST_CASE("PackedUnitCapacityMixin", "[network]")
+{
+    CATCH_SECTION("RectangularGridGraph")
+    {
+        using Graph = ww::RectangularGridGraph<1>;
+        using Mixin = ww::PackedUnitCapacityMixin<Graph, int, int, ww::Vector>;
+        CATCH_STATIC_REQUIRE(!Mixin::stores_transpose_arc_ids());
+        check_packed_unit_capacity(Graph(16U, 21U), std::size_t{20});
+    }
+
+    CATCH_SECTION("FlatRectangularGridGraph")
+    {
+        using Graph = ww::FlatRectangularGridGraph<2>;
+        using Mixin = ww::PackedUnitCapacityMixin<Graph, int, int, ww::Vector>;
+        CATCH_STATIC_REQUIRE(!Mixin::stores_transpose_arc_ids());
+        check_packed_unit_capacity(Graph(11U, 13U), std::size_t{20});
+    }
+
+    CATCH_SECTION("CSRGraph")
+    {
+        using Graph = ww::CSRGraph<>;
+        using Mixin = ww::PackedUnitCapacityMixin<Graph, int, int, ww::Vector>;
+        CATCH_STATIC_REQUIRE(Mixin::stores_transpose_arc_ids());
+
+        // A grid with additional random diagonal edges. Every edge is included in
+        // both directions. The edges aren't in order of their tail, so their arc
+        // indices in the residual graph differ from twice their edge indices.
+        const auto num_rows = std::size_t{14};
+        const auto num_cols = std::size_t{15};
+        auto rng = std::mt19937(7U);
+        auto add_diagonal = std::bernoulli_distribution(0.3);
+        auto edges = std::vector<std::pair<std::size_t, std::size_t>>();
+        const auto add_edge = [&](std::size_t u, std::size_t v) {
+            edges.emplace_back(u, v);
+            edges.emplace_back(v, u);
+        };
+        for (std::size_t i = 0; i < num_rows; ++i) {
+            for (std::size_t j = 0; j < num_cols; ++j) {
+                const auto node = i * num_cols + j;
+                if (j + 1 < num_cols) {
+                    add_edge(node, node + 1);
+                }
+                if (i + 1 < num_rows) {
+                    add_edge(node, node + num_cols);
+                }
+                if ((i + 1 < num_rows) && (j + 1 < num_cols) && add_diagonal(rng)) {
+                    add_edge(node, node + num_cols + 1);
+                }
+            }
+        }
+        const auto graph = Graph(ww::EdgeList<>(edges));
+        CATCH_REQUIRE(graph.num_vertices() == num_rows * num_cols);
+
+        check_packed_unit_capacity(graph, std::size_t{30});
+    }
+}
+
+} // namespace
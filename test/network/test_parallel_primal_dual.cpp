@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/dial.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/parallel_primal_dual.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/random_network.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+template<class Network>
+void
+check_parallel_primal_dual(const typename Network::graph_type& graph,
+                           std::size_t num_residues,
+                           typename Network::cost_type max_cost,
+                           unsigned int seed)
+{
+    using Cost = typename Network::cost_type;
+    using Dijkstra = ww::Dijkstra<Cost, typename Network::residual_graph_type>;
+
+    auto expected = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                              max_cost, seed);
+    ww::primal_dual<Dijkstra>(expected);
+    CATCH_REQUIRE(ww::testing::is_solved(expected));
+
+    auto reference = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                               max_cost, seed);
+    ww::parallel_primal_dual<Dijkstra>(reference, 1);
+
+    for (const auto num_threads : {1U, 2U, 4U}) {
+        CATCH_CAPTURE(num_threads);
+        auto network = ww::testing::make_random_network<Network>(graph, num_residues,
+                                                                 max_cost, seed);
+        ww::parallel_primal_dual<Dijkstra>(network, num_threads);
+
+        CATCH_CHECK(ww::testing::is_solved(network));
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+
+        // Ties are broken independently of the number of threads.
+        CATCH_CHECK(network.forward_arc_flows() == reference.forward_arc_flows());
+    }
+}
+
+CATCH_TEST_CASE("parallel_primal_dual", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<1>;
+    using Cost = int;
+    using Flow = int;
+    using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+    using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+
+    const auto graph = Graph(13U, 19U);
+    for (const auto seed : {1U, 2U, 3U, 4U}) {
+        CATCH_CAPTURE(seed);
+        const auto num_residues = std::size_t{8} * seed;
+        check_parallel_primal_dual<Network>(graph, num_residues, Cost{20}, seed);
+    }
+}
+
+CATCH_TEST_CASE("parallel_primal_dual (uncapacitated)", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<1>;
+    using Cost = int;
+    using Flow = int;
+    using Network = ww::Network<Graph, Cost, Flow>;
+
+    const auto graph = Graph(11U, 14U);
+    for (const auto seed : {11U, 12U, 13U}) {
+        CATCH_CAPTURE(seed);
+        check_parallel_primal_dual<Network>(graph, std::size_t{16}, Cost{20}, seed);
+    }
+}
+
+CATCH_TEST_CASE("primal_dual (Dial)", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<1>;
+    using Cost = int;
+    using Flow = int;
+    using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+    using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+    using Dial = ww::Dial<Cost, Network::residual_graph_type>;
+    using Dijkstra = ww::Dijkstra<Cost, Network::residual_graph_type>;
+
+    // The solver is reused across rounds, but the reduced arc costs grow as the
+    // potentials are updated, so the buckets must be resized along the way.
+    const auto graph = Graph(14U, 17U);
+    for (const auto seed : {1U, 2U, 3U}) {
+        CATCH_CAPTURE(seed);
+        auto expected = ww::testing::make_random_network<Network>(graph, 40U,
+                                                                  Cost{30}, seed);
+        ww::successive_shortest_paths<Dijkstra>(expected);
+        CATCH_REQUIRE(ww::testing::is_solved(expected));
+
+        auto network = ww::testing::make_random_network<Network>(graph, 40U,
+                                                                 Cost{30}, seed);
+        ww::primal_dual<Dial>(network);
+        CATCH_CHECK(ww::testing::is_solved(network));
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+}
+
+CATCH_TEST_CASE("parallel_primal_dual (deficit node order)", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<1>;
+    using Cost = int;
+    using Flow = int;
+    using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+    using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+    using Dijkstra = ww::Dijkstra<Cost, Network::residual_graph_type>;
+
+    // Small arc costs, so that many sinks are equidistant from their source.
+    const auto graph = Graph(12U, 15U);
+    for (const auto seed : {1U, 2U, 3U}) {
+        CATCH_CAPTURE(seed);
+        auto rng = std::mt19937(seed);
+        const auto num_nodes = graph.num_vertices();
+        const auto surplus =
+                ww::testing::make_random_surplus<Flow>(num_nodes, 20U, rng);
+        const auto cost = ww::testing::make_random_costs<Cost>(graph.num_edges(),
+                                                               Cost{2}, rng);
+
+        // The same network, but with the deficit nodes listed in order of decreasing
+        // node index rather than increasing node index.
+        auto excess_only = surplus;
+        for (auto& s : excess_only) {
+            s = std::max(s, Flow{0});
+        }
+        auto reordered = Network(graph, excess_only, cost);
+        auto nodes = std::vector<Network::node_type>();
+        for (const auto& node : reordered.nodes()) {
+            nodes.push_back(node);
+        }
+        for (auto node_id = num_nodes; node_id-- > 0;) {
+            if (surplus[node_id] < 0) {
+                reordered.decrease_node_excess(nodes[node_id], -surplus[node_id]);
+            }
+        }
+
+        // Ties between sinks are broken by node index, regardless of the order in
+        // which the deficit nodes are listed.
+        {
+            auto expected = Network(graph, surplus, cost);
+            auto network = reordered;
+            ww::primal_dual<Dijkstra>(expected);
+            ww::primal_dual<Dijkstra>(network);
+            CATCH_CHECK(network.forward_arc_flows() == expected.forward_arc_flows());
+        }
+        {
+            auto expected = Network(graph, surplus, cost);
+            auto network = reordered;
+            ww::parallel_primal_dual<Dijkstra>(expected, 2U);
+            ww::parallel_primal_dual<Dijkstra>(network, 3U);
+            CATCH_CHECK(network.forward_arc_flows() == expected.forward_arc_flows());
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,224 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/csr_graph_view.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/flat_rectangular_grid_graph.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/random_network.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+// Check that the transpose, edge index & forward arc mappings of a network's residual
+// graph are consistent with each other.
+template<class Network>
+void
+check_residual_graph_consistency(const Network& network)
+{
+    for (const auto& tail : network.nodes()) {
+        network.for_each_outgoing_arc(tail, [&](const auto& arc, const auto& head) {
+            const auto transpose_arc_id = network.get_transpose_arc_id(arc);
+            const auto transpose_arc =
+                    static_cast<typename Network::arc_type>(transpose_arc_id);
+            CATCH_CHECK(network.get_transpose_arc_id(transpose_arc) ==
+                        network.get_arc_id(arc));
+            CATCH_CHECK(network.is_forward_arc(arc) !=
+                        network.is_forward_arc(transpose_arc));
+
+            // The transpose arc is an outgoing arc of `head` whose head is `tail`.
+            auto num_matches = 0;
+            network.for_each_outgoing_arc(head, [&](const auto& other_arc,
+                                                    const auto& other_head) {
+                if (network.get_arc_id(other_arc) == transpose_arc_id) {
+                    CATCH_CHECK(other_head == tail);
+                    ++num_matches;
+                }
+            });
+            CATCH_CHECK(num_matches == 1);
+
+            const auto& forward_arc = network.is_forward_arc(arc) ? arc : transpose_arc;
+            const auto edge_id = network.get_edge_id(forward_arc);
+            CATCH_CHECK(network.get_residual_graph_arc_id(edge_id) ==
+                        network.get_arc_id(forward_arc));
+        });
+    }
+}
+
+// Check the residual graph of a grid network, which computes the forward & transpose
+// arcs of each arc arithmetically rather than storing them.
+template<class Network>
+void
+check_grid_residual_graph(const typename Network::graph_type& graph)
+{
+    using Cost = typename Network::cost_type;
+    const auto network = ww::testing::make_random_network<Network>(
+            graph, std::size_t{4}, Cost{20}, 1U);
+
+    CATCH_CHECK(network.num_arcs() == 2 * graph.num_edges());
+    check_residual_graph_consistency(network);
+
+    auto num_forward_arcs = std::size_t{0};
+    for (const auto& arc : network.arcs()) {
+        if (network.is_forward_arc(arc)) {
+            ++num_forward_arcs;
+        }
+    }
+    CATCH_CHECK(num_forward_arcs == graph.num_edges());
+
+    for (std::size_t edge_id = 0; edge_id < graph.num_edges(); ++edge_id) {
+        using Arc = typename Network::arc_type;
+        const auto arc = static_cast<Arc>(network.get_residual_graph_arc_id(edge_id));
+        CATCH_CHECK(network.is_forward_arc(arc));
+        CATCH_CHECK(network.get_edge_id(arc) == edge_id);
+    }
+}
+
+CATCH_TEST_CASE("ResidualGraphMixin (grid)", "[network]")
+{
+    using Cost = int;
+    using Flow = int;
+
+    CATCH_SECTION("RectangularGridGraph<1>")
+    {
+        using Graph = ww::RectangularGridGraph<1>;
+        check_grid_residual_graph<ww::Network<Graph, Cost, Flow>>(Graph(5U, 7U));
+    }
+
+    CATCH_SECTION("RectangularGridGraph<2>")
+    {
+        using Graph = ww::RectangularGridGraph<2>;
+        check_grid_residual_graph<ww::Network<Graph, Cost, Flow>>(Graph(5U, 7U));
+    }
+
+    CATCH_SECTION("FlatRectangularGridGraph<2>")
+    {
+        using Graph = ww::FlatRectangularGridGraph<2>;
+        check_grid_residual_graph<ww::Network<Graph, Cost, Flow>>(Graph(6U, 4U));
+    }
+
+    CATCH_SECTION("RectangularGridGraph<2> (unit capacity)")
+    {
+        using Graph = ww::RectangularGridGraph<2>;
+        using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+        using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+        check_grid_residual_graph<Network>(Graph(1U, 9U));
+    }
+}
+
+CATCH_TEST_CASE("ResidualGraphMixin (CSRGraphView)", "[network]")
+{
+    using Cost = int;
+    using Flow = int;
+    using View = ww::CSRGraphView<>;
+    using Mixin = ww::UnitCapacityMixin<View, Flow, ww::Vector>;
+    using Network = ww::Network<View, Cost, Flow, ww::Vector, Mixin>;
+    using Dijkstra = ww::Dijkstra<Cost, Network::residual_graph_type>;
+
+    CATCH_SECTION("single edge")
+    {
+        // The forward & reverse arcs of the edge are arcs 0 & 1.
+        const auto row_offsets = std::vector<std::size_t>{0U, 1U, 1U};
+        const auto col_indices = std::vector<std::size_t>{1U};
+        const auto graph = View(row_offsets, col_indices);
+
+        auto network = Network(graph, std::vector<Flow>{1, -1}, std::vector<Cost>{3});
+        check_residual_graph_consistency(network);
+        CATCH_CHECK(network.get_edge_id(network.get_residual_graph_arc_id(0U)) == 0U);
+
+        ww::successive_shortest_paths<Dijkstra>(network);
+        CATCH_CHECK(ww::testing::is_solved(network));
+        CATCH_CHECK(network.total_cost() == 3);
+    }
+
+    CATCH_SECTION("32-bit indices")
+    {
+        // The residual graph is built with the original graph's index type.
+        using View32 = ww::CSRGraphView<std::uint32_t>;
+        using Mixin32 = ww::UnitCapacityMixin<View32, Flow, ww::Vector>;
+        using Network32 = ww::Network<View32, Cost, Flow, ww::Vector, Mixin32>;
+        using Dijkstra32 = ww::Dijkstra<Cost, Network32::residual_graph_type>;
+        CATCH_STATIC_REQUIRE(
+                (std::is_same_v<Network32::residual_graph_type::vertex_type,
+                                std::uint32_t>));
+
+        const auto row_offsets = std::vector<std::uint32_t>{0U, 2U, 3U, 3U};
+        const auto col_indices = std::vector<std::uint32_t>{1U, 2U, 2U};
+        const auto graph = View32(row_offsets, col_indices);
+
+        auto network = Network32(graph, std::vector<Flow>{1, 0, -1},
+                                 std::vector<Cost>{1, 5, 2});
+        check_residual_graph_consistency(network);
+
+        ww::successive_shortest_paths<Dijkstra32>(network);
+        CATCH_CHECK(ww::testing::is_solved(network));
+        CATCH_CHECK(network.total_cost() == 3);
+    }
+
+    CATCH_SECTION("grid")
+    {
+        using Grid = ww::RectangularGridGraph<1>;
+        using GridMixin = ww::UnitCapacityMixin<Grid, Flow, ww::Vector>;
+        using GridNetwork = ww::Network<Grid, Cost, Flow, ww::Vector, GridMixin>;
+        using GridDijkstra = ww::Dijkstra<Cost, GridNetwork::residual_graph_type>;
+
+        const auto grid = Grid(12U, 17U);
+
+        // Externally owned CSR arrays with the same edges as the grid graph. The edge
+        // with index `k` in the CSR graph has index `grid_edge_id[k]` in the grid.
+        auto row_offsets = std::vector<std::size_t>{0U};
+        auto col_indices = std::vector<std::size_t>();
+        auto grid_edge_id = std::vector<std::size_t>();
+        for (const auto& tail : grid.vertices()) {
+            grid.for_each_outgoing_edge(tail, [&](const auto& edge, const auto& head) {
+                col_indices.push_back(grid.get_vertex_id(head));
+                grid_edge_id.push_back(grid.get_edge_id(edge));
+            });
+            row_offsets.push_back(col_indices.size());
+        }
+        const auto graph = View(row_offsets, col_indices);
+        CATCH_REQUIRE(graph.num_edges() == grid.num_edges());
+
+        for (const auto seed : {1U, 2U, 3U}) {
+            CATCH_CAPTURE(seed);
+            auto rng = std::mt19937(seed);
+            const auto surplus = ww::testing::make_random_surplus<Flow>(
+                    grid.num_vertices(), std::size_t{15}, rng);
+            const auto grid_cost = ww::testing::make_random_costs<Cost>(
+                    grid.num_edges(), Cost{20}, rng);
+
+            auto cost = std::vector<Cost>(graph.num_edges());
+            for (std::size_t k = 0; k < std::size(cost); ++k) {
+                cost[k] = grid_cost[grid_edge_id[k]];
+            }
+
+            auto expected = GridNetwork(grid, surplus, grid_cost);
+            ww::successive_shortest_paths<GridDijkstra>(expected);
+
+            auto network = Network(graph, surplus, cost);
+            check_residual_graph_consistency(network);
+            for (std::size_t k = 0; k < std::size(cost); ++k) {
+                const auto arc = network.get_residual_graph_arc_id(k);
+                CATCH_CHECK(network.get_edge_id(arc) == k);
+                CATCH_CHECK(network.arc_cost(arc) == cost[k]);
+            }
+
+            ww::successive_shortest_paths<Dijkstra>(network);
+            CATCH_CHECK(ww::testing::is_solved(network));
+            CATCH_CHECK(network.total_cost() == expected.total_cost());
+        }
+    }
+}
+
+} // namespace
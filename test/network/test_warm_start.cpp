@@ -0,0 +1,230 @@
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/astar_successive_shortest_paths.hpp>
+#include <whirlwind/network/batched_successive_shortest_paths.hpp>
+#include <whirlwind/network/bidirectional_successive_shortest_paths.hpp>
+#include <whirlwind/network/grid_distance_heuristic.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/parallel_primal_dual.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+#include <whirlwind/network/warm_start.hpp>
+
+#include "../testing/random_network.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+// Check that the reduced cost of each unsaturated arc is nonnegative.
+template<class Network>
+[[nodiscard]] auto
+satisfies_reduced_cost_optimality(const Network& network) -> bool
+{
+    using Cost = typename Network::cost_type;
+    using Flow = typename Network::flow_type;
+
+    auto result = true;
+    for (const auto& tail : network.nodes()) {
+        network.for_each_outgoing_arc(tail, [&](const auto& arc, const auto& head) {
+            if ((network.arc_residual_capacity(arc) > Flow{0}) &&
+                (network.arc_reduced_cost(arc, tail, head) < Cost{0})) {
+                result = false;
+            }
+        });
+    }
+    return result;
+}
+
+// Solve copies of a network using each successive shortest paths-type solver and check
+// that each solution has the expected total cost. The initial node excesses need not
+// be unit residues.
+template<class Network>
+void
+check_solvers(const Network& network, typename Network::cost_type expected_cost)
+{
+    using Cost = typename Network::cost_type;
+    using Dijkstra = ww::Dijkstra<Cost, typename Network::residual_graph_type>;
+
+    const auto check_solution = [&](const Network& solved) {
+        CATCH_CHECK(ww::testing::is_solved(solved));
+        CATCH_CHECK(satisfies_reduced_cost_optimality(solved));
+        CATCH_CHECK(solved.total_cost() == expected_cost);
+    };
+
+    {
+        CATCH_INFO("successive_shortest_paths");
+        auto solved = network;
+        ww::successive_shortest_paths<Dijkstra>(solved);
+        check_solution(solved);
+    }
+    {
+        CATCH_INFO("batched_successive_shortest_paths");
+        auto solved = network;
+        ww::batched_successive_shortest_paths<Dijkstra>(solved);
+        check_solution(solved);
+    }
+    {
+        CATCH_INFO("bidirectional_successive_shortest_paths");
+        auto solved = network;
+        ww::bidirectional_successive_shortest_paths<Dijkstra>(solved);
+        check_solution(solved);
+    }
+    {
+        CATCH_INFO("astar_successive_shortest_paths");
+        auto solved = network;
+        ww::astar_successive_shortest_paths<Dijkstra>(
+                solved, ww::GridDistanceHeuristic<Network>(solved));
+        check_solution(solved);
+    }
+    {
+        CATCH_INFO("primal_dual");
+        auto solved = network;
+        ww::primal_dual<Dijkstra>(solved);
+        check_solution(solved);
+    }
+    {
+        CATCH_INFO("parallel_primal_dual");
+        auto solved = network;
+        ww::parallel_primal_dual<Dijkstra>(solved, 2U);
+        check_solution(solved);
+    }
+}
+
+// Solve a network, then import its node potentials & arc flows into a network with a
+// few perturbed node surpluses (and, optionally, arc costs). Check that, after
+// repairing the imported state, each solver finds a flow with the same total cost as a
+// cold solve of the perturbed network.
+template<class Network>
+void
+check_warm_start(const typename Network::graph_type& graph,
+                 std::size_t num_perturbations,
+                 std::size_t num_changed_costs,
+                 unsigned int seed)
+{
+    using Cost = typename Network::cost_type;
+    using Flow = typename Network::flow_type;
+    using Dijkstra = ww::Dijkstra<Cost, typename Network::residual_graph_type>;
+
+    const auto num_nodes = graph.num_vertices();
+    const auto num_edges = graph.num_edges();
+    auto rng = std::mt19937(seed);
+    const auto surplus = ww::testing::make_random_surplus<Flow>(num_nodes, 30U, rng);
+    const auto cost = ww::testing::make_random_costs<Cost>(num_edges, Cost{50}, rng);
+
+    auto network = Network(graph, surplus, cost);
+    ww::successive_shortest_paths<Dijkstra>(network);
+    CATCH_REQUIRE(ww::testing::is_solved(network));
+    const auto potentials = network.node_potentials();
+    const auto flows = network.forward_arc_flows();
+
+    // Move a unit of surplus between random pairs of nodes and change some arc costs.
+    auto new_surplus = surplus;
+    auto new_cost = cost;
+    auto node_dist = std::uniform_int_distribution<std::size_t>(0, num_nodes - 1);
+    for (std::size_t i = 0; i < num_perturbations; ++i) {
+        new_surplus[node_dist(rng)] += Flow{1};
+        new_surplus[node_dist(rng)] -= Flow{1};
+    }
+    auto edge_dist = std::uniform_int_distribution<std::size_t>(0, num_edges - 1);
+    auto cost_dist = std::uniform_int_distribution<Cost>(Cost{0}, Cost{50});
+    for (std::size_t i = 0; i < num_changed_costs; ++i) {
+        new_cost[edge_dist(rng)] = cost_dist(rng);
+    }
+
+    auto cold = Network(graph, new_surplus, new_cost);
+    ww::successive_shortest_paths<Dijkstra>(cold);
+    CATCH_REQUIRE(ww::testing::is_solved(cold));
+
+    auto warm = Network(graph, new_surplus, new_cost);
+    warm.set_node_potentials(potentials);
+    warm.set_forward_arc_flows(flows);
+    CATCH_CHECK(warm.node_potentials() == potentials);
+    CATCH_CHECK(warm.forward_arc_flows() == flows);
+
+    ww::restore_reduced_cost_optimality(warm);
+    CATCH_CHECK(warm.is_balanced());
+    CATCH_CHECK(satisfies_reduced_cost_optimality(warm));
+
+    // An unperturbed network is already optimal, so the repair should leave it as is.
+    if ((num_perturbations == 0) && (num_changed_costs == 0)) {
+        CATCH_CHECK(ww::testing::is_solved(warm));
+        CATCH_CHECK(warm.node_potentials() == potentials);
+        CATCH_CHECK(warm.forward_arc_flows() == flows);
+    }
+
+    check_solvers(warm, cold.total_cost());
+}
+
+template<class Network>
+void
+check_warm_start(const typename Network::graph_type& graph)
+{
+    for (const auto seed : {1U, 2U, 3U}) {
+        CATCH_CAPTURE(seed);
+        check_warm_start<Network>(graph, 0U, 0U, seed);
+        check_warm_start<Network>(graph, 5U, 0U, seed);
+        check_warm_start<Network>(graph, 5U, 20U, seed);
+    }
+}
+
+CATCH_TEST_CASE("restore_reduced_cost_optimality", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<1>;
+    using Cost = int;
+    using Flow = int;
+
+    const auto graph = Graph(17U, 19U);
+
+    CATCH_SECTION("UnitCapacityMixin")
+    {
+        using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+        using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+        check_warm_start<Network>(graph);
+    }
+
+    CATCH_SECTION("UncapacitatedMixin")
+    {
+        using Network = ww::Network<Graph, Cost, Flow>;
+        check_warm_start<Network>(graph);
+    }
+}
+
+CATCH_TEST_CASE("successive shortest paths (multiple units of excess)", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<1>;
+    using Cost = int;
+    using Flow = int;
+
+    // After a warm start, a node's excess may exceed one unit. Each solver must route
+    // all of it.
+    const auto graph = Graph(6U, 6U);
+    auto surplus = std::vector<Flow>(graph.num_vertices(), 0);
+    surplus[0] = 2;
+    surplus[20] = -1;
+    surplus[35] = -1;
+    const auto cost = std::vector<Cost>(graph.num_edges(), 1);
+
+    CATCH_SECTION("UnitCapacityMixin")
+    {
+        using Mixin = ww::UnitCapacityMixin<Graph, Flow, ww::Vector>;
+        using Network = ww::Network<Graph, Cost, Flow, ww::Vector, Mixin>;
+        check_solvers(Network(graph, surplus, cost), Cost{15});
+    }
+
+    CATCH_SECTION("UncapacitatedMixin")
+    {
+        using Network = ww::Network<Graph, Cost, Flow>;
+        check_solvers(Network(graph, surplus, cost), Cost{15});
+    }
+}
+
+} // namespace
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <whirlwind/common/namespace.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+namespace testing {
+
+/**
+ * Generate random node surpluses.
+ *
+ * Returns `num_residues` pairs of unit surplus & unit demand nodes at distinct random
+ * locations. All other nodes have zero surplus.
+ */
+template<class Flow>
+[[nodiscard]] auto
+make_random_surplus(std::size_t num_nodes, std::size_t num_residues, std::mt19937& rng)
+        -> std::vector<Flow>
+{
+    auto node_ids = std::vector<std::size_t>(num_nodes);
+    std::iota(node_ids.begin(), node_ids.end(), std::size_t{0});
+    std::shuffle(node_ids.begin(), node_ids.end(), rng);
+
+    auto surplus = std::vector<Flow>(num_nodes, Flow{0});
+    for (std::size_t i = 0; i < num_residues; ++i) {
+        surplus[node_ids[2 * i]] = Flow{1};
+        surplus[node_ids[2 * i + 1]] = Flow{-1};
+    }
+    return surplus;
+}
+
+/** Generate random arc costs uniformly distributed in [0, `max_cost`]. */
+template<class Cost>
+[[nodiscard]] auto
+make_random_costs(std::size_t num_edges, Cost max_cost, std::mt19937& rng)
+        -> std::vector<Cost>
+{
+    auto cost_dist = std::uniform_int_distribution<Cost>(Cost{0}, max_cost);
+    auto cost = std::vector<Cost>(num_edges);
+    std::generate(cost.begin(), cost.end(), [&]() { return cost_dist(rng); });
+    return cost;
+}
+
+/**
+ * Generate a random network on the specified graph, with `num_residues` pairs of unit
+ * surplus & unit demand nodes and arc costs uniformly distributed in [0, `max_cost`].
+ */
+template<class Network>
+[[nodiscard]] auto
+make_random_network(const typename Network::graph_type& graph,
+                    std::size_t num_residues,
+                    typename Network::cost_type max_cost,
+                    std::mt19937::result_type seed) -> Network
+{
+    using Cost = typename Network::cost_type;
+    using Flow = typename Network::flow_type;
+
+    auto rng = std::mt19937(seed);
+    const auto num_nodes = graph.num_vertices();
+    const auto surplus = make_random_surplus<Flow>(num_nodes, num_residues, rng);
+    const auto cost = make_random_costs<Cost>(graph.num_edges(), max_cost, rng);
+    return Network(graph, surplus, cost);
+}
+
+/** Check whether each node's excess is zero. */
+template<class Network>
+[[nodiscard]] auto
+is_solved(const Network& network) -> bool
+{
+    return (network.total_excess() == 0) && (network.total_deficit() == 0);
+}
+
+} // namespace testing
+WHIRLWIND_NAMESPACE_END